@@ -0,0 +1,108 @@
+#include "Ds/concurrenthashtable.hpp"
+#include "Ds/hashtablewllist.hpp"
+#include "Ds/readmostlyhashtable.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t kKeys {1 << 16};
+constexpr std::size_t kOpsPerThread {1 << 15};
+
+// Every thread runs kOpsPerThread operations on its own key stream, one in
+// ten is a write. 'op' gets called with (thread, operation index).
+template<class Op>
+void runThreads(std::size_t threads, Op op) {
+    std::vector<std::jthread> workers;
+    for(std::size_t t {0}; t < threads; ++t) {
+        workers.emplace_back([t, &op]() {
+            for(std::size_t i {0}; i < kOpsPerThread; ++i) {
+                op(t, i);
+            }
+        });
+    }
+}
+
+std::uint64_t keyFor(std::size_t thread, std::size_t i) {
+    return (thread * 7919 + i * 104729) % kKeys;
+}
+
+}
+
+// Every thread does the same amount of work, so with perfect scaling the
+// time per run stays flat while the number of threads grows
+TEST_CASE("Throughput of ConcurrentHT and a mutex guarded HT from 1 to 64 threads", "[concurrentht][benchmark]") {
+    ds::ConcurrentHT<std::uint64_t, std::uint64_t> concurrent(kKeys, 64);
+    ds::HT<std::uint64_t, std::uint64_t> guarded(kKeys);
+    std::mutex guarded_mutex;
+    for(std::uint64_t i {0}; i < kKeys / 2; ++i) {
+        concurrent.insert(i, i);
+        guarded.insert(i, i);
+    }
+
+    for(std::size_t threads: {1, 2, 4, 8, 16, 32, 64}) {
+        BENCHMARK("ConcurrentHT " + std::to_string(threads) + " threads") {
+            runThreads(threads, [&](std::size_t t, std::size_t i) {
+                std::uint64_t key {keyFor(t, i)};
+                if(i % 10 == 0) {
+                    concurrent.insert_or_assign(key, i);
+                } else {
+                    concurrent.exists(key);
+                }
+            });
+        };
+
+        BENCHMARK("HT with one mutex " + std::to_string(threads) + " threads") {
+            runThreads(threads, [&](std::size_t t, std::size_t i) {
+                std::uint64_t key {keyFor(t, i)};
+                std::lock_guard lock {guarded_mutex};
+                if(i % 10 == 0) {
+                    guarded.insert_or_assign(key, i);
+                } else {
+                    guarded.exists(key);
+                }
+            });
+        };
+    }
+}
+
+// 99% reads, the workload ReadMostlyHT is made for
+TEST_CASE("Read mostly throughput of ConcurrentHT and ReadMostlyHT from 1 to 64 threads", "[readmostlyht][benchmark]") {
+    ds::ConcurrentHT<std::uint64_t, std::uint64_t> concurrent(kKeys, 64);
+    ds::ReadMostlyHT<std::uint64_t, std::uint64_t> read_mostly(kKeys);
+    for(std::uint64_t i {0}; i < kKeys / 2; ++i) {
+        concurrent.insert(i, i);
+        read_mostly.insert(i, i);
+    }
+
+    for(std::size_t threads: {1, 2, 4, 8, 16, 32, 64}) {
+        BENCHMARK("ConcurrentHT 99% reads " + std::to_string(threads) + " threads") {
+            runThreads(threads, [&](std::size_t t, std::size_t i) {
+                std::uint64_t key {keyFor(t, i)};
+                if(i % 100 == 0) {
+                    concurrent.insert_or_assign(key, i);
+                } else {
+                    concurrent.exists(key);
+                }
+            });
+        };
+
+        BENCHMARK("ReadMostlyHT 99% reads " + std::to_string(threads) + " threads") {
+            runThreads(threads, [&](std::size_t t, std::size_t i) {
+                std::uint64_t key {keyFor(t, i)};
+                if(i % 100 == 0) {
+                    read_mostly.insert_or_assign(key, i);
+                } else {
+                    read_mostly.exists(key);
+                }
+            });
+        };
+    }
+}
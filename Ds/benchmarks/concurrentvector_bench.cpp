@@ -0,0 +1,60 @@
+#include "Ds/concurrentvector.hpp"
+#include "Ds/vectorclass.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t kAppendsPerThread {1 << 16};
+
+struct LogRecord {
+    std::uint64_t thread;
+    std::uint64_t sequence;
+    double value;
+};
+
+// Every thread appends kAppendsPerThread records through 'append'
+template<class Append>
+void runThreads(std::size_t threads, Append append) {
+    std::vector<std::jthread> workers;
+    for(std::size_t t {0}; t < threads; ++t) {
+        workers.emplace_back([t, &append]() {
+            for(std::size_t i {0}; i < kAppendsPerThread; ++i) {
+                append(LogRecord {t, i, 0.5});
+            }
+        });
+    }
+}
+
+}
+
+// Every thread does the same amount of work, so with perfect scaling the
+// time per run stays flat while the number of threads grows
+TEST_CASE("Appending from 1 to 16 threads to ConcurrentVector and a mutex guarded VectorClass", "[ConcurrentVector][benchmark]") {
+    for(std::size_t threads: {1, 2, 4, 8, 16}) {
+        BENCHMARK("ConcurrentVector " + std::to_string(threads) + " threads") {
+            ds::ConcurrentVector<LogRecord> log;
+            runThreads(threads, [&log](const LogRecord& record) {
+                log.push_back(record);
+            });
+            return log.size();
+        };
+
+        BENCHMARK("mutex guarded VectorClass " + std::to_string(threads) + " threads") {
+            ds::VectorClass<LogRecord> log;
+            std::mutex log_mutex;
+            runThreads(threads, [&](const LogRecord& record) {
+                std::lock_guard lock(log_mutex);
+                log.push_back(record);
+            });
+            return log.size();
+        };
+    }
+}
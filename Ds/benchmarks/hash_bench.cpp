@@ -0,0 +1,146 @@
+#include "Ds/hash.hpp"
+#include "Ds/hashtable.hpp"
+#include "Ds/hashtablewllist.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+// The hash both hashtables used before FastHash: sums up the decimal
+// digits of std::hash, so a 64 bit hash collapses into a few hundred values.
+template<class Key>
+struct LegacyDigitSumHash {
+    std::size_t operator()(const Key& key) const {
+        std::size_t sum {0};
+        std::size_t num {std::hash<Key>{}(key)};
+        while(num > 0) {
+            sum += (num % 10) + 48;
+            num /= 10;
+        }
+        return sum;
+    }
+};
+
+namespace {
+
+constexpr std::size_t kKeys {10000};
+constexpr std::size_t kBuckets {1 << 14};
+
+std::vector<int> sequentialKeys() {
+    std::vector<int> keys;
+    for(std::size_t i {0}; i < kKeys; ++i) {
+        keys.push_back(static_cast<int>(i));
+    }
+    return keys;
+}
+
+std::vector<std::string> stringKeys() {
+    std::vector<std::string> keys;
+    for(std::size_t i {0}; i < kKeys; ++i) {
+        keys.push_back("user:" + std::to_string(i * 7919));
+    }
+    return keys;
+}
+
+// Number of keys which land in an already occupied bucket
+template<class Hash, class Keys>
+std::size_t countCollisions(const Keys& keys) {
+    std::vector<bool> used(kBuckets);
+    std::size_t collisions {0};
+    for(const auto& key: keys) {
+        std::size_t bucket {Hash{}(key) % kBuckets};
+        collisions += used[bucket];
+        used[bucket] = true;
+    }
+    return collisions;
+}
+
+template<class Hash, class Keys>
+std::size_t countDistinct(const Keys& keys) {
+    std::unordered_set<std::size_t> hashes;
+    for(const auto& key: keys) {
+        hashes.insert(Hash{}(key));
+    }
+    return hashes.size();
+}
+
+}
+
+TEST_CASE("Collisions of the legacy digit sum hash and FastHash", "[hash][benchmark]") {
+    auto ints = sequentialKeys();
+    auto strings = stringKeys();
+
+    std::size_t legacy_int {countCollisions<LegacyDigitSumHash<int>>(ints)};
+    std::size_t fast_int {countCollisions<ds::FastHash<int>>(ints)};
+    std::size_t legacy_string {countCollisions<LegacyDigitSumHash<std::string>>(strings)};
+    std::size_t fast_string {countCollisions<ds::FastHash<std::string>>(strings)};
+
+    std::cout << kKeys << " keys into " << kBuckets << " buckets\n"
+              << "int     legacy: " << legacy_int << " collisions, " << countDistinct<LegacyDigitSumHash<int>>(ints) << " distinct hashes\n"
+              << "int     fast:   " << fast_int << " collisions, " << countDistinct<ds::FastHash<int>>(ints) << " distinct hashes\n"
+              << "string  legacy: " << legacy_string << " collisions, " << countDistinct<LegacyDigitSumHash<std::string>>(strings) << " distinct hashes\n"
+              << "string  fast:   " << fast_string << " collisions, " << countDistinct<ds::FastHash<std::string>>(strings) << " distinct hashes\n";
+
+    CHECK(fast_int < legacy_int);
+    CHECK(fast_string < legacy_string);
+}
+
+// Every benchmark runs kKeys lookups, divide the mean by kKeys for ns/op
+TEST_CASE("Lookups with the legacy digit sum hash and FastHash", "[hash][benchmark]") {
+    auto ints = sequentialKeys();
+    auto strings = stringKeys();
+
+    ds::HashTable<int, int, LegacyDigitSumHash<int>> legacy_table;
+    ds::HashTable<int, int> fast_table;
+    ds::HashTable<std::string, int, LegacyDigitSumHash<std::string>> legacy_string_table;
+    ds::HashTable<std::string, int> fast_string_table;
+    ds::HT<int, int, LegacyDigitSumHash<int>> legacy_chained(kKeys);
+    ds::HT<int, int> fast_chained(kKeys);
+    for(std::size_t i {0}; i < kKeys; ++i) {
+        legacy_table.insert(ints[i], ints[i]);
+        fast_table.insert(ints[i], ints[i]);
+        legacy_string_table.insert(strings[i], ints[i]);
+        fast_string_table.insert(strings[i], ints[i]);
+        legacy_chained.insert(ints[i], ints[i]);
+        fast_chained.insert(ints[i], ints[i]);
+    }
+
+    auto lookupAll = [](const auto& table, const auto& keys) {
+        std::size_t found {0};
+        for(const auto& key: keys) {
+            found += table.exists(key);
+        }
+        return found;
+    };
+
+    BENCHMARK("HashTable<int, int> legacy hash") {
+        return lookupAll(legacy_table, ints);
+    };
+    BENCHMARK("HashTable<int, int> FastHash") {
+        return lookupAll(fast_table, ints);
+    };
+    BENCHMARK("HashTable<std::string, int> legacy hash") {
+        return lookupAll(legacy_string_table, strings);
+    };
+    BENCHMARK("HashTable<std::string, int> FastHash") {
+        return lookupAll(fast_string_table, strings);
+    };
+    BENCHMARK("HT<int, int> legacy hash") {
+        std::size_t found {0};
+        for(int key: ints) {
+            found += legacy_chained.exists(key).second;
+        }
+        return found;
+    };
+    BENCHMARK("HT<int, int> FastHash") {
+        std::size_t found {0};
+        for(int key: ints) {
+            found += fast_chained.exists(key).second;
+        }
+        return found;
+    };
+}
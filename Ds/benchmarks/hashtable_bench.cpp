@@ -0,0 +1,117 @@
+#include "Ds/hashtable.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <span>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+// Large enough that slots and control bytes do not fit into the caches
+constexpr std::size_t kTableSize {1 << 22};
+constexpr std::size_t kLookups {1 << 16};
+
+}
+
+// Every benchmark runs kLookups random lookups, divide the mean by
+// kLookups for ns/op
+TEST_CASE("Single and batched lookups in a HashTable larger than the cache", "[hashtable][benchmark]") {
+    ds::HashTable<std::uint64_t, std::uint64_t> ht;
+    ht.reserve(kTableSize);
+    for(std::uint64_t i {0}; i < kTableSize; ++i) {
+        ht.insert(i, i);
+    }
+
+    // Half of the keys are missing
+    std::mt19937_64 gen {42};
+    std::uniform_int_distribution<std::uint64_t> dist {0, kTableSize * 2};
+    std::vector<std::uint64_t> keys(kLookups);
+    for(auto& key: keys) {
+        key = dist(gen);
+    }
+    std::vector<std::uint64_t*> results(kLookups);
+    auto found = std::make_unique<bool[]>(kLookups);
+
+    BENCHMARK("find") {
+        std::size_t hits {0};
+        for(std::size_t i {0}; i < kLookups; ++i) {
+            results[i] = ht.find(keys[i]);
+            hits += results[i] != nullptr;
+        }
+        return hits;
+    };
+
+    BENCHMARK("find_batch") {
+        ht.find_batch(keys, results);
+        return results.back();
+    };
+
+    BENCHMARK("exists") {
+        std::size_t hits {0};
+        for(auto key: keys) {
+            hits += ht.exists(key);
+        }
+        return hits;
+    };
+
+    BENCHMARK("contains_batch") {
+        return ht.contains_batch(keys, std::span<bool>(found.get(), kLookups));
+    };
+}
+
+// Full scans of a sparse and a dense table. Divide the size of the slot
+// array by the mean for the achieved bandwidth.
+TEST_CASE("Full table scans with iterators and for_each", "[hashtable][benchmark]") {
+    for(std::size_t elements: {kTableSize / 16, kTableSize / 2}) {
+        ds::HashTable<std::uint64_t, std::uint64_t> ht;
+        ht.reserve(kTableSize / 2);
+        for(std::uint64_t i {0}; i < elements; ++i) {
+            ht.insert(i, i);
+        }
+
+        BENCHMARK("iterators " + std::to_string(elements) + " elements") {
+            std::uint64_t sum {0};
+            for(const auto& pair: ht) {
+                sum += pair.second;
+            }
+            return sum;
+        };
+
+        BENCHMARK("for_each " + std::to_string(elements) + " elements") {
+            std::uint64_t sum {0};
+            ht.for_each([&sum](const auto& pair) { sum += pair.second; });
+            return sum;
+        };
+    }
+}
+
+TEST_CASE("Building a HashTable from a range", "[hashtable][benchmark]") {
+    std::vector<std::pair<std::uint64_t, std::uint64_t>> elements;
+    for(std::uint64_t i {0}; i < kTableSize; ++i) {
+        elements.emplace_back(i, i);
+    }
+
+    BENCHMARK("iterator range constructor") {
+        ds::HashTable<std::uint64_t, std::uint64_t> ht(elements.begin(), elements.end());
+        return ht.size();
+    };
+
+    BENCHMARK("from_range") {
+        return ds::HashTable<std::uint64_t, std::uint64_t>::from_range(elements).size();
+    };
+
+    BENCHMARK("from_range assume_unique") {
+        return ds::HashTable<std::uint64_t, std::uint64_t>::from_range(ds::assume_unique, elements).size();
+    };
+
+    BENCHMARK("from_range assume_unique, all threads") {
+        return ds::HashTable<std::uint64_t, std::uint64_t>::from_range(ds::assume_unique, elements, std::thread::hardware_concurrency()).size();
+    };
+}
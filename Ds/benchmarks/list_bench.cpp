@@ -0,0 +1,130 @@
+#include "Ds/list.hpp"
+#include "Ds/unrolledlist.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <cstddef>
+#include <list>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t kElements {1 << 20};
+
+std::vector<int> randomValues() {
+    std::mt19937 gen {42};
+    std::uniform_int_distribution<int> dist;
+    std::vector<int> values(kElements);
+    for(int& value: values) {
+        value = dist(gen);
+    }
+    return values;
+}
+
+}
+
+// Both sorts relink nodes, the lists get built outside of the measurement
+TEST_CASE("Sorting a list of random ints", "[list][benchmark]") {
+    const std::vector<int> values {randomValues()};
+
+    BENCHMARK_ADVANCED("std::list::sort " + std::to_string(kElements) + " elements")(Catch::Benchmark::Chronometer meter) {
+        std::vector<std::list<int>> lists(meter.runs(), std::list<int>(values.begin(), values.end()));
+        meter.measure([&lists](int run) {
+            lists[run].sort();
+            return lists[run].front();
+        });
+    };
+
+    BENCHMARK_ADVANCED("ds::List::sort " + std::to_string(kElements) + " elements")(Catch::Benchmark::Chronometer meter) {
+        std::vector<ds::List<int>> lists;
+        for(int run {0}; run < meter.runs(); ++run) {
+            lists.emplace_back(values.begin(), values.end());
+        }
+        meter.measure([&lists](int run) {
+            lists[run].sort();
+            return lists[run].front();
+        });
+    };
+}
+
+// Building, walking and tearing down a list, the pooled nodes come from a few
+// slabs and get released together
+TEST_CASE("Building, iterating and destroying a list of ints", "[list][benchmark]") {
+    const std::vector<int> values {randomValues()};
+
+    BENCHMARK("ds::List") {
+        ds::List<int> list;
+        for(int value: values) {
+            list.push_back(value);
+        }
+        long long sum {0};
+        for(int value: list) {
+            sum += value;
+        }
+        return sum;
+    };
+
+    BENCHMARK("ds::PooledList") {
+        ds::PooledList<int> list;
+        for(int value: values) {
+            list.push_back(value);
+        }
+        long long sum {0};
+        for(int value: list) {
+            sum += value;
+        }
+        return sum;
+    };
+}
+
+// After sorting, the nodes of ds::List are linked in random memory order,
+// the unrolled list moves elements instead and keeps its arrays
+TEST_CASE("Walking a sorted list of random ints", "[list][UnrolledList][benchmark]") {
+    const std::vector<int> values {randomValues()};
+    ds::List<int> list(values.begin(), values.end());
+    ds::UnrolledList<int> unrolled(values.begin(), values.end());
+    list.sort();
+    unrolled.sort();
+
+    BENCHMARK("ds::List") {
+        long long sum {0};
+        for(int value: list) {
+            sum += value;
+        }
+        return sum;
+    };
+
+    BENCHMARK("ds::UnrolledList") {
+        long long sum {0};
+        for(int value: unrolled) {
+            sum += value;
+        }
+        return sum;
+    };
+}
+
+// Reading every element by position, the way index loops over a list do
+TEST_CASE("Indexing every element of a list of ints", "[list][benchmark]") {
+    constexpr std::size_t kIndexed {1 << 14};
+    const std::vector<int> values {randomValues()};
+    ds::List<int> list(values.begin(), values.begin() + kIndexed);
+    ds::IndexedList<int> indexed(values.begin(), values.begin() + kIndexed);
+
+    BENCHMARK("ds::List") {
+        long long sum {0};
+        for(std::size_t i {0}; i < list.size(); ++i) {
+            sum += list[i];
+        }
+        return sum;
+    };
+
+    BENCHMARK("ds::IndexedList") {
+        long long sum {0};
+        for(std::size_t i {0}; i < indexed.size(); ++i) {
+            sum += indexed[i];
+        }
+        return sum;
+    };
+}
@@ -0,0 +1,49 @@
+#include "Ds/hashtable.hpp"
+#include "Ds/hashtablewllist.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+
+namespace {
+
+constexpr std::uint64_t kKeys {1 << 22};
+
+// Slowest single insert while filling 'table' from empty
+template<class Table>
+std::chrono::nanoseconds worstInsert(Table& table) {
+    using clock = std::chrono::steady_clock;
+    std::chrono::nanoseconds worst {0};
+    for(std::uint64_t i {0}; i < kKeys; ++i) {
+        auto start = clock::now();
+        table.insert(i, i);
+        auto elapsed = clock::now() - start;
+        if(elapsed > worst) {
+            worst = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed);
+        }
+    }
+    return worst;
+}
+
+}
+
+// HashTable rehashes everything in the insert which crosses the load
+// factor, HT spreads the migration over the following inserts
+TEST_CASE("Worst case insert latency of a full and an incremental rehash", "[ht][benchmark]") {
+    ds::HashTable<std::uint64_t, std::uint64_t> full;
+    ds::HT<std::uint64_t, std::uint64_t> incremental;
+
+    std::cout << "HashTable worst insert: " << worstInsert(full).count() << " ns\n"
+              << "HT worst insert:        " << worstInsert(incremental).count() << " ns\n";
+
+    BENCHMARK("HT fill " + std::to_string(kKeys) + " keys from empty") {
+        ds::HT<std::uint64_t, std::uint64_t> table;
+        for(std::uint64_t i {0}; i < kKeys; ++i) {
+            table.insert(i, i);
+        }
+        return table.size();
+    };
+}
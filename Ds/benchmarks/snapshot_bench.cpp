@@ -0,0 +1,45 @@
+#include "Ds/hashtable.hpp"
+#include "Ds/mappedhashtable.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+
+namespace {
+
+constexpr std::uint64_t kKeys {1 << 22};
+
+}
+
+// Startup cost of getting a usable table: rebuilding it insert by insert
+// against mapping a snapshot and faulting in what a few lookups touch
+TEST_CASE("Rebuilding a table against opening its snapshot", "[hashtable][benchmark]") {
+    ds::HashTable<std::uint64_t, std::uint64_t> source;
+    for(std::uint64_t i {0}; i < kKeys; ++i) {
+        source.insert(i, i * 2);
+    }
+    std::string path {(std::filesystem::temp_directory_path() / "ds_snapshot_bench.snap").string()};
+    source.save(path);
+
+    BENCHMARK("HashTable rebuild " + std::to_string(kKeys) + " keys") {
+        ds::HashTable<std::uint64_t, std::uint64_t> table;
+        for(std::uint64_t i {0}; i < kKeys; ++i) {
+            table.insert(i, i * 2);
+        }
+        return table.size();
+    };
+
+    BENCHMARK("MappedHashTable open and 1000 lookups") {
+        auto table = ds::open_mapped<std::uint64_t, std::uint64_t>(path);
+        std::uint64_t sum {0};
+        for(std::uint64_t i {0}; i < kKeys; i += kKeys / 1000) {
+            sum += *table.find(i);
+        }
+        return sum;
+    };
+
+    std::remove(path.c_str());
+}
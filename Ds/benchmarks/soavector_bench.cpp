@@ -0,0 +1,49 @@
+#include "Ds/soavector.hpp"
+#include "Ds/vectorclass.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <cstddef>
+#include <cstdint>
+
+namespace {
+
+constexpr std::size_t kRows {1 << 22};
+
+struct Trade {
+    std::uint64_t id;
+    std::uint64_t timestamp;
+    double price;
+    double quantity;
+};
+
+}
+
+// Summing one field reads the whole 32 byte row from the array of structs,
+// but only the 8 byte column from the SoAVector
+TEST_CASE("Scanning one field of a table", "[SoAVector][benchmark]") {
+    ds::VectorClass<Trade> rows;
+    ds::SoAVector<std::uint64_t, std::uint64_t, double, double> columns;
+    rows.reserve(kRows);
+    columns.reserve(kRows);
+    for(std::uint64_t i {0}; i < kRows; ++i) {
+        rows.push_back(Trade {i, i * 10, i * 0.25, 1.0});
+        columns.emplace_back(i, i * 10, i * 0.25, 1.0);
+    }
+
+    BENCHMARK("VectorClass of structs") {
+        double sum {0.0};
+        for(const Trade& trade: rows) {
+            sum += trade.price;
+        }
+        return sum;
+    };
+
+    BENCHMARK("SoAVector column") {
+        double sum {0.0};
+        for(double price: columns.column<2>()) {
+            sum += price;
+        }
+        return sum;
+    };
+}
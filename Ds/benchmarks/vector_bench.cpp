@@ -0,0 +1,137 @@
+#include "Ds/smallvector.hpp"
+#include "Ds/stablevector.hpp"
+#include "Ds/vectorclass.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr std::size_t kElements {1 << 24};
+
+struct Record {
+    std::uint64_t id;
+    double values[3];
+};
+
+}
+
+// Trivially relocatable records get grown with realloc, std::vector moves
+// every element into each new buffer and StableVector never moves one
+TEST_CASE("Growing a vector of records by push_back", "[VectorClass][benchmark]") {
+    BENCHMARK("std::vector " + std::to_string(kElements) + " records") {
+        std::vector<Record> v;
+        for(std::uint64_t i {0}; i < kElements; ++i) {
+            v.push_back(Record {i, {}});
+        }
+        return v.size();
+    };
+
+    BENCHMARK("VectorClass " + std::to_string(kElements) + " records") {
+        ds::VectorClass<Record> v;
+        for(std::uint64_t i {0}; i < kElements; ++i) {
+            v.push_back(Record {i, {}});
+        }
+        return v.size();
+    };
+
+    BENCHMARK("VectorClass with PageGrowth " + std::to_string(kElements) + " records") {
+        ds::VectorClass<Record, std::allocator<Record>, ds::PageGrowth<>> v;
+        for(std::uint64_t i {0}; i < kElements; ++i) {
+            v.push_back(Record {i, {}});
+        }
+        return v.size();
+    };
+
+    BENCHMARK("StableVector " + std::to_string(kElements) + " records") {
+        ds::StableVector<Record> v;
+        for(std::uint64_t i {0}; i < kElements; ++i) {
+            v.push_back(Record {i, {}});
+        }
+        return v.size();
+    };
+}
+
+// Every insert lands in the middle, with capacity reserved up front
+TEST_CASE("Inserting into the middle of a vector", "[VectorClass][benchmark]") {
+    constexpr int inserts {20000};
+
+    BENCHMARK("std::vector " + std::to_string(inserts) + " inserts") {
+        std::vector<int> v;
+        v.reserve(inserts);
+        for(int i {0}; i < inserts; ++i) {
+            v.insert(v.begin() + v.size() / 2, i);
+        }
+        return v.size();
+    };
+
+    BENCHMARK("VectorClass " + std::to_string(inserts) + " inserts") {
+        ds::VectorClass<int> v;
+        v.reserve(inserts);
+        for(int i {0}; i < inserts; ++i) {
+            v.insert(v.cbegin() + v.size() / 2, i);
+        }
+        return v.size();
+    };
+}
+
+// Short lived per request collections: build, sum and drop a vector of
+// 'elements' ints, a thousand times per benchmark
+TEST_CASE("Small vectors against VectorClass", "[SmallVector][benchmark]") {
+    constexpr int rounds {1000};
+
+    for(int elements: {0, 1, 4, 8, 16, 32, 64}) {
+        BENCHMARK("VectorClass " + std::to_string(elements) + " elements") {
+            long long sum {0};
+            for(int round {0}; round < rounds; ++round) {
+                ds::VectorClass<int> v;
+                for(int i {0}; i < elements; ++i) {
+                    v.push_back(i);
+                }
+                for(int x: v) {
+                    sum += x;
+                }
+            }
+            return sum;
+        };
+
+        BENCHMARK("SmallVector<int, 16> " + std::to_string(elements) + " elements") {
+            long long sum {0};
+            for(int round {0}; round < rounds; ++round) {
+                ds::SmallVector<int, 16> v;
+                for(int i {0}; i < elements; ++i) {
+                    v.push_back(i);
+                }
+                for(int x: v) {
+                    sum += x;
+                }
+            }
+            return sum;
+        };
+    }
+}
+
+// Preparing a reused buffer to read 256 MB into. clear() keeps the
+// allocation, so only the initialization of the elements gets measured.
+TEST_CASE("Resizing an I/O buffer", "[VectorClass][benchmark]") {
+    constexpr std::size_t bytes {std::size_t {1} << 28};
+    ds::VectorClass<char> buffer;
+    buffer.resize(bytes);
+
+    BENCHMARK("resize with value initialization") {
+        buffer.clear();
+        buffer.resize(bytes);
+        return buffer.size();
+    };
+
+    BENCHMARK("resize with ds::default_init") {
+        buffer.clear();
+        buffer.resize(bytes, ds::default_init);
+        return buffer.size();
+    };
+}
@@ -3,6 +3,9 @@
 
 #include <iterator>
 #include <type_traits>
+#include <concepts>
+#include <cstddef>
+#include <functional>
 
 namespace ds {
 
@@ -16,6 +19,31 @@ concept Hashable = std::is_copy_constructible_v<T> && requires(T a)
     
 };
 
+// 'H' can be used as hash function for keys of type 'Key'
+template<class H, class Key>
+concept HashFunction = std::is_copy_constructible_v<Key> && std::is_copy_constructible_v<H> && requires(const H& h, const Key& key)
+{
+    { h(key) } -> std::convertible_to<std::size_t>;
+};
+
+// 'Hash' and 'KeyEqual' both declare 'is_transparent', so a lookup can
+// use a 'K' directly instead of converting it into a key first
+template<class Hash, class KeyEqual, class K>
+concept TransparentLookup = requires(const Hash& h, const KeyEqual& equal, const K& key)
+{
+    typename Hash::is_transparent;
+    typename KeyEqual::is_transparent;
+    { h(key) } -> std::convertible_to<std::size_t>;
+};
+
+// 'G::grow(capacity, required, element_size)' returns the capacity a
+// container grows to once 'required' elements do not fit anymore
+template<class G>
+concept GrowthPolicy = requires(std::size_t n)
+{
+    { G::grow(n, n, n) } -> std::convertible_to<std::size_t>;
+};
+
 template<class T>
 concept MappedConcept = std::is_default_constructible_v<T> && std::is_copy_constructible_v<T>;
 
@@ -0,0 +1,207 @@
+#ifndef CONCURRENT_HASH_TABLE_HPP
+#define CONCURRENT_HASH_TABLE_HPP
+
+#include "concepts.hpp"
+#include "hash.hpp"
+#include "hashtablewllist.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <shared_mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace ds {
+
+// Thread safe hashtable made of independent HT shards. Every shard has its
+// own reader/writer lock, so threads only contend if they hit the same
+// shard, and lookups on a shard run in parallel. The shard gets picked
+// with the lowest bits of the hash, the HT inside uses the highest ones.
+// Element access returns copies, references would outlive the lock.
+template<class Key, MappedConcept T, HashFunction<Key> Hash = FastHash<Key>, class KeyEqual = std::equal_to<Key>>
+class ConcurrentHT {
+public:
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = std::pair<Key, T>;
+    using size_type = std::size_t;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+    using shard_type = HT<Key, T, Hash, KeyEqual>;
+
+public:
+    // The initial 'capacity' gets split over 'shard_count' shards, which
+    // gets rounded up to a power of two
+    explicit ConcurrentHT(size_type capacity = 1 << 16, size_type shard_count = 64, const Hash& hash = Hash(), const KeyEqual& equal = KeyEqual());
+    ConcurrentHT(const ConcurrentHT& other) = delete;
+    ConcurrentHT& operator=(const ConcurrentHT& other) = delete;
+
+    // Size functions. Each shard gets locked on its own, so with concurrent
+    // writers the result is only a snapshot.
+    size_type size() const;
+    bool empty() const;
+    size_type shard_count() const noexcept;
+    bool exists(const key_type& key) const;
+
+    // Modifiers
+    bool insert(const key_type& key, const mapped_type& value);
+    template<class Type>
+    bool insert_or_assign(const key_type& key, Type&& obj);
+    template<class... Args>
+    bool emplace(Args&&... args);
+
+    // Element access
+    mapped_type at(const key_type& key) const;
+    template<class F>
+    bool visit(const key_type& key, F&& f);
+
+    // Calls 'f' with every shard (as const shard_type&) under its read
+    // lock. The shards get spread over up to 'threads' threads, so 'f' has
+    // to be safe to call concurrently.
+    template<class F>
+    void for_each_shard(F&& f, size_type threads = std::thread::hardware_concurrency()) const;
+
+private:
+    // Every shard on its own cache lines, so locking one does not bounce
+    // the lock word of its neighbour
+    struct alignas(64) Shard {
+        mutable std::shared_mutex mutex_;
+        shard_type table_;
+    };
+
+    size_type shard_mask_;
+    std::unique_ptr<Shard[]> shards_;
+    [[no_unique_address]] hasher hash_;
+
+private:
+    Shard& shardFor(const key_type& key);
+    const Shard& shardFor(const key_type& key) const;
+};
+
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
+ConcurrentHT<Key, T, Hash, KeyEqual>::ConcurrentHT(size_type capacity, size_type shard_count, const Hash& hash, const KeyEqual& equal)
+    : shard_mask_ {std::bit_ceil(std::max<size_type>(shard_count, 1)) - 1}
+    , shards_ {std::make_unique<Shard[]>(shard_mask_ + 1)}
+    , hash_ {hash}
+{
+    // Shards grow on their own, so an even share is only the starting point
+    size_type shard_capacity {std::max<size_type>((capacity + shard_mask_) / (shard_mask_ + 1), 1)};
+    for(size_type i {0}; i <= shard_mask_; ++i) {
+        shards_[i].table_ = shard_type(shard_capacity, hash, equal);
+    }
+}
+
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
+ConcurrentHT<Key, T, Hash, KeyEqual>::size_type ConcurrentHT<Key, T, Hash, KeyEqual>::size() const {
+    size_type size {0};
+    for(size_type i {0}; i <= shard_mask_; ++i) {
+        std::shared_lock lock {shards_[i].mutex_};
+        size += shards_[i].table_.size();
+    }
+    return size;
+}
+
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
+bool ConcurrentHT<Key, T, Hash, KeyEqual>::empty() const {
+    return size() == 0;
+}
+
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
+ConcurrentHT<Key, T, Hash, KeyEqual>::size_type ConcurrentHT<Key, T, Hash, KeyEqual>::shard_count() const noexcept {
+    return shard_mask_ + 1;
+}
+
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
+bool ConcurrentHT<Key, T, Hash, KeyEqual>::exists(const key_type& key) const {
+    const Shard& shard {shardFor(key)};
+    std::shared_lock lock {shard.mutex_};
+    return shard.table_.exists(key).second;
+}
+
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
+bool ConcurrentHT<Key, T, Hash, KeyEqual>::insert(const key_type& key, const mapped_type& value) {
+    Shard& shard {shardFor(key)};
+    std::unique_lock lock {shard.mutex_};
+    return shard.table_.insert(key, value);
+}
+
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
+template<class Type>
+bool ConcurrentHT<Key, T, Hash, KeyEqual>::insert_or_assign(const key_type& key, Type&& obj) {
+    Shard& shard {shardFor(key)};
+    std::unique_lock lock {shard.mutex_};
+    return shard.table_.insert_or_assign(key, std::forward<Type>(obj));
+}
+
+// The pair gets constructed before locking, the shard depends on its key
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
+template<class... Args>
+bool ConcurrentHT<Key, T, Hash, KeyEqual>::emplace(Args&&... args) {
+    value_type pair(std::forward<Args>(args)...);
+    Shard& shard {shardFor(pair.first)};
+    std::unique_lock lock {shard.mutex_};
+    return shard.table_.emplace(std::move(pair));
+}
+
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
+ConcurrentHT<Key, T, Hash, KeyEqual>::mapped_type ConcurrentHT<Key, T, Hash, KeyEqual>::at(const key_type& key) const {
+    const Shard& shard {shardFor(key)};
+    std::shared_lock lock {shard.mutex_};
+    return shard.table_.at(key);
+}
+
+// Calls 'f' with a reference to the value of 'key' while holding the write
+// lock of its shard. Returns false if 'key' does not exist.
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
+template<class F>
+bool ConcurrentHT<Key, T, Hash, KeyEqual>::visit(const key_type& key, F&& f) {
+    Shard& shard {shardFor(key)};
+    std::unique_lock lock {shard.mutex_};
+    auto pair = shard.table_.exists(key);
+    if(!pair.second) {
+        return false;
+    }
+    f(*(pair.first));
+    return true;
+}
+
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
+template<class F>
+void ConcurrentHT<Key, T, Hash, KeyEqual>::for_each_shard(F&& f, size_type threads) const {
+    threads = std::clamp<size_type>(threads, 1, shard_count());
+    std::atomic<size_type> next_shard {0};
+    auto worker = [&]() {
+        for(size_type i {next_shard++}; i < shard_count(); i = next_shard++) {
+            std::shared_lock lock {shards_[i].mutex_};
+            f(static_cast<const shard_type&>(shards_[i].table_));
+        }
+    };
+
+    std::vector<std::jthread> workers;
+    for(size_type i {1}; i < threads; ++i) {
+        workers.emplace_back(worker);
+    }
+    worker();
+}
+
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
+ConcurrentHT<Key, T, Hash, KeyEqual>::Shard& ConcurrentHT<Key, T, Hash, KeyEqual>::shardFor(const key_type& key) {
+    return shards_[hash_(key) & shard_mask_];
+}
+
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
+const ConcurrentHT<Key, T, Hash, KeyEqual>::Shard& ConcurrentHT<Key, T, Hash, KeyEqual>::shardFor(const key_type& key) const {
+    return shards_[hash_(key) & shard_mask_];
+}
+
+}
+
+#endif //CONCURRENT_HASH_TABLE_HPP
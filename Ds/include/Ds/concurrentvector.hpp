@@ -0,0 +1,380 @@
+#ifndef CONCURRENTVECTOR_HPP
+#define CONCURRENTVECTOR_HPP
+
+#include <array>
+#include <atomic>
+#include <compare>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "stablevector.hpp"
+
+namespace ds {
+
+// Append only vector for several threads. Every push_back reserves an index
+// with one compare and swap on a counter, constructs the element in its
+// slot and marks the slot as ready. size() is a watermark: every element
+// below it is fully constructed and can be read from any thread while
+// others keep appending. Whichever thread finishes moves the watermark over
+// all ready slots behind it, so no thread ever waits for a slower one.
+// The blocks double in size like in StableVector and never move, the
+// thread which needs a block first allocates it.
+// The allocator has to be usable from several threads at once.
+template<class T, class Allocator = std::allocator<T>, std::size_t BlockSize = 64>
+class ConcurrentVector {
+    static_assert(std::is_same_v<typename std::allocator_traits<Allocator>::pointer, T*>, "Blocks are stored as atomic raw pointers");
+    static_assert(std::is_nothrow_move_constructible_v<T>, "A reserved slot has to be filled without throwing");
+
+private:
+    template<bool IsConst>
+    class Iterator;
+
+// Type aliases
+public:
+    using value_type = T;
+    using allocator = Allocator;
+    using traits_t = std::allocator_traits<allocator>;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using pointer = traits_t::pointer;
+    using const_pointer = traits_t::const_pointer;
+    using size_type = traits_t::size_type;
+    using difference_type = std::ptrdiff_t;
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+private:
+    using blocks_t = detail::GeometricBlocks<BlockSize>;
+    using flag_allocator = traits_t::template rebind_alloc<std::atomic<bool>>;
+    using flag_traits_t = std::allocator_traits<flag_allocator>;
+
+    std::array<std::atomic<pointer>, blocks_t::kMaxBlocks> blocks_ {};
+    // One ready flag per slot, allocated before the block of the elements
+    std::array<std::atomic<std::atomic<bool>*>, blocks_t::kMaxBlocks> ready_ {};
+    // Next free index, only taken once its block exists
+    alignas(64) std::atomic<size_type> reserved_ {0};
+    // Every element below it is constructed
+    alignas(64) std::atomic<size_type> published_ {0};
+    [[no_unique_address]] allocator alloc_ {};
+
+public:
+    // Constructors and Desctructor
+    ConcurrentVector() = default;
+    explicit ConcurrentVector(const Allocator& alloc) noexcept;
+    // Other threads keep pointers to the elements and to the vector itself
+    ConcurrentVector(const ConcurrentVector& other) = delete;
+    ConcurrentVector& operator=(const ConcurrentVector& other) = delete;
+    ~ConcurrentVector();
+
+    // Length and capacity, safe while other threads append
+    bool empty() const noexcept;
+    // The published size, no element below it is still being constructed
+    size_type size() const noexcept;
+    size_type capacity() const noexcept;
+    void reserve(size_type new_cap);
+
+    // Appending, safe from any number of threads. Returns the index of the
+    // new element. The calling thread can use it right away, other threads
+    // once size() passed it.
+    size_type push_back(const T& value);
+    size_type push_back(T&& value);
+    template<class... Args>
+    size_type emplace_back(Args&&... args);
+
+    // Not safe while other threads append or read. Keeps the blocks.
+    void clear() noexcept;
+
+    // Element access, safe for indices below size()
+    reference operator[] (const size_type index);
+    const_reference operator[] (const size_type index) const;
+    reference at(const size_type index);
+    const_reference at(const size_type index) const;
+
+    // Iterators over the elements published when end() gets called
+    iterator begin() noexcept;
+    const_iterator begin() const noexcept;
+    const_iterator cbegin() const noexcept;
+    iterator end() noexcept;
+    const_iterator end() const noexcept;
+    const_iterator cend() const noexcept;
+
+    // Get allocator
+    constexpr allocator get_allocator() const noexcept;
+
+private:
+    pointer slot(size_type index) const noexcept;
+    std::atomic<bool>& readyFlag(size_type index) const noexcept;
+    // Makes sure the block exists, several threads can race to allocate it
+    void ensureBlock(size_type block);
+    // Takes the next index once its block exists, so a failed allocation
+    // leaves the vector as it was
+    size_type reserveIndex();
+    // Marks the slot as ready and moves the watermark as far as it can
+    void publish(size_type index) noexcept;
+};
+
+template<class T, class Allocator, std::size_t BlockSize>
+template<bool IsConst>
+class ConcurrentVector<T, Allocator, BlockSize>::Iterator {
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using difference_type   = std::ptrdiff_t;
+    using value_type        = ConcurrentVector::value_type;
+    using pointer           = std::conditional_t<IsConst, const value_type*, value_type*>;
+    using reference         = std::conditional_t<IsConst, const value_type&, value_type&>;
+
+    Iterator() = default;
+    // iterator converts to const_iterator
+    template<bool OtherConst>
+    requires (IsConst && !OtherConst)
+    Iterator(const Iterator<OtherConst>& other): owner_ {other.owner_}, index_ {other.index_} {}
+
+    reference operator*() const { return *owner_->slot(index_); }
+    pointer operator->() const { return owner_->slot(index_); }
+    reference operator[](difference_type n) const { return *owner_->slot(index_ + n); }
+
+    Iterator& operator++() { ++index_; return *this; }
+    Iterator operator++(int) { Iterator tmp = *this; ++index_; return tmp; }
+    Iterator& operator--() { --index_; return *this; }
+    Iterator operator--(int) { Iterator tmp = *this; --index_; return tmp; }
+    Iterator& operator+=(difference_type n) { index_ += n; return *this; }
+    Iterator& operator-=(difference_type n) { index_ -= n; return *this; }
+
+    friend Iterator operator+(Iterator it, difference_type n) { return it += n; }
+    friend Iterator operator+(difference_type n, Iterator it) { return it += n; }
+    friend Iterator operator-(Iterator it, difference_type n) { return it -= n; }
+    friend difference_type operator-(const Iterator& a, const Iterator& b) {
+        return static_cast<difference_type>(a.index_) - static_cast<difference_type>(b.index_);
+    }
+    friend bool operator==(const Iterator& a, const Iterator& b) { return a.index_ == b.index_; }
+    friend auto operator<=>(const Iterator& a, const Iterator& b) { return a.index_ <=> b.index_; }
+
+private:
+    using owner_type = std::conditional_t<IsConst, const ConcurrentVector, ConcurrentVector>;
+
+    Iterator(owner_type* owner, size_type index): owner_ {owner}, index_ {index} {}
+
+    owner_type* owner_ {nullptr};
+    size_type index_ {0};
+
+    template<bool>
+    friend class Iterator;
+    friend class ConcurrentVector;
+};
+
+template<class T, class Allocator, std::size_t BlockSize>
+ConcurrentVector<T, Allocator, BlockSize>::ConcurrentVector(const Allocator& alloc) noexcept: alloc_ {alloc} {}
+
+template<class T, class Allocator, std::size_t BlockSize>
+ConcurrentVector<T, Allocator, BlockSize>::~ConcurrentVector() {
+    clear();
+    flag_allocator flag_alloc(alloc_);
+    for(size_type block {0}; block < blocks_t::kMaxBlocks; ++block) {
+        pointer p {blocks_[block].load(std::memory_order_relaxed)};
+        if(p) {
+            traits_t::deallocate(alloc_, p, blocks_t::blockCapacity(block));
+        }
+        std::atomic<bool>* flags {ready_[block].load(std::memory_order_relaxed)};
+        if(flags) {
+            flag_traits_t::deallocate(flag_alloc, flags, blocks_t::blockCapacity(block));
+        }
+    }
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+bool ConcurrentVector<T, Allocator, BlockSize>::empty() const noexcept {
+    return size() == 0;
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+ConcurrentVector<T, Allocator, BlockSize>::size_type ConcurrentVector<T, Allocator, BlockSize>::size() const noexcept {
+    return published_.load(std::memory_order_acquire);
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+ConcurrentVector<T, Allocator, BlockSize>::size_type ConcurrentVector<T, Allocator, BlockSize>::capacity() const noexcept {
+    // Blocks get allocated in order, a racing thread may still fill a gap
+    size_type block {0};
+    while(block < blocks_t::kMaxBlocks && blocks_[block].load(std::memory_order_acquire)) {
+        ++block;
+    }
+    return blocks_t::blockStart(block);
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+void ConcurrentVector<T, Allocator, BlockSize>::reserve(size_type new_cap) {
+    if(new_cap == 0) {
+        return;
+    }
+    for(size_type block {0}; block <= blocks_t::blockOf(new_cap - 1); ++block) {
+        ensureBlock(block);
+    }
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+ConcurrentVector<T, Allocator, BlockSize>::size_type ConcurrentVector<T, Allocator, BlockSize>::push_back(const T& value) {
+    return emplace_back(value);
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+ConcurrentVector<T, Allocator, BlockSize>::size_type ConcurrentVector<T, Allocator, BlockSize>::push_back(T&& value) {
+    return emplace_back(std::move(value));
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+template<class... Args>
+ConcurrentVector<T, Allocator, BlockSize>::size_type ConcurrentVector<T, Allocator, BlockSize>::emplace_back(Args&&... args) {
+    // A taken index has to become ready or the watermark never passes it,
+    // so anything that can throw happens before
+    if constexpr(std::is_nothrow_constructible_v<T, Args&&...>) {
+        size_type index {reserveIndex()};
+        traits_t::construct(alloc_, slot(index), std::forward<Args>(args)...);
+        publish(index);
+        return index;
+    } else {
+        T value(std::forward<Args>(args)...);
+        size_type index {reserveIndex()};
+        traits_t::construct(alloc_, slot(index), std::move(value));
+        publish(index);
+        return index;
+    }
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+void ConcurrentVector<T, Allocator, BlockSize>::clear() noexcept {
+    size_type size {published_.load(std::memory_order_relaxed)};
+    for(size_type index {0}; index < size; ++index) {
+        traits_t::destroy(alloc_, slot(index));
+        readyFlag(index).store(false, std::memory_order_relaxed);
+    }
+    published_.store(0, std::memory_order_relaxed);
+    reserved_.store(0, std::memory_order_relaxed);
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+ConcurrentVector<T, Allocator, BlockSize>::reference ConcurrentVector<T, Allocator, BlockSize>::operator[] (const size_type index) {
+    return *slot(index);
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+ConcurrentVector<T, Allocator, BlockSize>::const_reference ConcurrentVector<T, Allocator, BlockSize>::operator[] (const size_type index) const {
+    return *slot(index);
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+ConcurrentVector<T, Allocator, BlockSize>::reference ConcurrentVector<T, Allocator, BlockSize>::at(const size_type index) {
+    if(!(index < size()))
+        throw std::out_of_range("Index out of range");
+    return *slot(index);
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+ConcurrentVector<T, Allocator, BlockSize>::const_reference ConcurrentVector<T, Allocator, BlockSize>::at(const size_type index) const {
+    if(!(index < size()))
+        throw std::out_of_range("Index out of range");
+    return *slot(index);
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+ConcurrentVector<T, Allocator, BlockSize>::iterator ConcurrentVector<T, Allocator, BlockSize>::begin() noexcept {
+    return iterator(this, 0);
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+ConcurrentVector<T, Allocator, BlockSize>::const_iterator ConcurrentVector<T, Allocator, BlockSize>::begin() const noexcept {
+    return const_iterator(this, 0);
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+ConcurrentVector<T, Allocator, BlockSize>::const_iterator ConcurrentVector<T, Allocator, BlockSize>::cbegin() const noexcept {
+    return const_iterator(this, 0);
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+ConcurrentVector<T, Allocator, BlockSize>::iterator ConcurrentVector<T, Allocator, BlockSize>::end() noexcept {
+    return iterator(this, size());
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+ConcurrentVector<T, Allocator, BlockSize>::const_iterator ConcurrentVector<T, Allocator, BlockSize>::end() const noexcept {
+    return const_iterator(this, size());
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+ConcurrentVector<T, Allocator, BlockSize>::const_iterator ConcurrentVector<T, Allocator, BlockSize>::cend() const noexcept {
+    return const_iterator(this, size());
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+constexpr ConcurrentVector<T, Allocator, BlockSize>::allocator ConcurrentVector<T, Allocator, BlockSize>::get_allocator() const noexcept {
+    return alloc_;
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+ConcurrentVector<T, Allocator, BlockSize>::pointer ConcurrentVector<T, Allocator, BlockSize>::slot(size_type index) const noexcept {
+    size_type block {blocks_t::blockOf(index)};
+    // The acquire on published_ or reserved_ already ordered the block
+    return blocks_[block].load(std::memory_order_relaxed) + (index - blocks_t::blockStart(block));
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+std::atomic<bool>& ConcurrentVector<T, Allocator, BlockSize>::readyFlag(size_type index) const noexcept {
+    size_type block {blocks_t::blockOf(index)};
+    return ready_[block].load(std::memory_order_relaxed)[index - blocks_t::blockStart(block)];
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+void ConcurrentVector<T, Allocator, BlockSize>::ensureBlock(size_type block) {
+    if(!(block < blocks_t::kMaxBlocks)) {
+        throw std::length_error("ConcurrentVector can not grow any further");
+    }
+    if(blocks_[block].load(std::memory_order_acquire)) {
+        return;
+    }
+    if(!ready_[block].load(std::memory_order_acquire)) {
+        flag_allocator flag_alloc(alloc_);
+        std::atomic<bool>* flags {flag_traits_t::allocate(flag_alloc, blocks_t::blockCapacity(block))};
+        for(size_type i {0}; i < blocks_t::blockCapacity(block); ++i) {
+            flag_traits_t::construct(flag_alloc, flags + i, false);
+        }
+        std::atomic<bool>* no_flags {nullptr};
+        if(!ready_[block].compare_exchange_strong(no_flags, flags, std::memory_order_acq_rel, std::memory_order_acquire)) {
+            flag_traits_t::deallocate(flag_alloc, flags, blocks_t::blockCapacity(block));
+        }
+    }
+    pointer p {traits_t::allocate(alloc_, blocks_t::blockCapacity(block))};
+    pointer expected {nullptr};
+    if(!blocks_[block].compare_exchange_strong(expected, p, std::memory_order_acq_rel, std::memory_order_acquire)) {
+        // Another thread was faster
+        traits_t::deallocate(alloc_, p, blocks_t::blockCapacity(block));
+    }
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+ConcurrentVector<T, Allocator, BlockSize>::size_type ConcurrentVector<T, Allocator, BlockSize>::reserveIndex() {
+    size_type index {reserved_.load(std::memory_order_relaxed)};
+    do {
+        ensureBlock(blocks_t::blockOf(index));
+    } while(!reserved_.compare_exchange_weak(index, index + 1, std::memory_order_acq_rel, std::memory_order_relaxed));
+    return index;
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+void ConcurrentVector<T, Allocator, BlockSize>::publish(size_type index) noexcept {
+    // Sequentially consistent, so of two threads finishing neighbouring
+    // slots at least one sees both flags and moves the watermark over both
+    readyFlag(index).store(true);
+    size_type current {published_.load()};
+    while(current < reserved_.load() && readyFlag(current).load()) {
+        if(published_.compare_exchange_weak(current, current + 1)) {
+            ++current;
+        }
+    }
+}
+
+}
+#endif // CONCURRENTVECTOR_HPP
@@ -0,0 +1,238 @@
+#ifndef DS_EPOCH_HPP
+#define DS_EPOCH_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace ds {
+
+namespace detail {
+
+// Hands out small thread indices, which get reused once their thread exits
+class ThreadIndices {
+public:
+    std::size_t acquire() {
+        std::lock_guard lock {mutex_};
+        if(free_.empty()) {
+            return next_++;
+        }
+        std::size_t index {free_.back()};
+        free_.pop_back();
+        return index;
+    }
+
+    void release(std::size_t index) {
+        std::lock_guard lock {mutex_};
+        free_.push_back(index);
+    }
+
+private:
+    std::mutex mutex_;
+    std::vector<std::size_t> free_;
+    std::size_t next_ {0};
+};
+
+inline ThreadIndices& threadIndices() {
+    static ThreadIndices indices;
+    return indices;
+}
+
+struct ThreadIndex {
+    ThreadIndex(): value {threadIndices().acquire()} {}
+    ~ThreadIndex() { threadIndices().release(value); }
+
+    std::size_t value;
+};
+
+inline std::size_t threadIndex() {
+    thread_local ThreadIndex index;
+    return index.value;
+}
+
+}
+
+// Epoch based reclamation. Readers pin the domain while they hold pointers
+// into a shared structure, writers unlink an object and retire it. A
+// retired object gets deleted once the global epoch moved on twice, at
+// that point every reader which could have seen it has unpinned.
+// Pinning only writes the slot of the calling thread, so readers never
+// touch a shared cache line.
+class EpochDomain {
+private:
+    struct Slot;
+
+public:
+    // Keeps the domain pinned, guards of one thread can nest
+    class Guard {
+    public:
+        explicit Guard(const EpochDomain& domain);
+        Guard(const Guard& other) = delete;
+        Guard& operator=(const Guard& other) = delete;
+        ~Guard();
+
+    private:
+        Slot& slot_;
+    };
+
+public:
+    EpochDomain() = default;
+    EpochDomain(const EpochDomain& other) = delete;
+    EpochDomain& operator=(const EpochDomain& other) = delete;
+    // No thread may be pinned anymore, everything retired gets deleted
+    ~EpochDomain();
+
+    Guard pin() const;
+
+    // 'ptr' has to be unreachable for new readers already. It gets deleted
+    // with 'delete' once no reader can hold it anymore.
+    template<class U>
+    void retire(U* ptr);
+    // Advances the epoch if possible and deletes what is safe to delete
+    void collect();
+
+    std::uint64_t epoch() const noexcept;
+    // Number of retired objects which still wait for deletion
+    std::size_t pending() const;
+
+private:
+    static constexpr std::size_t kSlotsPerBlock {64};
+
+    // 0 if the thread is not pinned, else (epoch << 1) | 1
+    struct alignas(64) Slot {
+        std::atomic<std::uint64_t> state {0};
+        // Only touched by the owning thread
+        std::size_t nesting {0};
+    };
+
+    // Slots get added in blocks whenever a thread with a higher index
+    // shows up, blocks only get freed with the domain
+    struct Block {
+        Slot slots[kSlotsPerBlock];
+        std::atomic<Block*> next {nullptr};
+    };
+
+    struct Retired {
+        std::uint64_t epoch;
+        void* ptr;
+        void (*deleter)(void*);
+    };
+
+    std::atomic<std::uint64_t> epoch_ {0};
+    mutable Block head_;
+    mutable std::mutex retired_mutex_;
+    std::vector<Retired> retired_;
+
+private:
+    Slot& slotFor(std::size_t index) const;
+    bool tryAdvance();
+    // Caller holds 'retired_mutex_'
+    void deleteSafe();
+};
+
+inline EpochDomain::Guard::Guard(const EpochDomain& domain): slot_ {domain.slotFor(detail::threadIndex())} {
+    if(slot_.nesting++ == 0) {
+        slot_.state.store((domain.epoch_.load(std::memory_order_relaxed) << 1) | 1, std::memory_order_relaxed);
+        // The announcement has to be visible before any pointer gets loaded
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+}
+
+inline EpochDomain::Guard::~Guard() {
+    if(--slot_.nesting == 0) {
+        slot_.state.store(0, std::memory_order_release);
+    }
+}
+
+inline EpochDomain::~EpochDomain() {
+    for(const Retired& retired: retired_) {
+        retired.deleter(retired.ptr);
+    }
+    Block* block {head_.next.load(std::memory_order_relaxed)};
+    while(block) {
+        Block* next {block->next.load(std::memory_order_relaxed)};
+        delete block;
+        block = next;
+    }
+}
+
+inline EpochDomain::Guard EpochDomain::pin() const {
+    return Guard(*this);
+}
+
+template<class U>
+void EpochDomain::retire(U* ptr) {
+    std::lock_guard lock {retired_mutex_};
+    retired_.push_back(Retired {epoch_.load(std::memory_order_seq_cst), ptr, [](void* p) { delete static_cast<U*>(p); }});
+    tryAdvance();
+    deleteSafe();
+}
+
+inline void EpochDomain::collect() {
+    std::lock_guard lock {retired_mutex_};
+    tryAdvance();
+    deleteSafe();
+}
+
+inline std::uint64_t EpochDomain::epoch() const noexcept {
+    return epoch_.load(std::memory_order_relaxed);
+}
+
+inline std::size_t EpochDomain::pending() const {
+    std::lock_guard lock {retired_mutex_};
+    return retired_.size();
+}
+
+inline EpochDomain::Slot& EpochDomain::slotFor(std::size_t index) const {
+    Block* block {&head_};
+    for(; index >= kSlotsPerBlock; index -= kSlotsPerBlock) {
+        Block* next {block->next.load(std::memory_order_acquire)};
+        if(!next) {
+            Block* added {new Block};
+            if(block->next.compare_exchange_strong(next, added, std::memory_order_acq_rel)) {
+                next = added;
+            } else {
+                delete added;
+            }
+        }
+        block = next;
+    }
+    return block->slots[index];
+}
+
+// The epoch can only move from e to e + 1 if every pinned thread has
+// announced e
+inline bool EpochDomain::tryAdvance() {
+    std::uint64_t epoch {epoch_.load(std::memory_order_relaxed)};
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    for(const Block* block {&head_}; block; block = block->next.load(std::memory_order_acquire)) {
+        for(const Slot& slot: block->slots) {
+            // Acquire pairs with the release of an unpin, the reads of that
+            // reader happen before anything gets deleted
+            std::uint64_t state {slot.state.load(std::memory_order_acquire)};
+            if((state & 1) && (state >> 1) != epoch) {
+                return false;
+            }
+        }
+    }
+    return epoch_.compare_exchange_strong(epoch, epoch + 1, std::memory_order_seq_cst);
+}
+
+inline void EpochDomain::deleteSafe() {
+    std::uint64_t epoch {epoch_.load(std::memory_order_acquire)};
+    auto last = std::partition(retired_.begin(), retired_.end(), [epoch](const Retired& retired) {
+        return retired.epoch + 2 > epoch;
+    });
+    for(auto it = last; it != retired_.end(); ++it) {
+        it->deleter(it->ptr);
+    }
+    retired_.erase(last, retired_.end());
+}
+
+}
+
+#endif //DS_EPOCH_HPP
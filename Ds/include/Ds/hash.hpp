@@ -0,0 +1,165 @@
+#ifndef DS_HASH_HPP
+#define DS_HASH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace ds {
+
+namespace detail {
+
+// Secrets of wyhash (final version 4)
+inline constexpr std::uint64_t kWyp0 {0xa0761d6478bd642full};
+inline constexpr std::uint64_t kWyp1 {0xe7037ed1a0b428dbull};
+inline constexpr std::uint64_t kWyp2 {0x8ebc6af09c88c6e3ull};
+inline constexpr std::uint64_t kWyp3 {0x589965cc75374cc3ull};
+
+// Full 64x64 -> 128 bit multiplication. Low half gets stored in 'a',
+// high half in 'b'.
+inline void multiply128(std::uint64_t& a, std::uint64_t& b) noexcept {
+#ifdef __SIZEOF_INT128__
+    __uint128_t r {static_cast<__uint128_t>(a) * b};
+    a = static_cast<std::uint64_t>(r);
+    b = static_cast<std::uint64_t>(r >> 64);
+#else
+    std::uint64_t ha {a >> 32}, hb {b >> 32}, la {static_cast<std::uint32_t>(a)}, lb {static_cast<std::uint32_t>(b)};
+    std::uint64_t rh {ha * hb}, rm0 {ha * lb}, rm1 {hb * la}, rl {la * lb};
+    std::uint64_t t {rl + (rm0 << 32)};
+    std::uint64_t c {t < rl};
+    std::uint64_t lo {t + (rm1 << 32)};
+    c += lo < t;
+    a = lo;
+    b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif
+}
+
+// Multiplies and folds both halves together. Every input bit influences
+// every output bit.
+inline std::uint64_t mix(std::uint64_t a, std::uint64_t b) noexcept {
+    multiply128(a, b);
+    return a ^ b;
+}
+
+// Maps 'hash' uniformly onto [0, n) with a multiplication instead of a
+// division (Lemire's fastrange)
+inline std::uint64_t fastRange(std::uint64_t hash, std::uint64_t n) noexcept {
+    multiply128(hash, n);
+    return n;
+}
+
+inline std::uint64_t read64(const std::uint8_t* p) noexcept {
+    std::uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline std::uint64_t read32(const std::uint8_t* p) noexcept {
+    std::uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline std::uint64_t read3(const std::uint8_t* p, std::size_t k) noexcept {
+    return (static_cast<std::uint64_t>(p[0]) << 16) | (static_cast<std::uint64_t>(p[k >> 1]) << 8) | p[k - 1];
+}
+
+// wyhash over an arbitrary byte sequence
+inline std::uint64_t hashBytes(const void* data, std::size_t len, std::uint64_t seed = 0) noexcept {
+    const auto* p {static_cast<const std::uint8_t*>(data)};
+    seed ^= mix(seed ^ kWyp0, kWyp1);
+    std::uint64_t a, b;
+    if(len <= 16) {
+        if(len >= 4) {
+            a = (read32(p) << 32) | read32(p + ((len >> 3) << 2));
+            b = (read32(p + len - 4) << 32) | read32(p + len - 4 - ((len >> 3) << 2));
+        } else if(len > 0) {
+            a = read3(p, len);
+            b = 0;
+        } else {
+            a = b = 0;
+        }
+    } else {
+        std::size_t i {len};
+        if(i >= 48) {
+            std::uint64_t see1 {seed}, see2 {seed};
+            do {
+                seed = mix(read64(p) ^ kWyp1, read64(p + 8) ^ seed);
+                see1 = mix(read64(p + 16) ^ kWyp2, read64(p + 24) ^ see1);
+                see2 = mix(read64(p + 32) ^ kWyp3, read64(p + 40) ^ see2);
+                p += 48;
+                i -= 48;
+            } while(i >= 48);
+            seed ^= see1 ^ see2;
+        }
+        while(i > 16) {
+            seed = mix(read64(p) ^ kWyp1, read64(p + 8) ^ seed);
+            i -= 16;
+            p += 16;
+        }
+        a = read64(p + i - 16);
+        b = read64(p + i - 8);
+    }
+    a ^= kWyp1;
+    b ^= seed;
+    multiply128(a, b);
+    return mix(a ^ kWyp0 ^ len, b ^ kWyp1);
+}
+
+inline std::uint64_t hashInt(std::uint64_t key) noexcept {
+    return mix(key ^ kWyp0, kWyp1);
+}
+
+}
+
+// Default hash of the hashtables. std::hash is the identity for integers
+// on most standard libraries, which puts consecutive keys into the same
+// group and leaves the upper bits empty. FastHash runs integers through a
+// multiply-fold finalizer and strings through wyhash, so all 64 bits are
+// usable for the bucket index and the 7 bit control fragment.
+template<class Key>
+struct FastHash {
+    std::size_t operator()(const Key& key) const noexcept(noexcept(std::hash<Key>{}(key))) {
+        return static_cast<std::size_t>(detail::hashInt(std::hash<Key>{}(key)));
+    }
+};
+
+template<class Key>
+requires (std::is_integral_v<Key> || std::is_enum_v<Key> || std::is_pointer_v<Key>)
+struct FastHash<Key> {
+    std::size_t operator()(Key key) const noexcept {
+        if constexpr(std::is_pointer_v<Key>) {
+            return static_cast<std::size_t>(detail::hashInt(reinterpret_cast<std::uintptr_t>(key)));
+        } else {
+            return static_cast<std::size_t>(detail::hashInt(static_cast<std::uint64_t>(key)));
+        }
+    }
+};
+
+// Strings, string views and character pointers hash to the same value,
+// so both string hashes are transparent
+template<class CharT, class Traits, class Alloc>
+struct FastHash<std::basic_string<CharT, Traits, Alloc>> {
+    using is_transparent = void;
+
+    std::size_t operator()(std::basic_string_view<CharT, Traits> key) const noexcept {
+        return static_cast<std::size_t>(detail::hashBytes(key.data(), key.size() * sizeof(CharT)));
+    }
+};
+
+template<class CharT, class Traits>
+struct FastHash<std::basic_string_view<CharT, Traits>> {
+    using is_transparent = void;
+
+    std::size_t operator()(std::basic_string_view<CharT, Traits> key) const noexcept {
+        return static_cast<std::size_t>(detail::hashBytes(key.data(), key.size() * sizeof(CharT)));
+    }
+};
+
+}
+
+#endif //DS_HASH_HPP
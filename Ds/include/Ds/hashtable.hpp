@@ -2,49 +2,252 @@
 #define HASH_TABLE_HPP
 
 #include "concepts.hpp"
+#include "hash.hpp"
 
 #include <utility>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
 #include <list>
 #include <algorithm>
+#include <array>
+#include <bit>
 #include <string>
 #include <iostream>
 #include <functional>
 #include <memory>
+#include <numeric>
 #include <cassert>
 #include <exception>
-#include <optional>
+#include <stdexcept>
+#include <tuple>
 #include <type_traits>
 #include <iterator>
+#include <span>
+#include <ranges>
+#include <thread>
+#include <vector>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 
 namespace ds {
 
-template<Hashable Key, class T>
+namespace detail {
+
+// Every slot of the HashTable has one control byte. Full slots store the
+// lower 7 bits of the hash (H2), empty and deleted slots have the sign bit set.
+using ctrl_t = std::int8_t;
+inline constexpr ctrl_t kEmpty = static_cast<ctrl_t>(0b10000000);
+inline constexpr ctrl_t kDeleted = static_cast<ctrl_t>(0b11111110);
+
+constexpr bool isFull(ctrl_t ctrl) noexcept {
+    return ctrl >= 0;
+}
+
+// Hint to pull the cache line of 'ptr' in before it gets read
+inline void prefetch(const void* ptr) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(ptr);
+#elif defined(__SSE2__)
+    _mm_prefetch(static_cast<const char*>(ptr), _MM_HINT_T0);
+#else
+    (void)ptr;
+#endif
+}
+
+// Positions inside of a group which matched. Iterating over it yields
+// the offsets of the matches, lowest first.
+class BitMask {
+public:
+    explicit BitMask(std::uint32_t mask): mask_ {mask} {}
+
+    int operator*() const { return std::countr_zero(mask_); }
+    int trailingZeros() const { return std::countr_zero(mask_); }
+    // Counted from the last position of a 16 wide group
+    int leadingZeros() const { return std::countl_zero(static_cast<std::uint16_t>(mask_)); }
+    BitMask& operator++() { mask_ &= (mask_ - 1); return *this; }
+    explicit operator bool() const { return mask_ != 0; }
+
+    BitMask begin() const { return *this; }
+    BitMask end() const { return BitMask(0); }
+
+    friend bool operator!=(const BitMask& a, const BitMask& b) { return a.mask_ != b.mask_; }
+
+private:
+    std::uint32_t mask_;
+};
+
+// 16 consecutive control bytes which get compared at once. With SSE2 a
+// lookup costs one load, one compare and one movemask per group.
+class Group {
+public:
+    static constexpr std::size_t width = 16;
+
+#ifdef __SSE2__
+    explicit Group(const ctrl_t* pos): ctrl_ {_mm_loadu_si128(reinterpret_cast<const __m128i*>(pos))} {}
+
+    BitMask match(ctrl_t h2) const {
+        return BitMask(static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl_))));
+    }
+
+    BitMask matchEmpty() const {
+        return match(kEmpty);
+    }
+
+    // Empty and deleted are the only control bytes with the sign bit set
+    BitMask matchEmptyOrDeleted() const {
+        return BitMask(static_cast<std::uint32_t>(_mm_movemask_epi8(ctrl_)));
+    }
+
+    BitMask matchFull() const {
+        return BitMask(static_cast<std::uint32_t>(~_mm_movemask_epi8(ctrl_)) & 0xFFFF);
+    }
+
+private:
+    __m128i ctrl_;
+#else
+    explicit Group(const ctrl_t* pos) {
+        std::memcpy(ctrl_.data(), pos, width);
+    }
+
+    BitMask match(ctrl_t h2) const {
+        std::uint32_t mask {0};
+        for(std::size_t i {0}; i < width; ++i) {
+            mask |= static_cast<std::uint32_t>(ctrl_[i] == h2) << i;
+        }
+        return BitMask(mask);
+    }
+
+    BitMask matchEmpty() const {
+        return match(kEmpty);
+    }
+
+    BitMask matchEmptyOrDeleted() const {
+        std::uint32_t mask {0};
+        for(std::size_t i {0}; i < width; ++i) {
+            mask |= static_cast<std::uint32_t>(!isFull(ctrl_[i])) << i;
+        }
+        return BitMask(mask);
+    }
+
+    BitMask matchFull() const {
+        std::uint32_t mask {0};
+        for(std::size_t i {0}; i < width; ++i) {
+            mask |= static_cast<std::uint32_t>(isFull(ctrl_[i])) << i;
+        }
+        return BitMask(mask);
+    }
+
+private:
+    std::array<ctrl_t, width> ctrl_;
+#endif
+};
+
+// Layout of a HashTable snapshot:
+//   SnapshotHeader
+//   capacity + Group::width control bytes
+//   zero padding up to 'slots_offset'
+//   capacity SnapshotSlots of 'value_size' bytes each, empty ones zeroed
+// Bump kSnapshotVersion whenever any of it changes.
+inline constexpr std::uint32_t kSnapshotVersion {1};
+inline constexpr char kSnapshotMagic[8] {'D', 'S', 'H', 'T', 'S', 'N', 'A', 'P'};
+// Written as is, a reader on a machine with another byte order sees it reversed
+inline constexpr std::uint32_t kSnapshotByteOrder {0x01020304};
+// The slot array starts on its own cache line
+inline constexpr std::size_t kSnapshotAlignment {64};
+
+struct SnapshotHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byte_order;
+    std::uint64_t key_size;
+    std::uint64_t mapped_size;
+    std::uint64_t value_size;
+    std::uint64_t value_align;
+    std::uint64_t capacity;
+    std::uint64_t size;
+    std::uint64_t slots_offset;
+};
+
+// std::pair is not trivially copyable, the slots get stored as plain structs
+template<class Key, class T>
+struct SnapshotSlot {
+    Key first;
+    T second;
+};
+
+}
+
+// Tag for bulk loads whose keys are known to be distinct
+struct assume_unique_t {
+    explicit assume_unique_t() = default;
+};
+inline constexpr assume_unique_t assume_unique {};
+
+template<class Key, class T, HashFunction<Key> Hash = FastHash<Key>, class KeyEqual = std::equal_to<Key>>
 class HashTable;
 
-template<class KeyF, class TF>
-void swap(HashTable<KeyF, TF>& first, HashTable<KeyF, TF>& second) noexcept;
+template<class KeyF, class TF, class HashF, class KeyEqualF>
+void swap(HashTable<KeyF, TF, HashF, KeyEqualF>& first, HashTable<KeyF, TF, HashF, KeyEqualF>& second) noexcept;
 
-template<Hashable Key, class T>
+// Open addressing hashtable in the style of a swiss table. Next to the slot
+// array lives an array of 1 byte control values, which get scanned one
+// group of 16 slots at a time. Keys only get compared if their 7 bit hash
+// fragment matched, so most probes never touch the slot array.
+// The capacity is always a power of two and the table grows by doubling
+// as soon as inserting would exceed max_load_factor().
+// 'Hash' and 'KeyEqual' work like the ones of std::unordered_map. The
+// default FastHash mixes all bits, since the upper ones pick the group
+// and the lower 7 ones end up in the control bytes.
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
 class HashTable {
 public:
     using key_type = Key;
-    using mapped_type = T; 
+    using mapped_type = T;
     using value_type = std::pair<Key, T>;
     using size_type = std::size_t;
     using reference = value_type&;
     using const_reference = const value_type&;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+    using allocator_type = std::allocator<value_type>;
+    using traits_t = std::allocator_traits<allocator_type>;
+    using pointer = typename traits_t::pointer;
+
+private:
+    template<bool IsConst>
+    class Iterator;
+
+public:
+    // Forward iterators over the slot array in memory order. Any insert can
+    // rehash and invalidates them.
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
 
 public:
     HashTable();
-    HashTable(size_type size);
+    HashTable(size_type size, const Hash& hash = Hash(), const KeyEqual& equal = KeyEqual());
     HashTable(std::initializer_list<value_type> iList);
     template<class InputIt>
     requires is_it<InputIt>
     HashTable(InputIt first, InputIt last);
     HashTable(const HashTable& ht);
     HashTable(HashTable&& other) noexcept;
+    ~HashTable();
+
+    // Bulk load. Sizes the table once and hashes the keys a batch ahead of
+    // placing them. Of duplicate keys the first one wins, like with insert.
+    template<std::ranges::forward_range Range>
+    static HashTable from_range(Range&& range, const Hash& hash = Hash(), const KeyEqual& equal = KeyEqual());
+    // The keys of 'range' have to be distinct, nothing gets probed for
+    // duplicates. A random access range gets placed by up to 'threads'
+    // threads, each one filling its own part of the slot array.
+    template<std::ranges::forward_range Range>
+    static HashTable from_range(assume_unique_t, Range&& range, size_type threads = 1, const Hash& hash = Hash(), const KeyEqual& equal = KeyEqual());
 
     // Size functions
     constexpr size_type size() const;
@@ -52,52 +255,213 @@ public:
     constexpr bool empty() const;
     constexpr bool exists(const key_type& key) const;
 
+    // Iterators
+    iterator begin() noexcept;
+    const_iterator begin() const noexcept;
+    iterator end() noexcept;
+    const_iterator end() const noexcept;
+    // Calls 'f' with every element. Scans the control bytes a group at a
+    // time and skips empty groups without touching their slots.
+    template<class F>
+    void for_each(F&& f);
+    template<class F>
+    void for_each(F&& f) const;
+
+    // Bucket interface. Every slot is a bucket holding zero or one element.
+    size_type bucket_count() const noexcept;
+    size_type bucket_size(size_type n) const;
+
+    // Writes the table to 'path' in the layout of detail::SnapshotHeader.
+    // A MappedHashTable serves lookups straight out of the file.
+    void save(const std::string& path) const
+    requires (std::is_trivially_copyable_v<Key> && std::is_trivially_copyable_v<T>);
+
+    template<class K>
+    requires TransparentLookup<Hash, KeyEqual, K>
+    constexpr bool exists(const K& key) const;
+
+    // Lookup. The overloads taking a 'K' only exist if 'Hash' and 'KeyEqual'
+    // are transparent, e.g. std::string_view keys for a std::string table.
+    mapped_type* find(const key_type& key);
+    const mapped_type* find(const key_type& key) const;
+    template<class K>
+    requires TransparentLookup<Hash, KeyEqual, K>
+    mapped_type* find(const K& key);
+    template<class K>
+    requires TransparentLookup<Hash, KeyEqual, K>
+    const mapped_type* find(const K& key) const;
+    void find_batch(std::span<const key_type> keys, std::span<mapped_type*> results);
+    void find_batch(std::span<const key_type> keys, std::span<const mapped_type*> results) const;
+    size_type contains_batch(std::span<const key_type> keys, std::span<bool> results) const;
+
+    // Hash policy
+    float load_factor() const noexcept;
+    float max_load_factor() const noexcept;
+    void max_load_factor(float ml);
+    void rehash(size_type count);
+    void reserve(size_type count);
+    hasher hash_function() const;
+    key_equal key_eq() const;
+
+    // Introspection. The probe length of an element is the number of groups
+    // a lookup scans before the one containing it, 0 means the first group.
+    std::vector<size_type> probe_length_histogram() const;
+    size_type max_probe_length() const;
 
     // Modifiers
     bool insert(const key_type& key, const mapped_type& value);
     bool insert(const key_type& key, const mapped_type&& value);
+    template<class... Args>
+    std::pair<mapped_type*, bool> try_emplace(const key_type& key, Args&&... args);
     T& operator[](const key_type& key);
     const T& operator[](const key_type& key) const;
     void erase(const key_type& key);
 
-    HashTable<Key, T>& operator=(HashTable<Key, T> other) noexcept;
+    HashTable<Key, T, Hash, KeyEqual>& operator=(HashTable<Key, T, Hash, KeyEqual> other) noexcept;
+
+    template<class KeyF, class TF, class HashF, class KeyEqualF>
+    friend void swap(HashTable<KeyF, TF, HashF, KeyEqualF>& first, HashTable<KeyF, TF, HashF, KeyEqualF>& second) noexcept;
 
-    template<class KeyF, class TF>
-    friend void swap(HashTable<KeyF, TF>& first, HashTable<KeyF, TF>& second) noexcept;
-    
 private:
+    using ctrl_t = detail::ctrl_t;
+    using Group = detail::Group;
+
     size_type capacity_;
     size_type size_;
-    std::vector<std::optional<value_type>> arr_;
+    // Number of empty slots which can still be filled before the table has
+    // to grow. Erasing only gives it back if the slot could be reset to
+    // empty, tombstones get dropped on rehash.
+    size_type growth_left_;
+    float max_load_factor_;
+    // capacity_ + Group::width bytes. The bytes behind capacity_ mirror the
+    // first ones, so a group can be loaded at any index without wrapping.
+    std::vector<ctrl_t> ctrl_;
+    allocator_type alloc_;
+    pointer arr_;
+    [[no_unique_address]] hasher hash_;
+    [[no_unique_address]] key_equal equal_;
 
 private:
-    static size_type addUpNums(size_type num);
-    size_type hashFunction(const Key& key) const;
+    template<class K>
+    size_type hashFunction(const K& key) const;
     size_type moduloIndex(size_type index) const;
+    static size_type h1(size_type hash);
+    static ctrl_t h2(size_type hash);
+    static size_type normalizeCapacity(size_type count);
+    size_type maxElements(size_type capacity) const;
+    size_type minCapacityFor(size_type count) const;
+    template<class K>
+    size_type findIndex(const K& key) const;
+    template<class K>
+    size_type findIndex(const K& key, size_type hash) const;
+    template<class F>
+    void forEachInBatch(std::span<const key_type> keys, F&& f) const;
+    size_type findFreeSlot(size_type hash) const;
+    size_type findFreeSlotIn(size_type hash, size_type begin, size_type end) const;
+    template<class It>
+    void bulkInsert(It first, It last, bool unique);
+    template<class It>
+    void bulkInsertParallel(It first, size_type count, size_type threads);
+    std::pair<size_type, bool> findOrPrepareInsert(const Key& key, size_type hash);
+    void growOrDropTombstones();
+    void eraseMeta(size_type index);
+    size_type probeLength(size_type index) const;
+    void setCtrl(size_type index, ctrl_t ctrl);
+    void destroyAndDealloc();
     template<class Type>
     bool insertPriv(const Key& key, Type&& value);
 
 
 };
 
-template<Hashable Key, class T>
-HashTable<Key, T>::HashTable(): capacity_ {0}, arr_(capacity_), size_(0) {}
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+template<bool IsConst>
+class HashTable<Key, T, Hash, KeyEqual>::Iterator {
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using difference_type   = std::ptrdiff_t;
+    using value_type        = HashTable::value_type;
+    using pointer           = std::conditional_t<IsConst, const value_type*, value_type*>;
+    using reference         = std::conditional_t<IsConst, const value_type&, value_type&>;
+
+    Iterator() = default;
+    // iterator converts to const_iterator
+    template<bool OtherConst>
+    requires (IsConst && !OtherConst)
+    Iterator(const Iterator<OtherConst>& other)
+        : ctrl_ {other.ctrl_}, slots_ {other.slots_}, index_ {other.index_}, capacity_ {other.capacity_} {}
 
-template<Hashable Key, class T>
-HashTable<Key, T>::HashTable(size_type size): capacity_ {size}, arr_(capacity_), size_ {0} {}
+    reference operator*() const { return slots_[index_]; }
+    pointer operator->() const { return slots_ + index_; }
 
-template<Hashable Key, class T>
-HashTable<Key, T>::HashTable(std::initializer_list<value_type> iList): capacity_ {iList.size() < 10000 ? 10000 : iList.size()*2}, size_(0), arr_(capacity_) {
+    Iterator& operator++() { ++index_; skipEmpty(); return *this; }
+    Iterator operator++(int) { Iterator tmp = *this; ++(*this); return tmp; }
+
+    friend bool operator==(const Iterator& a, const Iterator& b) { return a.slots_ == b.slots_ && a.index_ == b.index_; }
+
+private:
+    Iterator(const ctrl_t* ctrl, pointer slots, size_type index, size_type capacity)
+        : ctrl_ {ctrl}, slots_ {slots}, index_ {index}, capacity_ {capacity}
+    {
+        skipEmpty();
+    }
+
+    // Moves to the next full slot at or behind index_. The mirrored control
+    // bytes behind capacity_ can match too, those count as the end.
+    void skipEmpty() {
+        while(index_ < capacity_) {
+            detail::BitMask full {Group(ctrl_ + index_).matchFull()};
+            if(full) {
+                index_ = std::min(index_ + static_cast<size_type>(*full), capacity_);
+                return;
+            }
+            index_ += Group::width;
+        }
+        index_ = capacity_;
+    }
+
+    const ctrl_t* ctrl_ {nullptr};
+    pointer slots_ {nullptr};
+    size_type index_ {0};
+    size_type capacity_ {0};
+
+    template<bool>
+    friend class Iterator;
+    friend class HashTable;
+};
+
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+HashTable<Key, T, Hash, KeyEqual>::HashTable(): HashTable(0) {}
+
+// 'size' gets rounded up to the next power of two
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+HashTable<Key, T, Hash, KeyEqual>::HashTable(size_type size, const Hash& hash, const KeyEqual& equal)
+    : capacity_ {normalizeCapacity(size)}
+    , size_ {0}
+    , growth_left_ {0}
+    , max_load_factor_ {0.875f}
+    , ctrl_(capacity_ + Group::width, detail::kEmpty)
+    , arr_ {capacity_ ? traits_t::allocate(alloc_, capacity_) : nullptr}
+    , hash_ {hash}
+    , equal_ {equal}
+{
+    growth_left_ = maxElements(capacity_);
+}
+
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+HashTable<Key, T, Hash, KeyEqual>::HashTable(std::initializer_list<value_type> iList): HashTable() {
+    reserve(iList.size());
     for(const auto& elem: iList) {
         insertPriv(elem.first, elem.second);
     }
 }
 
-template<Hashable Key, class T>
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
 template<class InputIt>
 requires is_it<InputIt>
-HashTable<Key, T>::HashTable(InputIt first, InputIt last): capacity_ {std::distance(first, last) > 10000 ? static_cast<size_type>(std::distance(first, last) * 2) : 10000}, size_ {0}, arr_(capacity_) {
+HashTable<Key, T, Hash, KeyEqual>::HashTable(InputIt first, InputIt last): HashTable() {
     if constexpr(std::is_same_v<std::remove_reference_t<decltype(*first)>, value_type>) {
+        reserve(static_cast<size_type>(std::distance(first, last)));
         for(auto it = first; it != last; ++it) {
            const auto pair = *it;
 
@@ -108,184 +472,813 @@ HashTable<Key, T>::HashTable(InputIt first, InputIt last): capacity_ {std::dista
     }
 }
 
-template<Hashable Key, class T>
-HashTable<Key, T>::HashTable(const HashTable& ht): 
-    capacity_ {ht.capacity_},
-    size_ {ht.size_},
-    arr_ {ht.arr_}
-{
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+template<std::ranges::forward_range Range>
+HashTable<Key, T, Hash, KeyEqual> HashTable<Key, T, Hash, KeyEqual>::from_range(Range&& range, const Hash& hash, const KeyEqual& equal) {
+    HashTable table(0, hash, equal);
+    table.reserve(static_cast<size_type>(std::ranges::distance(range)));
+    table.bulkInsert(std::ranges::begin(range), std::ranges::end(range), false);
+    return table;
 }
 
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+template<std::ranges::forward_range Range>
+HashTable<Key, T, Hash, KeyEqual> HashTable<Key, T, Hash, KeyEqual>::from_range(assume_unique_t, Range&& range, size_type threads, const Hash& hash, const KeyEqual& equal) {
+    HashTable table(0, hash, equal);
+    size_type count {static_cast<size_type>(std::ranges::distance(range))};
+    table.reserve(count);
+    if constexpr(std::ranges::random_access_range<Range>) {
+        if(threads > 1) {
+            table.bulkInsertParallel(std::ranges::begin(range), count, threads);
+            return table;
+        }
+    }
+    table.bulkInsert(std::ranges::begin(range), std::ranges::end(range), true);
+    return table;
+}
 
-template<Hashable Key, class T>
-HashTable<Key, T>::HashTable(HashTable&& other) noexcept: HashTable() {
-    swap(*this, other); 
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+HashTable<Key, T, Hash, KeyEqual>::HashTable(const HashTable& ht): HashTable(ht.capacity_, ht.hash_, ht.equal_) {
+    max_load_factor_ = ht.max_load_factor_;
+    growth_left_ = ht.growth_left_;
+    ctrl_ = ht.ctrl_;
+    for(size_type i {0}; i < capacity_; ++i) {
+        if(detail::isFull(ctrl_[i])) {
+            traits_t::construct(alloc_, arr_ + i, ht.arr_[i]);
+        }
+    }
+    size_ = ht.size_;
+}
+
+
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+HashTable<Key, T, Hash, KeyEqual>::HashTable(HashTable&& other) noexcept: HashTable() {
+    swap(*this, other);
 }
 
-template<Hashable Key, class T>
-constexpr HashTable<Key, T>::size_type HashTable<Key, T>::size() const {
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+HashTable<Key, T, Hash, KeyEqual>::~HashTable() {
+    destroyAndDealloc();
+}
+
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+constexpr HashTable<Key, T, Hash, KeyEqual>::size_type HashTable<Key, T, Hash, KeyEqual>::size() const {
     assert(size_ <= capacity_ && "Size can not be greater than 200");
     return size_;
 }
 
-template<Hashable Key, class T>
-constexpr HashTable<Key, T>::size_type HashTable<Key, T>::capacity() const {
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+constexpr HashTable<Key, T, Hash, KeyEqual>::size_type HashTable<Key, T, Hash, KeyEqual>::capacity() const {
     assert(size_ <= capacity_ && "Size can not be greater than capacity");
     return capacity_;
 }
 
-template<Hashable Key, class T>
-constexpr bool HashTable<Key, T>::empty() const {
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+constexpr bool HashTable<Key, T, Hash, KeyEqual>::empty() const {
     assert(size_ <= capacity_ && "Size can not be greater than capacity");
     return size_ == 0;
 }
 
-template<Hashable Key, class T>
-constexpr bool HashTable<Key, T>::exists(const key_type& key) const {
-    size_type index {hashFunction(key)};
-    size_type old_index {index};
-    while(true) {
-        if(arr_[moduloIndex(index)]) {
-            if(key == (*arr_[moduloIndex(index)]).first) {
-                return true;
-            }
-        }
-        if (index == old_index) {
-            break;
-        }
-        ++index; 
-    }
-    return false;
-}
-
-template<Hashable Key, class T>
-T& HashTable<Key, T>::operator[](const key_type& key) {
-    size_type index = hashFunction(key);
-    assert(size_ <= capacity_ && size_ >= 0 && "Something went wrong!");
-    if (exists(key)) {
-        if(key == (*arr_[index]).first) {
-            return (*arr_[index]).second;
-        } else {
-            ++index;
-            while(true) {
-                if (arr_[moduloIndex(index)]) {
-                    if(key == (*arr_[moduloIndex(index)]).first) {
-                        return (*arr_[moduloIndex(index)]).second;
-                    }
-                }
-                ++index;
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+constexpr bool HashTable<Key, T, Hash, KeyEqual>::exists(const key_type& key) const {
+    return findIndex(key) != capacity_;
+}
+
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+HashTable<Key, T, Hash, KeyEqual>::iterator HashTable<Key, T, Hash, KeyEqual>::begin() noexcept {
+    return iterator(ctrl_.data(), arr_, 0, capacity_);
+}
+
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+HashTable<Key, T, Hash, KeyEqual>::const_iterator HashTable<Key, T, Hash, KeyEqual>::begin() const noexcept {
+    return const_iterator(ctrl_.data(), arr_, 0, capacity_);
+}
+
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+HashTable<Key, T, Hash, KeyEqual>::iterator HashTable<Key, T, Hash, KeyEqual>::end() noexcept {
+    return iterator(ctrl_.data(), arr_, capacity_, capacity_);
+}
+
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+HashTable<Key, T, Hash, KeyEqual>::const_iterator HashTable<Key, T, Hash, KeyEqual>::end() const noexcept {
+    return const_iterator(ctrl_.data(), arr_, capacity_, capacity_);
+}
+
+// Tables smaller than a group see mirrored control bytes behind capacity_,
+// so the index gets checked before calling 'f'
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+template<class F>
+void HashTable<Key, T, Hash, KeyEqual>::for_each(F&& f) {
+    for(size_type pos {0}; pos < capacity_; pos += Group::width) {
+        for(int i: Group(ctrl_.data() + pos).matchFull()) {
+            if(pos + i < capacity_) {
+                f(arr_[pos + i]);
             }
         }
-    } else {
-        while(true) {
-            if(!(arr_[moduloIndex(index)])) {
-                arr_[moduloIndex(index)] = std::make_pair(key, mapped_type());
-                ++size_;
-                return ((*arr_[moduloIndex(index)]).second);
+    }
+}
+
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+template<class F>
+void HashTable<Key, T, Hash, KeyEqual>::for_each(F&& f) const {
+    for(size_type pos {0}; pos < capacity_; pos += Group::width) {
+        for(int i: Group(ctrl_.data() + pos).matchFull()) {
+            if(pos + i < capacity_) {
+                f(static_cast<const value_type&>(arr_[pos + i]));
             }
-            ++index;
         }
     }
 }
 
-template<Hashable Key, class T>
-const T& HashTable<Key, T>::operator[](const key_type& key) const {
-    assert(size_ <= capacity_ && size_ >= 0 && "Something went wrong!");
-    size_type index = hashFunction(key);
-    if (!exists(key)) {
-        throw std::invalid_argument("Key is not present in the Hashtable");
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+HashTable<Key, T, Hash, KeyEqual>::size_type HashTable<Key, T, Hash, KeyEqual>::bucket_count() const noexcept {
+    return capacity_;
+}
+
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+HashTable<Key, T, Hash, KeyEqual>::size_type HashTable<Key, T, Hash, KeyEqual>::bucket_size(size_type n) const {
+    if(n >= capacity_) {
+        throw std::out_of_range("Bucket does not exist!");
     }
+    return detail::isFull(ctrl_[n]) ? 1 : 0;
+}
 
-    while(true) {
-        if(arr_[moduloIndex(index)]) {
-            if(key == (*arr_[moduloIndex(index)]).first) {
-                return (*arr_[moduloIndex(index)]).second;
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+void HashTable<Key, T, Hash, KeyEqual>::save(const std::string& path) const
+requires (std::is_trivially_copyable_v<Key> && std::is_trivially_copyable_v<T>)
+{
+    using Slot = detail::SnapshotSlot<Key, T>;
+
+    detail::SnapshotHeader header {};
+    std::memcpy(header.magic, detail::kSnapshotMagic, sizeof(header.magic));
+    header.version = detail::kSnapshotVersion;
+    header.byte_order = detail::kSnapshotByteOrder;
+    header.key_size = sizeof(Key);
+    header.mapped_size = sizeof(T);
+    header.value_size = sizeof(Slot);
+    header.value_align = alignof(Slot);
+    header.capacity = capacity_;
+    header.size = size_;
+    std::size_t alignment {std::max(detail::kSnapshotAlignment, alignof(Slot))};
+    std::size_t ctrl_end {sizeof(header) + ctrl_.size()};
+    header.slots_offset = (ctrl_end + alignment - 1) / alignment * alignment;
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(ctrl_.data()), static_cast<std::streamsize>(ctrl_.size()));
+    std::vector<char> chunk(header.slots_offset - ctrl_end, 0);
+    file.write(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+
+    // Slots get written in chunks, empty ones as zeros instead of whatever
+    // the uninitialized memory holds
+    constexpr size_type chunk_slots {4096};
+    chunk.resize(chunk_slots * sizeof(Slot));
+    for(size_type first {0}; first < capacity_; first += chunk_slots) {
+        size_type count {std::min(chunk_slots, capacity_ - first)};
+        std::fill(chunk.begin(), chunk.end(), 0);
+        for(size_type i {0}; i < count; ++i) {
+            if(detail::isFull(ctrl_[first + i])) {
+                // Only the members get copied into zeroed storage, the padding
+                // between them stays zero and equal tables give equal files
+                alignas(Slot) std::byte storage[sizeof(Slot)] {};
+                Slot* slot {reinterpret_cast<Slot*>(storage)};
+                std::memcpy(&slot->first, &arr_[first + i].first, sizeof(Key));
+                std::memcpy(&slot->second, &arr_[first + i].second, sizeof(T));
+                std::memcpy(chunk.data() + i * sizeof(Slot), storage, sizeof(Slot));
             }
         }
-        ++index;
+        file.write(chunk.data(), static_cast<std::streamsize>(count * sizeof(Slot)));
+    }
+
+    file.flush();
+    if(!file) {
+        throw std::runtime_error("Can not write snapshot to " + path);
+    }
+}
+
+// Returns a pointer to the value of 'key' or nullptr
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+HashTable<Key, T, Hash, KeyEqual>::mapped_type* HashTable<Key, T, Hash, KeyEqual>::find(const key_type& key) {
+    size_type index {findIndex(key)};
+    return index == capacity_ ? nullptr : &(arr_[index].second);
+}
+
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+const HashTable<Key, T, Hash, KeyEqual>::mapped_type* HashTable<Key, T, Hash, KeyEqual>::find(const key_type& key) const {
+    size_type index {findIndex(key)};
+    return index == capacity_ ? nullptr : &(arr_[index].second);
+}
+
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+template<class K>
+requires TransparentLookup<Hash, KeyEqual, K>
+constexpr bool HashTable<Key, T, Hash, KeyEqual>::exists(const K& key) const {
+    return findIndex(key) != capacity_;
+}
+
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+template<class K>
+requires TransparentLookup<Hash, KeyEqual, K>
+HashTable<Key, T, Hash, KeyEqual>::mapped_type* HashTable<Key, T, Hash, KeyEqual>::find(const K& key) {
+    size_type index {findIndex(key)};
+    return index == capacity_ ? nullptr : &(arr_[index].second);
+}
+
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+template<class K>
+requires TransparentLookup<Hash, KeyEqual, K>
+const HashTable<Key, T, Hash, KeyEqual>::mapped_type* HashTable<Key, T, Hash, KeyEqual>::find(const K& key) const {
+    size_type index {findIndex(key)};
+    return index == capacity_ ? nullptr : &(arr_[index].second);
+}
+
+// Looks up all 'keys' and stores a pointer to each value (or nullptr) at
+// the same index of 'results'. Lookups of a batch overlap their cache
+// misses instead of waiting for each other.
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+void HashTable<Key, T, Hash, KeyEqual>::find_batch(std::span<const key_type> keys, std::span<mapped_type*> results) {
+    if(results.size() < keys.size()) {
+        throw std::invalid_argument("Results need room for every key");
+    }
+    forEachInBatch(keys, [&](size_type i, size_type index) {
+        results[i] = index == capacity_ ? nullptr : &(arr_[index].second);
+    });
+}
+
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+void HashTable<Key, T, Hash, KeyEqual>::find_batch(std::span<const key_type> keys, std::span<const mapped_type*> results) const {
+    if(results.size() < keys.size()) {
+        throw std::invalid_argument("Results need room for every key");
     }
+    forEachInBatch(keys, [&](size_type i, size_type index) {
+        results[i] = index == capacity_ ? nullptr : &(arr_[index].second);
+    });
 }
-template<Hashable Key, class T>
-void HashTable<Key, T>::erase(const key_type& key) {
-    if(!exists(key)) {
+
+// Same as find_batch, but only stores if each key exists. Returns how many
+// of them exist.
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+HashTable<Key, T, Hash, KeyEqual>::size_type HashTable<Key, T, Hash, KeyEqual>::contains_batch(std::span<const key_type> keys, std::span<bool> results) const {
+    if(results.size() < keys.size()) {
+        throw std::invalid_argument("Results need room for every key");
+    }
+    size_type found {0};
+    forEachInBatch(keys, [&](size_type i, size_type index) {
+        results[i] = index != capacity_;
+        found += results[i];
+    });
+    return found;
+}
+
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+float HashTable<Key, T, Hash, KeyEqual>::load_factor() const noexcept {
+    return capacity_ == 0 ? 0.0f : static_cast<float>(size_) / static_cast<float>(capacity_);
+}
+
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+float HashTable<Key, T, Hash, KeyEqual>::max_load_factor() const noexcept {
+    return max_load_factor_;
+}
+
+// Open addressing can not store more elements than slots, and at least one
+// slot always stays empty so unsuccessful probes terminate.
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+void HashTable<Key, T, Hash, KeyEqual>::max_load_factor(float ml) {
+    if(!(ml > 0.0f && ml <= 1.0f)) {
+        throw std::invalid_argument("Max load factor has to be in (0, 1]");
+    }
+    max_load_factor_ = ml;
+    rehash(capacity_);
+}
+
+// Rebuilds the table with at least 'count' slots, or more if size() would
+// exceed the max load factor. Tombstones get dropped on the way.
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+void HashTable<Key, T, Hash, KeyEqual>::rehash(size_type count) {
+    size_type new_capacity {normalizeCapacity(std::max(count, minCapacityFor(size_)))};
+    bool has_tombstones {std::find(ctrl_.begin(), ctrl_.begin() + capacity_, detail::kDeleted) != ctrl_.begin() + capacity_};
+    if(new_capacity == capacity_ && !has_tombstones) {
+        growth_left_ = maxElements(capacity_) - size_;
         return;
     }
-    size_type index {hashFunction(key)};
-    while(true) {
-        if(arr_[moduloIndex(index)]) {
-            if(key == (*arr_[moduloIndex(index)]).first) {
-                arr_[moduloIndex(index)].reset();
-                --size_;
-                return;
+
+    HashTable<Key, T, Hash, KeyEqual> other(new_capacity, hash_, equal_);
+    other.max_load_factor_ = max_load_factor_;
+    other.growth_left_ = other.maxElements(other.capacity_);
+    for(size_type i {0}; i < capacity_; ++i) {
+        if(detail::isFull(ctrl_[i])) {
+            size_type hash {hashFunction(arr_[i].first)};
+            size_type index {other.findFreeSlot(hash)};
+            traits_t::construct(other.alloc_, other.arr_ + index, std::move(arr_[i]));
+            other.setCtrl(index, h2(hash));
+            ++other.size_;
+            --other.growth_left_;
+        }
+    }
+    swap(*this, other);
+}
+
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+void HashTable<Key, T, Hash, KeyEqual>::reserve(size_type count) {
+    if(count > size_) {
+        rehash(minCapacityFor(count));
+    }
+}
+
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+HashTable<Key, T, Hash, KeyEqual>::hasher HashTable<Key, T, Hash, KeyEqual>::hash_function() const {
+    return hash_;
+}
+
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+HashTable<Key, T, Hash, KeyEqual>::key_equal HashTable<Key, T, Hash, KeyEqual>::key_eq() const {
+    return equal_;
+}
+
+// Entry i counts the elements with a probe length of i
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+std::vector<typename HashTable<Key, T, Hash, KeyEqual>::size_type> HashTable<Key, T, Hash, KeyEqual>::probe_length_histogram() const {
+    std::vector<size_type> histogram;
+    for(size_type i {0}; i < capacity_; ++i) {
+        if(detail::isFull(ctrl_[i])) {
+            size_type length {probeLength(i)};
+            if(length >= histogram.size()) {
+                histogram.resize(length + 1, 0);
             }
+            ++histogram[length];
         }
-        ++index;
     }
+    return histogram;
+}
+
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+HashTable<Key, T, Hash, KeyEqual>::size_type HashTable<Key, T, Hash, KeyEqual>::max_probe_length() const {
+    size_type max_length {0};
+    for(size_type i {0}; i < capacity_; ++i) {
+        if(detail::isFull(ctrl_[i])) {
+            max_length = std::max(max_length, probeLength(i));
+        }
+    }
+    return max_length;
+}
+
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+T& HashTable<Key, T, Hash, KeyEqual>::operator[](const key_type& key) {
+    assert(size_ <= capacity_ && "Something went wrong!");
+    return *(try_emplace(key).first);
+}
+
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+const T& HashTable<Key, T, Hash, KeyEqual>::operator[](const key_type& key) const {
+    assert(size_ <= capacity_ && "Something went wrong!");
+    size_type index {findIndex(key)};
+    if (index == capacity_) {
+        throw std::invalid_argument("Key is not present in the Hashtable");
+    }
+    return arr_[index].second;
+}
 
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+void HashTable<Key, T, Hash, KeyEqual>::erase(const key_type& key) {
+    size_type index {findIndex(key)};
+    if(index == capacity_) {
+        return;
+    }
+    traits_t::destroy(alloc_, arr_ + index);
+    eraseMeta(index);
+    --size_;
 }
 
-template<Hashable Key, class T>
-bool HashTable<Key, T>::insert(const key_type& key, const mapped_type& value) {
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+bool HashTable<Key, T, Hash, KeyEqual>::insert(const key_type& key, const mapped_type& value) {
     return insertPriv(key, value);
 }
 
-template<Hashable Key, class T>
-bool HashTable<Key, T>::insert(const key_type& key, const mapped_type&& value) {
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+bool HashTable<Key, T, Hash, KeyEqual>::insert(const key_type& key, const mapped_type&& value) {
     return insertPriv(key, std::move(value));
 }
 
-template<Hashable Key, class T>
-HashTable<Key, T>::size_type HashTable<Key, T>::addUpNums(size_type num) {
-    std::size_t sum {0}; 
-    size_type new_num = num;
-    while(new_num > 0) {
-        short d = new_num % 10;
-        sum += (d+48);
-        new_num /= 10;
+// If 'key' does not exist, constructs its value from 'args'. Either way
+// only one probe sequence runs. Returns the value and if it got inserted.
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+template<class... Args>
+std::pair<typename HashTable<Key, T, Hash, KeyEqual>::mapped_type*, bool> HashTable<Key, T, Hash, KeyEqual>::try_emplace(const key_type& key, Args&&... args) {
+    size_type hash {hashFunction(key)};
+    auto [index, found] = findOrPrepareInsert(key, hash);
+    if(found) {
+        return std::make_pair(&(arr_[index].second), false);
+    }
+    if(index == capacity_) {
+        // Growing moves every element, 'key' and 'args' may refer to one of
+        // them, t.try_emplace(k, t[0]), so the element gets built first
+        value_type value(std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Args>(args)...));
+        growOrDropTombstones();
+        index = findFreeSlot(hash);
+        traits_t::construct(alloc_, arr_ + index, std::move(value));
+    } else {
+        traits_t::construct(alloc_, arr_ + index, std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Args>(args)...));
     }
-    return sum;
+    // Only filling an empty slot uses up growth, and only once the element
+    // exists, a throwing constructor leaves the count as it was
+    growth_left_ -= ctrl_[index] == detail::kEmpty;
+    setCtrl(index, h2(hash));
+    ++size_;
+    return std::make_pair(&(arr_[index].second), true);
 }
 
-template<Hashable Key, class T>
-HashTable<Key, T>::size_type HashTable<Key, T>::hashFunction(const Key& key) const {
-    return (HashTable<Key, T>::addUpNums(std::hash<T>{}(key)) % capacity_);
+// Returns the full hash. The upper 57 bits (H1) select the start group,
+// the 7 lowest bits (H2) get stored in the control byte.
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+template<class K>
+HashTable<Key, T, Hash, KeyEqual>::size_type HashTable<Key, T, Hash, KeyEqual>::hashFunction(const K& key) const {
+    return static_cast<size_type>(hash_(key));
 }
-template<Hashable Key, class T>
-HashTable<Key, T>::size_type HashTable<Key, T>::moduloIndex(size_type index) const {
-    return index % capacity_; 
+
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+HashTable<Key, T, Hash, KeyEqual>::size_type HashTable<Key, T, Hash, KeyEqual>::moduloIndex(size_type index) const {
+    return index & (capacity_ - 1);
 }
 
-template<Hashable Key, class T>
-template<class Type>
-bool HashTable<Key, T>::insertPriv(const Key& key, Type&& value) {
-    if(exists(key)) {
-        return false;
-    }
-    assert(size_ < capacity_ && "Array got no more space");
-    size_type index {hashFunction(key)};
-    while(true) {
-        if (!(arr_[moduloIndex(index)])) {
-            arr_[moduloIndex(index)] = std::make_pair(key, std::forward<Type>(value));  
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+HashTable<Key, T, Hash, KeyEqual>::size_type HashTable<Key, T, Hash, KeyEqual>::h1(size_type hash) {
+    return hash >> 7;
+}
+
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+HashTable<Key, T, Hash, KeyEqual>::ctrl_t HashTable<Key, T, Hash, KeyEqual>::h2(size_type hash) {
+    return static_cast<ctrl_t>(hash & 0x7F);
+}
+
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+HashTable<Key, T, Hash, KeyEqual>::size_type HashTable<Key, T, Hash, KeyEqual>::normalizeCapacity(size_type count) {
+    return count == 0 ? 0 : std::bit_ceil(count);
+}
+
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+HashTable<Key, T, Hash, KeyEqual>::size_type HashTable<Key, T, Hash, KeyEqual>::maxElements(size_type capacity) const {
+    if(capacity == 0) {
+        return 0;
+    }
+    return std::min(static_cast<size_type>(static_cast<double>(capacity) * max_load_factor_), capacity - 1);
+}
+
+// Smallest power of two capacity which holds 'count' elements without
+// exceeding the max load factor
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+HashTable<Key, T, Hash, KeyEqual>::size_type HashTable<Key, T, Hash, KeyEqual>::minCapacityFor(size_type count) const {
+    if(count == 0) {
+        return 0;
+    }
+    size_type capacity {normalizeCapacity(static_cast<size_type>(static_cast<double>(count) / max_load_factor_))};
+    while(maxElements(capacity) < count) {
+        capacity *= 2;
+    }
+    return capacity;
+}
+
+// Returns the index of 'key' or capacity_ if it is not present. Groups get
+// visited in triangular steps, which reaches every group of a power of two
+// table. The probe ends at the first group with an empty slot.
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+template<class K>
+HashTable<Key, T, Hash, KeyEqual>::size_type HashTable<Key, T, Hash, KeyEqual>::findIndex(const K& key) const {
+    if(capacity_ == 0) {
+        return capacity_;
+    }
+    return findIndex(key, hashFunction(key));
+}
+
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+template<class K>
+HashTable<Key, T, Hash, KeyEqual>::size_type HashTable<Key, T, Hash, KeyEqual>::findIndex(const K& key, size_type hash) const {
+    size_type pos {moduloIndex(h1(hash))};
+    for(size_type step {Group::width}; true; step += Group::width) {
+        Group group {ctrl_.data() + pos};
+        for(int i: group.match(h2(hash))) {
+            size_type index {moduloIndex(pos + i)};
+            if(equal_(arr_[index].first, key)) {
+                return index;
+            }
+        }
+        if(group.matchEmpty()) {
+            return capacity_;
+        }
+        pos = moduloIndex(pos + step);
+    }
+}
+
+// Splits 'keys' into batches. Each batch gets hashed first and the first
+// control group and slot of every key get prefetched, then all of them get
+// probed. 'f' receives the position in 'keys' and the found index.
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+template<class F>
+void HashTable<Key, T, Hash, KeyEqual>::forEachInBatch(std::span<const key_type> keys, F&& f) const {
+    constexpr size_type batch_size {16};
+    if(capacity_ == 0) {
+        for(size_type i {0}; i < keys.size(); ++i) {
+            f(i, capacity_);
+        }
+        return;
+    }
+
+    std::array<size_type, batch_size> hashes;
+    for(size_type first {0}; first < keys.size(); first += batch_size) {
+        size_type count {std::min(batch_size, keys.size() - first)};
+        for(size_type i {0}; i < count; ++i) {
+            hashes[i] = hashFunction(keys[first + i]);
+            size_type pos {moduloIndex(h1(hashes[i]))};
+            detail::prefetch(ctrl_.data() + pos);
+            detail::prefetch(arr_ + pos);
+        }
+        for(size_type i {0}; i < count; ++i) {
+            f(first + i, findIndex(keys[first + i], hashes[i]));
+        }
+    }
+}
+
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+HashTable<Key, T, Hash, KeyEqual>::size_type HashTable<Key, T, Hash, KeyEqual>::findFreeSlot(size_type hash) const {
+    size_type pos {moduloIndex(h1(hash))};
+    for(size_type step {Group::width}; true; step += Group::width) {
+        Group group {ctrl_.data() + pos};
+        if(auto mask = group.matchEmptyOrDeleted()) {
+            return moduloIndex(pos + *mask);
+        }
+        pos = moduloIndex(pos + step);
+    }
+}
+
+// Like findFreeSlot, but gives up with capacity_ as soon as the probe
+// would look at a group which is not completely inside of [begin, end)
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+HashTable<Key, T, Hash, KeyEqual>::size_type HashTable<Key, T, Hash, KeyEqual>::findFreeSlotIn(size_type hash, size_type begin, size_type end) const {
+    size_type pos {moduloIndex(h1(hash))};
+    for(size_type step {Group::width}; pos >= begin && pos + Group::width <= end; step += Group::width) {
+        Group group {ctrl_.data() + pos};
+        if(auto mask = group.matchEmptyOrDeleted()) {
+            return pos + *mask;
+        }
+        pos = moduloIndex(pos + step);
+    }
+    return capacity_;
+}
+
+// The table has to have room for all elements already. Hashes a batch of
+// keys and prefetches their first groups before placing any of them.
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+template<class It>
+void HashTable<Key, T, Hash, KeyEqual>::bulkInsert(It first, It last, bool unique) {
+    constexpr size_type batch_size {16};
+    std::array<size_type, batch_size> hashes;
+    while(first != last) {
+        It batch {first};
+        size_type count {0};
+        for(; count < batch_size && first != last; ++count, ++first) {
+            hashes[count] = hashFunction((*first).first);
+            detail::prefetch(ctrl_.data() + moduloIndex(h1(hashes[count])));
+        }
+        for(size_type i {0}; i < count; ++i, ++batch) {
+            const auto& elem = *batch;
+            size_type index;
+            if(unique) {
+                index = findFreeSlot(hashes[i]);
+            } else {
+                auto [found_index, found] = findOrPrepareInsert(elem.first, hashes[i]);
+                if(found) {
+                    continue;
+                }
+                index = found_index;
+                if(index == capacity_) {
+                    growOrDropTombstones();
+                    index = findFreeSlot(hashes[i]);
+                }
+            }
+            traits_t::construct(alloc_, arr_ + index, elem);
+            growth_left_ -= ctrl_[index] == detail::kEmpty;
+            setCtrl(index, h2(hashes[i]));
+            ++size_;
+        }
+    }
+}
+
+// Splits the slot array into one region per thread and sorts the elements
+// by the region their probe starts in. Every thread places the elements of
+// its region as long as their probe stays inside of it, so no two threads
+// read or write the same control bytes. The mirrored bytes behind the
+// table only get written by the first region, groups reading them cross
+// the end of the last one. Elements whose probe leaves their region get
+// placed afterwards by the calling thread.
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+template<class It>
+void HashTable<Key, T, Hash, KeyEqual>::bulkInsertParallel(It first, size_type count, size_type threads) {
+    // Smaller regions would defer too many elements to the serial pass
+    constexpr size_type min_region {4096};
+    size_type regions {std::bit_floor(std::max<size_type>(std::min(threads, capacity_ / min_region), 1))};
+    if(regions < 2) {
+        bulkInsert(first, first + count, true);
+        return;
+    }
+    size_type region_size {capacity_ / regions};
+
+    std::vector<std::exception_ptr> errors(regions);
+    auto run = [&](auto&& work) {
+        std::vector<std::jthread> workers;
+        for(size_type r {1}; r < regions; ++r) {
+            workers.emplace_back([&, r]() {
+                try {
+                    work(r);
+                } catch(...) {
+                    errors[r] = std::current_exception();
+                }
+            });
+        }
+        try {
+            work(0);
+        } catch(...) {
+            errors[0] = std::current_exception();
+        }
+        workers.clear();
+        for(const auto& error: errors) {
+            if(error) {
+                std::rethrow_exception(error);
+            }
+        }
+    };
+
+    std::vector<size_type> hashes(count);
+    run([&](size_type r) {
+        for(size_type i {count * r / regions}; i < count * (r + 1) / regions; ++i) {
+            hashes[i] = hashFunction(first[i].first);
+        }
+    });
+
+    // Counting sort of the element indices by region
+    std::vector<size_type> offsets(regions + 1, 0);
+    for(size_type hash: hashes) {
+        ++offsets[moduloIndex(h1(hash)) / region_size + 1];
+    }
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    std::vector<size_type> order(count);
+    std::vector<size_type> next(offsets.begin(), offsets.end() - 1);
+    for(size_type i {0}; i < count; ++i) {
+        order[next[moduloIndex(h1(hashes[i])) / region_size]++] = i;
+    }
+
+    std::vector<std::vector<size_type>> deferred(regions);
+    run([&](size_type r) {
+        for(size_type k {offsets[r]}; k < offsets[r + 1]; ++k) {
+            size_type i {order[k]};
+            size_type index {findFreeSlotIn(hashes[i], r * region_size, (r + 1) * region_size)};
+            if(index == capacity_) {
+                deferred[r].push_back(i);
+                continue;
+            }
+            traits_t::construct(alloc_, arr_ + index, first[i]);
+            setCtrl(index, h2(hashes[i]));
+        }
+    });
+    size_type placed {count};
+    for(const auto& region: deferred) {
+        placed -= region.size();
+    }
+    size_ += placed;
+    growth_left_ -= placed;
+
+    for(const auto& region: deferred) {
+        for(size_type i: region) {
+            size_type index {findFreeSlot(hashes[i])};
+            traits_t::construct(alloc_, arr_ + index, first[i]);
+            setCtrl(index, h2(hashes[i]));
             ++size_;
-            return true;
+            --growth_left_;
+        }
+    }
+}
+
+// Looks for 'key' and remembers the first free slot on the way, so an
+// insert does not need a second probe. Returns the index of 'key' and true,
+// or the slot 'key' has to be constructed in and false. If an empty slot
+// would have to be filled without growth left, the slot is capacity_ and
+// the caller has to grow the table first. The caller takes the growth once
+// the element got constructed.
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+std::pair<typename HashTable<Key, T, Hash, KeyEqual>::size_type, bool> HashTable<Key, T, Hash, KeyEqual>::findOrPrepareInsert(const Key& key, size_type hash) {
+    if(capacity_ != 0) {
+        size_type pos {moduloIndex(h1(hash))};
+        size_type free_index {capacity_};
+        for(size_type step {Group::width}; true; step += Group::width) {
+            Group group {ctrl_.data() + pos};
+            for(int i: group.match(h2(hash))) {
+                size_type index {moduloIndex(pos + i)};
+                if(equal_(arr_[index].first, key)) {
+                    return std::make_pair(index, true);
+                }
+            }
+            if(free_index == capacity_) {
+                if(auto mask = group.matchEmptyOrDeleted()) {
+                    free_index = moduloIndex(pos + *mask);
+                }
+            }
+            if(group.matchEmpty()) {
+                break;
+            }
+            pos = moduloIndex(pos + step);
+        }
+        // Reusing a tombstone needs no growth
+        if(ctrl_[free_index] == detail::kDeleted || growth_left_ > 0) {
+            return std::make_pair(free_index, false);
         }
-        ++index;
     }
+    return std::make_pair(capacity_, false);
+}
+
+// Doubles the capacity, unless more than half of the filled slots are
+// tombstones. Then rehashing at the same capacity frees enough slots.
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+void HashTable<Key, T, Hash, KeyEqual>::growOrDropTombstones() {
+    if(capacity_ == 0) {
+        rehash(Group::width);
+    } else if(size_ < maxElements(capacity_) / 2) {
+        rehash(capacity_);
+    } else {
+        rehash(capacity_ * 2);
+    }
+}
+
+// A slot can go back to empty if no probe ever had to skip over it. That is
+// the case if every group containing it also contains an empty slot, so the
+// empties before and after it are less than a group apart.
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+void HashTable<Key, T, Hash, KeyEqual>::eraseMeta(size_type index) {
+    size_type index_before {moduloIndex(index - Group::width)};
+    auto empty_after = Group(ctrl_.data() + index).matchEmpty();
+    auto empty_before = Group(ctrl_.data() + index_before).matchEmpty();
+    bool was_never_full {empty_before && empty_after && static_cast<size_type>(empty_after.trailingZeros() + empty_before.leadingZeros()) < Group::width};
+    setCtrl(index, was_never_full ? detail::kEmpty : detail::kDeleted);
+    growth_left_ += was_never_full;
+}
+
+// Replays the probe sequence of the element at 'index' until a group
+// covers its slot
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+HashTable<Key, T, Hash, KeyEqual>::size_type HashTable<Key, T, Hash, KeyEqual>::probeLength(size_type index) const {
+    size_type pos {moduloIndex(h1(hashFunction(arr_[index].first)))};
+    size_type length {0};
+    for(size_type step {Group::width}; moduloIndex(index - pos) >= Group::width; step += Group::width) {
+        pos = moduloIndex(pos + step);
+        ++length;
+    }
+    return length;
+}
+
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+void HashTable<Key, T, Hash, KeyEqual>::setCtrl(size_type index, ctrl_t ctrl) {
+    ctrl_[index] = ctrl;
+    // Tables smaller than a group get mirrored more than once
+    for(size_type i {index + capacity_}; i < capacity_ + Group::width; i += capacity_) {
+        ctrl_[i] = ctrl;
+    }
+}
+
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+void HashTable<Key, T, Hash, KeyEqual>::destroyAndDealloc() {
+    if(!arr_) {
+        return;
+    }
+    for(size_type i {0}; i < capacity_; ++i) {
+        if(detail::isFull(ctrl_[i])) {
+            traits_t::destroy(alloc_, arr_ + i);
+        }
+    }
+    traits_t::deallocate(alloc_, arr_, capacity_);
+    arr_ = nullptr;
+}
+
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+template<class Type>
+bool HashTable<Key, T, Hash, KeyEqual>::insertPriv(const Key& key, Type&& value) {
+    return try_emplace(key, std::forward<Type>(value)).second;
 }
 
-template<Hashable Key, class T>
-HashTable<Key, T>& HashTable<Key, T>::operator=(HashTable<Key, T> other) noexcept {
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+HashTable<Key, T, Hash, KeyEqual>& HashTable<Key, T, Hash, KeyEqual>::operator=(HashTable<Key, T, Hash, KeyEqual> other) noexcept {
     swap(*this, other);
 
     return *this;
 }
 
-template<class KeyF, class TF>
-void swap(HashTable<KeyF, TF>& first, HashTable<KeyF, TF>& second) noexcept {
+template<class KeyF, class TF, class HashF, class KeyEqualF>
+void swap(HashTable<KeyF, TF, HashF, KeyEqualF>& first, HashTable<KeyF, TF, HashF, KeyEqualF>& second) noexcept {
     using std::swap;
 
+    swap(first.hash_, second.hash_);
+    swap(first.equal_, second.equal_);
     swap(first.size_, second.size_);
     swap(first.capacity_, second.capacity_);
+    swap(first.growth_left_, second.growth_left_);
+    swap(first.max_load_factor_, second.max_load_factor_);
+    swap(first.ctrl_, second.ctrl_);
     swap(first.arr_, second.arr_);
 }
 
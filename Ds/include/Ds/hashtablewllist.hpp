@@ -3,23 +3,38 @@
 
 #include "concepts.hpp"
 #include "list.hpp"
+#include "hash.hpp"
+#include "nodepool.hpp"
 
 #include <cassert>
-#include <list>
+#include <cstdlib>
 #include <initializer_list>
 #include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
 #include <utility>
-#include <iterator>
 
 namespace ds {
 
-template <Hashable Key, MappedConcept T>
+template<class Key, MappedConcept T, HashFunction<Key> Hash = FastHash<Key>, class KeyEqual = std::equal_to<Key>>
 class HT;
 
-template <Hashable Key, MappedConcept T>
-void swap(HT<Key, T>& first, HT<Key, T>& second) noexcept;
-
-template<Hashable Key, MappedConcept T>
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
+void swap(HT<Key, T, Hash, KeyEqual>& first, HT<Key, T, Hash, KeyEqual>& second) noexcept;
+
+// Hashtable with separate chaining. 'Hash' and 'KeyEqual' work like the
+// ones of std::unordered_map, the bucket gets picked with a multiplication
+// (fastrange) instead of a modulo.
+// Every bucket is a single pointer to an intrusive, singly linked chain.
+// The nodes come from a NodePool owned by the table, so an insert
+// usually does not call the allocator at all.
+// Once there are as many elements as buckets the bucket array doubles.
+// The chains of the old array get moved over a few buckets per insert,
+// like the Redis dict does, so no single insert pays for the whole rehash.
+// Lookups search both arrays while a rehash is running.
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
 class HT {
 public:
     using key_type = Key;
@@ -28,20 +43,58 @@ public:
     using size_type = std::size_t;
     using reference = value_type&;
     using const_reference = const value_type&;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+
+private:
+    template<bool IsConst>
+    class Iterator;
+
+public:
+    // Forward iterators, bucket by bucket. Inserts can migrate chains of a
+    // running rehash and invalidate them.
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
 
 public:
     HT();
-    HT(size_type size);
+    HT(size_type size, const Hash& hash = Hash(), const KeyEqual& equal = KeyEqual());
     HT(std::initializer_list<value_type> iList);
     template<is_it InputIt>
     HT(InputIt first, InputIt last);
     HT(const HT& other);
     HT(HT&& other) noexcept;
+    ~HT();
 
     constexpr size_type capacity() const noexcept;
     constexpr size_type size() const noexcept;
+    hasher hash_function() const;
+    key_equal key_eq() const;
+    // True while chains of the previous bucket array still wait for migration
+    bool rehashing() const noexcept;
+
+    // Iterators
+    iterator begin() noexcept;
+    const_iterator begin() const noexcept;
+    iterator end() noexcept;
+    const_iterator end() const noexcept;
+    // Calls 'f' with every element, chain by chain
+    template<class F>
+    void for_each(F&& f);
+    template<class F>
+    void for_each(F&& f) const;
+
+    // Bucket interface of the current bucket array. While rehashing, the
+    // chains which still wait for migration are not part of any bucket.
+    size_type bucket_count() const noexcept;
+    size_type bucket_size(size_type n) const;
 
     constexpr std::pair<T*, bool> exists(const key_type& key) const;
+    // Lookups with a 'K' other than the key type, only if 'Hash' and
+    // 'KeyEqual' are transparent
+    template<class K>
+    requires TransparentLookup<Hash, KeyEqual, K>
+    constexpr std::pair<T*, bool> exists(const K& key) const;
 
     // Modifiers
     bool insert(const key_type& key, const mapped_type& value);
@@ -50,7 +103,7 @@ public:
     bool insert_or_assign(const Key& k, Type&& obj);
     template<class Type>
     bool insert_or_assign(Key&& k, Type&& obj);
-    HT<Key, T>& operator=(HT<Key, T> other);
+    HT<Key, T, Hash, KeyEqual>& operator=(HT<Key, T, Hash, KeyEqual> other);
     template<class...Args>
     bool emplace(Args&&... args);
     
@@ -59,19 +112,86 @@ public:
     mapped_type& operator[](key_type&& key);
     mapped_type& at(const key_type& key);
     const mapped_type& at(const key_type& key) const;
+    template<class K>
+    requires TransparentLookup<Hash, KeyEqual, K>
+    mapped_type& at(const K& key);
+    template<class K>
+    requires TransparentLookup<Hash, KeyEqual, K>
+    const mapped_type& at(const K& key) const;
 
 
-    friend void swap<Key, T>(HT<Key, T>& first, HT<Key, T>& second) noexcept;
+    friend void swap<Key, T, Hash, KeyEqual>(HT<Key, T, Hash, KeyEqual>& first, HT<Key, T, Hash, KeyEqual>& second) noexcept;
 
 
 private:
+    struct Node {
+        template<class... Args>
+        Node(Node* n, Args&&... args): next {n}, value(std::forward<Args>(args)...) {}
+
+        Node* next;
+        value_type value;
+    };
+
+    // Bucket heads from calloc. Big blocks come straight from the kernel
+    // already zeroed, so doubling a huge table does not start with a memset
+    // of the whole new array.
+    class Buckets {
+    public:
+        Buckets() = default;
+        explicit Buckets(size_type count): count_ {count} {
+            if(count_ > 0) {
+                heads_ = static_cast<Node**>(std::calloc(count_, sizeof(Node*)));
+                if(!heads_) {
+                    throw std::bad_alloc();
+                }
+            }
+        }
+        Buckets(Buckets&& other) noexcept: heads_ {std::exchange(other.heads_, nullptr)}, count_ {std::exchange(other.count_, 0)} {}
+        Buckets& operator=(Buckets&& other) noexcept {
+            std::swap(heads_, other.heads_);
+            std::swap(count_, other.count_);
+            return *this;
+        }
+        ~Buckets() { std::free(heads_); }
+
+        Node*& operator[](size_type i) noexcept { return heads_[i]; }
+        Node* operator[](size_type i) const noexcept { return heads_[i]; }
+        size_type size() const noexcept { return count_; }
+        bool empty() const noexcept { return count_ == 0; }
+        Node* const* begin() const noexcept { return heads_; }
+        Node* const* end() const noexcept { return heads_ + count_; }
+
+    private:
+        Node** heads_ {nullptr};
+        size_type count_ {0};
+    };
+
+    // Non empty old buckets migrated per modifying operation. Empty ones
+    // are skipped, but at most ten times as many per step.
+    static constexpr size_type kMigrateBuckets {8};
+
     size_type capacity_;   
     size_type size_;   
-    std::vector<std::list<value_type>> arr_;   
+    Buckets arr_;   
+    Buckets old_;
+    size_type migrated_ {0};
+    NodePool<Node> pool_;
+    [[no_unique_address]] hasher hash_;
+    [[no_unique_address]] key_equal equal_;
 
 private:
-    static size_type addUpNums(size_type num);
-    size_type hashFunction(const Key& key) const noexcept;
+    static size_type bucketIndex(size_type hash, size_type buckets) noexcept;
+    template<class K>
+    Node* findNode(const K& key, size_type hash) const;
+    // Constructs a node with hash 'hash' at the front of its chain
+    template<class... Args>
+    Node* newNode(size_type hash, Args&&... args);
+    // Relinks a chain into the chains of 'arr_'
+    void moveChain(Node* head);
+    // Migrates up to 'buckets' non empty buckets of 'old_' into 'arr_'
+    void migrate(size_type buckets);
+    void growIfFull();
+    void destroyNodes() noexcept;
 
     template<class KType, class Type>
     bool insertPriv(KType&& key, Type&& val);
@@ -84,113 +204,278 @@ private:
 
 };
 
-template<Hashable Key, MappedConcept T>
-HT<Key, T>::HT(): capacity_ {0}, size_ {0}, arr_(0) {};
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
+template<bool IsConst>
+class HT<Key, T, Hash, KeyEqual>::Iterator {
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using difference_type   = std::ptrdiff_t;
+    using value_type        = HT::value_type;
+    using pointer           = std::conditional_t<IsConst, const value_type*, value_type*>;
+    using reference         = std::conditional_t<IsConst, const value_type&, value_type&>;
+
+    Iterator() = default;
+    // iterator converts to const_iterator
+    template<bool OtherConst>
+    requires (IsConst && !OtherConst)
+    Iterator(const Iterator<OtherConst>& other)
+        : table_ {other.table_}, in_old_ {other.in_old_}, bucket_ {other.bucket_}, node_ {other.node_} {}
+
+    reference operator*() const { return node_->value; }
+    pointer operator->() const { return &node_->value; }
+
+    Iterator& operator++() {
+        node_ = node_->next;
+        if(!node_) {
+            ++bucket_;
+            seek();
+        }
+        return *this;
+    }
+    Iterator operator++(int) { Iterator tmp = *this; ++(*this); return tmp; }
+
+    friend bool operator==(const Iterator& a, const Iterator& b) { return a.node_ == b.node_; }
 
-template<Hashable Key, MappedConcept T>
-HT<Key, T>::HT(size_type size): capacity_ {size}, size_ {0}, arr_(capacity_) {};
+private:
+    explicit Iterator(const HT* table): table_ {table}, in_old_ {table->rehashing()} {
+        seek();
+    }
 
-template<Hashable Key, MappedConcept T>
-HT<Key, T>::HT(std::initializer_list<value_type> iList): HT(iList.size() < 10000 ? 10000 : iList.size() * 2) {
+    // Moves to the first chain at or behind bucket_, the old bucket array
+    // comes first
+    void seek() {
+        while(true) {
+            const Buckets& buckets {in_old_ ? table_->old_ : table_->arr_};
+            for(; bucket_ < buckets.size(); ++bucket_) {
+                if(buckets[bucket_]) {
+                    node_ = buckets[bucket_];
+                    return;
+                }
+            }
+            if(!in_old_) {
+                node_ = nullptr;
+                return;
+            }
+            in_old_ = false;
+            bucket_ = 0;
+        }
+    }
+
+    const HT* table_ {nullptr};
+    bool in_old_ {false};
+    size_type bucket_ {0};
+    Node* node_ {nullptr};
+
+    template<bool>
+    friend class Iterator;
+    friend class HT;
+};
+
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
+HT<Key, T, Hash, KeyEqual>::HT(): capacity_ {0}, size_ {0}, arr_(0) {};
+
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
+HT<Key, T, Hash, KeyEqual>::HT(size_type size, const Hash& hash, const KeyEqual& equal): capacity_ {size}, size_ {0}, arr_(capacity_), hash_ {hash}, equal_ {equal} {};
+
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
+HT<Key, T, Hash, KeyEqual>::HT(std::initializer_list<value_type> iList): HT(iList.size() < 10000 ? 10000 : iList.size() * 2) {
    for(const auto& elem: iList) {
         insertPriv(elem.first, elem.second);
    }
 }
 
-template<Hashable Key, MappedConcept T>
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
 template<is_it InputIt>
-HT<Key, T>::HT(InputIt first, InputIt last): HT(std::distance(first, last) < 10000 ? 10000 : std::distance(first, last) * 2) {
+HT<Key, T, Hash, KeyEqual>::HT(InputIt first, InputIt last): HT(std::distance(first, last) < 10000 ? 10000 : std::distance(first, last) * 2) {
     for(auto it=first; it != last; ++it) {
         insertPriv((*it).first, (*it).second);
     }
 }
 
-template<Hashable Key, MappedConcept T>
-HT<Key, T>::HT(const HT& other):
-    capacity_ {other.capacity_},
-    size_ {other.size_},
-    arr_ {other.arr_}
-{
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
+HT<Key, T, Hash, KeyEqual>::HT(const HT& other): HT(other.capacity_, other.hash_, other.equal_) {
+    // A running rehash of 'other' does not get copied, all elements go
+    // straight into the new bucket array
+    pool_.reserve(other.size_);
+    for(const auto* buckets: {&other.old_, &other.arr_}) {
+        for(const Node* head: *buckets) {
+            for(const Node* node {head}; node; node = node->next) {
+                newNode(hash_(node->value.first), node->value);
+            }
+        }
+    }
 }
 
-template<Hashable Key, MappedConcept T>
-HT<Key, T>::HT(HT&& other) noexcept: HT(){
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
+HT<Key, T, Hash, KeyEqual>::HT(HT&& other) noexcept: HT(){
     swap(*this, other);
 }
 
-template<Hashable Key, MappedConcept T>
-constexpr HT<Key, T>::size_type HT<Key, T>::capacity() const noexcept {
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
+HT<Key, T, Hash, KeyEqual>::~HT() {
+    destroyNodes();
+}
+
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
+constexpr HT<Key, T, Hash, KeyEqual>::size_type HT<Key, T, Hash, KeyEqual>::capacity() const noexcept {
     assert(size_ <= capacity_ && "Size can not be bigger than the capacity");
     return capacity_;
 }
 
-template<Hashable Key, MappedConcept T>
-constexpr HT<Key, T>::size_type HT<Key, T>::size() const noexcept {
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
+constexpr HT<Key, T, Hash, KeyEqual>::size_type HT<Key, T, Hash, KeyEqual>::size() const noexcept {
     assert(size_ <= capacity_ && "Size can not be bigger than the capacity");
     return size_;
 }
 
-template<Hashable Key, MappedConcept T>
-constexpr std::pair<T*, bool> HT<Key, T>::exists(const key_type& key) const {
-    size_type index {hashFunction(key)};
-    
-    const auto& list = arr_[index];
-    for(auto it=list.begin(); it != list.end(); ++it) {
-        if((*it).first == key) {
-            return std::make_pair(const_cast<T*>(&((*it).second)), true);
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
+HT<Key, T, Hash, KeyEqual>::hasher HT<Key, T, Hash, KeyEqual>::hash_function() const {
+    return hash_;
+}
+
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
+HT<Key, T, Hash, KeyEqual>::key_equal HT<Key, T, Hash, KeyEqual>::key_eq() const {
+    return equal_;
+}
+
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
+bool HT<Key, T, Hash, KeyEqual>::rehashing() const noexcept {
+    return !old_.empty();
+}
+
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
+HT<Key, T, Hash, KeyEqual>::iterator HT<Key, T, Hash, KeyEqual>::begin() noexcept {
+    return iterator(this);
+}
+
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
+HT<Key, T, Hash, KeyEqual>::const_iterator HT<Key, T, Hash, KeyEqual>::begin() const noexcept {
+    return const_iterator(this);
+}
+
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
+HT<Key, T, Hash, KeyEqual>::iterator HT<Key, T, Hash, KeyEqual>::end() noexcept {
+    return iterator();
+}
+
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
+HT<Key, T, Hash, KeyEqual>::const_iterator HT<Key, T, Hash, KeyEqual>::end() const noexcept {
+    return const_iterator();
+}
+
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
+template<class F>
+void HT<Key, T, Hash, KeyEqual>::for_each(F&& f) {
+    for(const Buckets* buckets: {&old_, &arr_}) {
+        for(Node* head: *buckets) {
+            for(Node* node {head}; node; node = node->next) {
+                f(node->value);
+            }
+        }
+    }
+}
+
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
+template<class F>
+void HT<Key, T, Hash, KeyEqual>::for_each(F&& f) const {
+    for(const Buckets* buckets: {&old_, &arr_}) {
+        for(const Node* head: *buckets) {
+            for(const Node* node {head}; node; node = node->next) {
+                f(node->value);
+            }
         }
     }
+}
+
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
+HT<Key, T, Hash, KeyEqual>::size_type HT<Key, T, Hash, KeyEqual>::bucket_count() const noexcept {
+    return capacity_;
+}
+
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
+HT<Key, T, Hash, KeyEqual>::size_type HT<Key, T, Hash, KeyEqual>::bucket_size(size_type n) const {
+    if(n >= capacity_) {
+        throw std::out_of_range("Bucket does not exist!");
+    }
+    size_type count {0};
+    for(const Node* node {arr_[n]}; node; node = node->next) {
+        ++count;
+    }
+    return count;
+}
+
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
+constexpr std::pair<T*, bool> HT<Key, T, Hash, KeyEqual>::exists(const key_type& key) const {
+    if(size_ == 0) {
+        return std::make_pair(nullptr, false);
+    }
+    if(Node* node {findNode(key, hash_(key))}) {
+        return std::make_pair(&node->value.second, true);
+    }
+    return std::make_pair(nullptr, false);
+}
 
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
+template<class K>
+requires TransparentLookup<Hash, KeyEqual, K>
+constexpr std::pair<T*, bool> HT<Key, T, Hash, KeyEqual>::exists(const K& key) const {
+    if(size_ == 0) {
+        return std::make_pair(nullptr, false);
+    }
+    if(Node* node {findNode(key, hash_(key))}) {
+        return std::make_pair(&node->value.second, true);
+    }
     return std::make_pair(nullptr, false);
 }
-template<Hashable Key, MappedConcept T>
-bool HT<Key, T>::insert(const key_type& key, const mapped_type& value) {
+
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
+bool HT<Key, T, Hash, KeyEqual>::insert(const key_type& key, const mapped_type& value) {
     return insertPriv(key, value);
 }
 
-template<Hashable Key, MappedConcept T>
-bool HT<Key, T>::insert(const value_type& pair) {
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
+bool HT<Key, T, Hash, KeyEqual>::insert(const value_type& pair) {
     return insertPriv(pair.first, pair.second);
 }
 
-template<Hashable Key, MappedConcept T>
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
 template<class Type>
-bool HT<Key, T>::insert_or_assign(const Key& key, Type&& obj) {
-    return _assign_or_insert(key, std::forward<Type>(obj));
+bool HT<Key, T, Hash, KeyEqual>::insert_or_assign(const Key& key, Type&& obj) {
+    return _insert_or_assign(key, std::forward<Type>(obj));
 }
 
-template<Hashable Key, MappedConcept T>
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
 template<class Type>
-bool HT<Key, T>::insert_or_assign(Key&& key, Type&& obj) {
+bool HT<Key, T, Hash, KeyEqual>::insert_or_assign(Key&& key, Type&& obj) {
     return _insert_or_assign(std::move(key), std::forward<Type>(obj));
 }
 
 
-template<Hashable Key, MappedConcept T>
-HT<Key, T>& HT<Key, T>::operator=(HT<Key, T> other) {
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
+HT<Key, T, Hash, KeyEqual>& HT<Key, T, Hash, KeyEqual>::operator=(HT<Key, T, Hash, KeyEqual> other) {
     swap(*this, other);
     
     return *this;
 }
 
-template<Hashable Key, MappedConcept T>
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
 template<class...Args>
-bool HT<Key, T>::emplace(Args&&... args) {
+bool HT<Key, T, Hash, KeyEqual>::emplace(Args&&... args) {
     return _emplace(value_type(std::forward<Args>(args)...));
 }
 
-template<Hashable Key, MappedConcept T>
-HT<Key, T>::mapped_type& HT<Key, T>::operator[](const key_type& key) {
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
+HT<Key, T, Hash, KeyEqual>::mapped_type& HT<Key, T, Hash, KeyEqual>::operator[](const key_type& key) {
     return _lookup(key);
 }
 
-template<Hashable Key, MappedConcept T>
-HT<Key, T>::mapped_type& HT<Key, T>::operator[](key_type&& key) {
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
+HT<Key, T, Hash, KeyEqual>::mapped_type& HT<Key, T, Hash, KeyEqual>::operator[](key_type&& key) {
     return _lookup(std::move( key ));
 }
 
-template<Hashable Key, MappedConcept T>
-HT<Key, T>::mapped_type& HT<Key, T>::at(const key_type& key) {
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
+HT<Key, T, Hash, KeyEqual>::mapped_type& HT<Key, T, Hash, KeyEqual>::at(const key_type& key) {
     auto pair = exists(key);
     if(!(pair.second)) {
         throw std::out_of_range("Element does not exist!");
@@ -198,8 +483,8 @@ HT<Key, T>::mapped_type& HT<Key, T>::at(const key_type& key) {
     return *(pair.first);
 }
 
-template<Hashable Key, MappedConcept T>
-const HT<Key, T>::mapped_type& HT<Key, T>::at(const key_type& key) const {
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
+const HT<Key, T, Hash, KeyEqual>::mapped_type& HT<Key, T, Hash, KeyEqual>::at(const key_type& key) const {
     auto pair = exists(key);
     if(!(pair.second)) {
         throw std::out_of_range("Element does not exist!!");
@@ -207,105 +492,196 @@ const HT<Key, T>::mapped_type& HT<Key, T>::at(const key_type& key) const {
     return *(pair.first);
 }
 
-template<Hashable Key, MappedConcept T>
-HT<Key, T>::size_type HT<Key, T>::addUpNums(size_type num) {
-    std::size_t sum {0}; 
-    size_type new_num = num;
-    while(new_num > 0) {
-        short d = new_num % 10;
-        sum += (d+48);
-        new_num /= 10;
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
+template<class K>
+requires TransparentLookup<Hash, KeyEqual, K>
+HT<Key, T, Hash, KeyEqual>::mapped_type& HT<Key, T, Hash, KeyEqual>::at(const K& key) {
+    auto pair = exists(key);
+    if(!(pair.second)) {
+        throw std::out_of_range("Element does not exist!");
     }
-    return sum;
+    return *(pair.first);
 }
 
-template<Hashable Key, MappedConcept T>
-HT<Key, T>::size_type HT<Key, T>::hashFunction(const Key& key) const noexcept {
-    assert(capacity_ > 0 && "Capacity has to be greater than 0");
-    return (HT<Key, T>::addUpNums(std::hash<Key>{}(key)) % capacity_);
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
+template<class K>
+requires TransparentLookup<Hash, KeyEqual, K>
+const HT<Key, T, Hash, KeyEqual>::mapped_type& HT<Key, T, Hash, KeyEqual>::at(const K& key) const {
+    auto pair = exists(key);
+    if(!(pair.second)) {
+        throw std::out_of_range("Element does not exist!!");
+    }
+    return *(pair.first);
 }
 
-template<Hashable Key, MappedConcept T>
-template<class KType, class Type>
-bool HT<Key, T>::insertPriv(KType&& key, Type&& val) {
-    size_type index {hashFunction(key)};
-    if(exists(key).second) {
-        return false;
-    }
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
+HT<Key, T, Hash, KeyEqual>::size_type HT<Key, T, Hash, KeyEqual>::bucketIndex(size_type hash, size_type buckets) noexcept {
+    assert(buckets > 0 && "Capacity has to be greater than 0");
+    return static_cast<size_type>(detail::fastRange(hash, buckets));
+}
 
-    if(size_ >= capacity_) {
-        throw std::length_error("Cant insert element into full hashtable");
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
+template<class K>
+HT<Key, T, Hash, KeyEqual>::Node* HT<Key, T, Hash, KeyEqual>::findNode(const K& key, size_type hash) const {
+    for(Node* node {arr_[bucketIndex(hash, capacity_)]}; node; node = node->next) {
+        if(equal_(node->value.first, key)) {
+            return node;
+        }
+    }
+    // Already migrated buckets of 'old_' are empty
+    if(!old_.empty()) {
+        for(Node* node {old_[bucketIndex(hash, old_.size())]}; node; node = node->next) {
+            if(equal_(node->value.first, key)) {
+                return node;
+            }
+        }
     }
+    return nullptr;
+}
 
-    arr_[index].push_back(std::make_pair(std::forward<KType>(key), std::forward<Type>(val)));
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
+template<class... Args>
+HT<Key, T, Hash, KeyEqual>::Node* HT<Key, T, Hash, KeyEqual>::newNode(size_type hash, Args&&... args) {
+    Node* node {pool_.allocate()};
+    try {
+        std::construct_at(node, nullptr, std::forward<Args>(args)...);
+    } catch(...) {
+        pool_.deallocate(node);
+        throw;
+    }
+    Node*& head {arr_[bucketIndex(hash, capacity_)]};
+    node->next = head;
+    head = node;
     ++size_;
-    return true;
+    return node;
 }
 
-template<Hashable Key, MappedConcept T>
-template<class K>
-HT<Key, T>::mapped_type& HT<Key,T>::_lookup(K&& key) {
-    size_type index {hashFunction(key)};
-    
-    auto pair = exists(key);
-    if(!(pair.second)) {
-        if(size_ >= capacity_) {
-            throw std::length_error("Cant insert element into full hashtable");
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
+void HT<Key, T, Hash, KeyEqual>::moveChain(Node* head) {
+    while(head) {
+        Node* next {head->next};
+        Node*& target {arr_[bucketIndex(hash_(head->value.first), capacity_)]};
+        head->next = target;
+        target = head;
+        head = next;
+    }
+}
+
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
+void HT<Key, T, Hash, KeyEqual>::migrate(size_type buckets) {
+    size_type empty_visits {buckets * 10};
+    while(buckets > 0 && migrated_ < old_.size()) {
+        Node* head {std::exchange(old_[migrated_++], nullptr)};
+        if(head) {
+            moveChain(head);
+            --buckets;
+        } else if(--empty_visits == 0) {
+            break;
         }
+    }
+    if(migrated_ == old_.size()) {
+        old_ = Buckets();
+        migrated_ = 0;
+    }
+}
 
-        arr_[index].push_back(std::make_pair(std::forward<K>(key), T()));
-        ++size_;
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
+void HT<Key, T, Hash, KeyEqual>::growIfFull() {
+    if(rehashing()) {
+        migrate(kMigrateBuckets);
+    }
+    if(size_ < capacity_) {
+        return;
+    }
+    // A rehash that did not finish in time gets completed first, so there
+    // are never more than two bucket arrays
+    if(rehashing()) {
+        migrate(old_.size());
+    }
+    old_ = std::exchange(arr_, Buckets(capacity_ < 8 ? 8 : capacity_ * 2));
+    capacity_ = arr_.size();
+    migrate(kMigrateBuckets);
+}
 
-        auto& list = arr_[index];
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
+void HT<Key, T, Hash, KeyEqual>::destroyNodes() noexcept {
+    // The pool frees the slabs in one go, the nodes only need to be visited
+    // if they have a destructor to run
+    if constexpr(!std::is_trivially_destructible_v<Node>) {
+        for(const auto* buckets: {&old_, &arr_}) {
+            for(Node* head: *buckets) {
+                while(head) {
+                    Node* next {head->next};
+                    std::destroy_at(head);
+                    head = next;
+                }
+            }
+        }
+    }
+    pool_.release();
+}
 
-        auto it = list.begin();
-        std::advance(it, list.size() - 1);
-        return (*it).second;
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
+template<class KType, class Type>
+bool HT<Key, T, Hash, KeyEqual>::insertPriv(KType&& key, Type&& val) {
+    growIfFull();
+    size_type hash {hash_(key)};
+    if(findNode(key, hash)) {
+        return false;
     }
-    return *(pair.first);
+
+    newNode(hash, std::forward<KType>(key), std::forward<Type>(val));
+    return true;
 }
 
-template <Hashable Key, MappedConcept T>
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
+template<class K>
+HT<Key, T, Hash, KeyEqual>::mapped_type& HT<Key, T, Hash, KeyEqual>::_lookup(K&& key) {
+    growIfFull();
+    size_type hash {hash_(key)};
+    if(Node* node {findNode(key, hash)}) {
+        return node->value.second;
+    }
+    return newNode(hash, std::forward<K>(key), T())->value.second;
+}
+
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
 template<class KType,class Type>
-bool HT<Key, T>::_insert_or_assign(KType&& key, Type&& val) {
-    auto pair = exists(key);
-    if(pair.second) {
-        *(pair.first) = std::forward<Type>(val);
+bool HT<Key, T, Hash, KeyEqual>::_insert_or_assign(KType&& key, Type&& val) {
+    growIfFull();
+    size_type hash {hash_(key)};
+    if(Node* node {findNode(key, hash)}) {
+        node->value.second = std::forward<Type>(val);
         return false;
-    } else {
-        size_type index {hashFunction(key)};
-        if(size_ >= capacity_) {
-            throw std::length_error("Cant insert element into full hashtable");
-        }
-
-        arr_[index].push_back(std::make_pair(std::forward<KType>( key ), std::forward<Type>(val)));
-        ++size_;
-        return true;
     }
+    newNode(hash, std::forward<KType>(key), std::forward<Type>(val));
+    return true;
 
 }
 
-template <Hashable Key, MappedConcept T>
-void swap(HT<Key, T>& first, HT<Key, T>& second) noexcept {
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
+void swap(HT<Key, T, Hash, KeyEqual>& first, HT<Key, T, Hash, KeyEqual>& second) noexcept {
     using std::swap;
 
     swap(first.arr_, second.arr_);
+    swap(first.old_, second.old_);
+    swap(first.migrated_, second.migrated_);
+    swap(first.pool_, second.pool_);
+    swap(first.hash_, second.hash_);
+    swap(first.equal_, second.equal_);
     swap(first.size_, second.size_);
     swap(first.capacity_, second.capacity_);
 }
 
-template <Hashable Key, MappedConcept T>
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
 template<class Pair>
-bool HT<Key, T>::_emplace(Pair&& pair) {
-    if (exists(pair.first).second) {
+bool HT<Key, T, Hash, KeyEqual>::_emplace(Pair&& pair) {
+    growIfFull();
+    size_type hash {hash_(pair.first)};
+    if(findNode(pair.first, hash)) {
         return false;
     }
-    if(size_ >= capacity_) {
-        throw std::length_error("Cant insert element into full hashtable");
-    }
-    size_type index {hashFunction(pair.first)};
-    arr_[index].push_back(std::forward<Pair>(pair));
-    ++size_;
+    newNode(hash, std::forward<Pair>(pair));
     return true;
 }
 
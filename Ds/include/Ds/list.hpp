@@ -2,6 +2,8 @@
 #define LIST_CLASS_HPP
 
 #include "concepts.hpp"
+#include "nodepool.hpp"
+#include "skipindex.hpp"
 
 #include <cstddef>
 #include <memory>
@@ -10,12 +12,24 @@
 #include <type_traits>
 #include <functional>
 #include <algorithm>
+#include <array>
+#include <limits>
+#include <utility>
 
 
 namespace ds{
 
 
-template<class T, class Allocator = std::allocator<T>>
+// Doubly linked list. With 'Pooled' the nodes come from a NodePool owned by
+// the list instead of 'Allocator': nodes get carved out of cache line
+// aligned slabs, so a list built by push_back sits mostly sequential in
+// memory, erased nodes get reused, and clear() and the destructor free all
+// slabs at once instead of deallocating node by node.
+// With 'Indexed' the list keeps a SkipIndex over its nodes, so operator[],
+// nth() and index_of() take expected O(log n) instead of a walk from one
+// end. Inserts and erases update it in O(log n), sort(), merge() and
+// reverse() relink every node and rebuild it in one pass.
+template<class T, class Allocator = std::allocator<T>, bool Pooled = false, bool Indexed = false>
 class List {
 private:
     class Node;
@@ -95,12 +109,16 @@ public:
     void swap(List& other);
 
     // Operation functions
+    // Merging takes two sorted lists and relinks the nodes in linear time,
+    // elements of '*this' stay in front of equal elements of 'other'
     void merge(const List& other);
     void merge(List&& other);
     template<class Compare>
     void merge(const List& other, Compare comp);
     template<class Compare>
     void merge(List&& other, Compare comp);
+    // Stable bottom up merge sort, relinks the nodes without moving or
+    // allocating elements
     template<class Compare=std::less<T>>
     void sort(Compare comp=Compare{});
     void unique();
@@ -110,27 +128,35 @@ public:
     size_type remove_if(UnaryPredicate p);
     
 
-    // Random access specifiers(Even if access time is terrible)
+    // Random access specifiers(Even if access time is terrible, unless the
+    // list is Indexed)
     reference operator[](const size_type index);
     const_reference operator[](const size_type index) const;
+    iterator nth(const size_type index) const noexcept;
+    size_type index_of(iterator pos) const noexcept;
     reference front();
     const_reference front() const;
     reference back();
     const_reference back() const;
         
     //assignment operator
-    List<T, Allocator>& operator=(const List& other);
-    List<T, Allocator>& operator=(List&& other) noexcept;
-    List<T, Allocator>& operator=(std::initializer_list<T> iList);
+    List<T, Allocator, Pooled, Indexed>& operator=(const List& other);
+    List<T, Allocator, Pooled, Indexed>& operator=(List&& other) noexcept;
+    List<T, Allocator, Pooled, Indexed>& operator=(std::initializer_list<T> iList);
 
 
     // Get allocator
     constexpr allocator_type get_allocator() const noexcept;
 private:
+    struct NoPool {};
+    struct NoIndex {};
+
     Node* head_;
     Node* tail_;
     allocator_type_internal alloc_;
     size_type size_;
+    [[no_unique_address]] std::conditional_t<Pooled, NodePool<Node>, NoPool> pool_ {};
+    [[no_unique_address]] std::conditional_t<Indexed, SkipIndex<Node>, NoIndex> skip_index_ {};
 
 private:
     void destroyAndDealloc();
@@ -146,18 +172,28 @@ private:
 
     Node* getNewNode(const value_type& value, Node* head=nullptr, Node* tail=nullptr);
 
+    // Merges the sorted chain 'second' into the sorted chain 'first', both
+    // only linked through next_. If 'comp' throws every node still ends up
+    // in 'first', unsorted.
+    template<class Compare>
+    static void mergeRuns(Node*& first, Node*& second, Compare& comp);
+    // Makes the chain starting at 'first' the list again, fixes prev_ and tail_
+    void relink(Node* first) noexcept;
+    // Walks from the closer end, or asks the index
+    Node* nodeAt(size_type index) const noexcept;
+
 };
 
 
-template<class T, class Allocator>
-List<T, Allocator>::List(): size_ {0}, head_ {nullptr}, tail_ {nullptr}  {}
+template<class T, class Allocator, bool Pooled, bool Indexed>
+List<T, Allocator, Pooled, Indexed>::List(): size_ {0}, head_ {nullptr}, tail_ {nullptr}  {}
 
-template<class T, class Allocator>
-List<T, Allocator>::List(const Allocator& alloc): size_ {0}, alloc_ {alloc}, head_ {nullptr}, tail_ {nullptr} {}
+template<class T, class Allocator, bool Pooled, bool Indexed>
+List<T, Allocator, Pooled, Indexed>::List(const Allocator& alloc): size_ {0}, alloc_ {alloc}, head_ {nullptr}, tail_ {nullptr} {}
 
 // Set size_ to 0 because it gets increased in the append function
-template<class T, class Allocator>
-List<T, Allocator>::List(size_type count, const T& value, const Allocator& alloc)
+template<class T, class Allocator, bool Pooled, bool Indexed>
+List<T, Allocator, Pooled, Indexed>::List(size_type count, const T& value, const Allocator& alloc)
     : size_ {0}
     , alloc_ {alloc}
     , tail_ {nullptr}
@@ -169,8 +205,8 @@ List<T, Allocator>::List(size_type count, const T& value, const Allocator& alloc
 }
 
 // Set size_ to 0 because it gets increased in the append function
-template<class T, class Allocator>
-List<T, Allocator>::List(std::initializer_list<T> iList, const Allocator& alloc)
+template<class T, class Allocator, bool Pooled, bool Indexed>
+List<T, Allocator, Pooled, Indexed>::List(std::initializer_list<T> iList, const Allocator& alloc)
     : size_{0}
     , alloc_ {alloc}
     , tail_ {nullptr}
@@ -181,10 +217,10 @@ List<T, Allocator>::List(std::initializer_list<T> iList, const Allocator& alloc)
     }
 }
 
-template<class T, class Allocator>
+template<class T, class Allocator, bool Pooled, bool Indexed>
 template<class InputIt>
 requires is_it<InputIt>
-List<T, Allocator>::List(InputIt first, InputIt last, const Allocator& alloc)
+List<T, Allocator, Pooled, Indexed>::List(InputIt first, InputIt last, const Allocator& alloc)
     : size_{0}
     , alloc_ {alloc}
     , tail_ {nullptr}
@@ -195,8 +231,8 @@ List<T, Allocator>::List(InputIt first, InputIt last, const Allocator& alloc)
     }
 }
 
-template<class T, class Allocator>
-List<T, Allocator>::List(const List& other)
+template<class T, class Allocator, bool Pooled, bool Indexed>
+List<T, Allocator, Pooled, Indexed>::List(const List& other)
     : size_{0}
     , alloc_ {std::allocator_traits<allocator_type>::select_on_container_copy_construction(other.get_allocator())}
     , tail_ {nullptr}
@@ -207,8 +243,8 @@ List<T, Allocator>::List(const List& other)
     }
 }
 
-template<class T, class Allocator>
-List<T, Allocator>::List(const List& other, const Allocator& alloc)
+template<class T, class Allocator, bool Pooled, bool Indexed>
+List<T, Allocator, Pooled, Indexed>::List(const List& other, const Allocator& alloc)
     : size_{0}
     , alloc_ {alloc}
     , tail_ {nullptr}
@@ -219,24 +255,28 @@ List<T, Allocator>::List(const List& other, const Allocator& alloc)
     }
 }
 
-template <class T, class Allocator>
-List<T, Allocator>::List(List&& other)
+template <class T, class Allocator, bool Pooled, bool Indexed>
+List<T, Allocator, Pooled, Indexed>::List(List&& other)
     : size_{other.size_}
     , alloc_ {std::allocator_traits<allocator_type>::select_on_container_copy_construction(other.get_allocator())}
     , tail_ {other.tail_}
     , head_ {other.head_}
+    , pool_ {std::move(other.pool_)}
+    , skip_index_ {std::move(other.skip_index_)}
 {
     other.size_ = 0;
     other.head_ = nullptr;
     other.tail_ = nullptr;
 }
 
-template <class T, class Allocator>
-List<T, Allocator>::List(List&& other, const Allocator& alloc)
+template <class T, class Allocator, bool Pooled, bool Indexed>
+List<T, Allocator, Pooled, Indexed>::List(List&& other, const Allocator& alloc)
     : size_{other.size_}
     , alloc_ {alloc}
     , tail_ {other.tail_}
     , head_ {other.head_}
+    , pool_ {std::move(other.pool_)}
+    , skip_index_ {std::move(other.skip_index_)}
 {
     other.size_ = 0;
     other.head_ = nullptr;
@@ -245,13 +285,13 @@ List<T, Allocator>::List(List&& other, const Allocator& alloc)
 
 
 
-template<class T, class Allocator>
-List<T, Allocator>::~List() {
+template<class T, class Allocator, bool Pooled, bool Indexed>
+List<T, Allocator, Pooled, Indexed>::~List() {
     destroyAndDealloc();
 }
 
-template<class T, class Allocator>
-class List<T, Allocator>::Iterator {
+template<class T, class Allocator, bool Pooled, bool Indexed>
+class List<T, Allocator, Pooled, Indexed>::Iterator {
 public:
     using iterator_category = std::forward_iterator_tag;
     using difference_type   = std::ptrdiff_t;
@@ -271,7 +311,7 @@ public:
     Iterator& operator++() { ptr_=ptr_->next_; return *this; }  
 
     // Postfix increment
-    Iterator operator++(T) { Iterator tmp = *this; ++(*this); return tmp; }
+    Iterator operator++(int) { Iterator tmp = *this; ++(*this); return tmp; }
 
     friend bool operator== (const Iterator& a, const Iterator& b) { return a.ptr_ == b.ptr_; };
     friend bool operator!= (const Iterator& a, const Iterator& b) { return a.ptr_ != b.ptr_; };
@@ -281,8 +321,26 @@ private:
     friend class List;
 };
 
-template<class T, class Allocator>
-void List<T, Allocator>::destroyAndDealloc() {
+template<class T, class Allocator, bool Pooled, bool Indexed>
+void List<T, Allocator, Pooled, Indexed>::destroyAndDealloc() {
+    if constexpr(Indexed) {
+        skip_index_.clear();
+    }
+    if constexpr(Pooled) {
+        // The slabs go back as a whole, only the elements need their destructor
+        if constexpr(!std::is_trivially_destructible_v<T>) {
+            Node* node {head_};
+            while(node) {
+                Node* next_node {node->next_};
+                std::destroy_at(node);
+                node = next_node;
+            }
+        }
+        pool_.release();
+        head_ = tail_ = nullptr;
+        size_ = 0;
+        return;
+    }
     if(!tail_) return;
     Node* node_to_delete {tail_};
     Node* next_node {};
@@ -296,95 +354,100 @@ void List<T, Allocator>::destroyAndDealloc() {
     size_ = 0;
 }
 
-template<class T, class Allocator>
-void List<T, Allocator>::deallocNode(Node* node_to_delete) {
-    traits_t_i::destroy(alloc_, node_to_delete);
-    traits_t_i::deallocate(alloc_, node_to_delete, 1);
+template<class T, class Allocator, bool Pooled, bool Indexed>
+void List<T, Allocator, Pooled, Indexed>::deallocNode(Node* node_to_delete) {
+    if constexpr(Pooled) {
+        std::destroy_at(node_to_delete);
+        pool_.deallocate(node_to_delete);
+    } else {
+        traits_t_i::destroy(alloc_, node_to_delete);
+        traits_t_i::deallocate(alloc_, node_to_delete, 1);
+    }
 }
 
-template<class T, class Allocator>
-constexpr List<T, Allocator>::size_type List<T, Allocator>::size() const noexcept {
+template<class T, class Allocator, bool Pooled, bool Indexed>
+constexpr List<T, Allocator, Pooled, Indexed>::size_type List<T, Allocator, Pooled, Indexed>::size() const noexcept {
     return size_;
 }
 
-template<class T, class Allocator>
-constexpr bool List<T, Allocator>::empty() const noexcept {
+template<class T, class Allocator, bool Pooled, bool Indexed>
+constexpr bool List<T, Allocator, Pooled, Indexed>::empty() const noexcept {
     return (size_ == 0);
 }
 
-template<class T, class Allocator>
-void List<T, Allocator>::assign(size_type count, const T& value) {
+template<class T, class Allocator, bool Pooled, bool Indexed>
+void List<T, Allocator, Pooled, Indexed>::assign(size_type count, const T& value) {
     destroyAndDealloc();
     for(size_type i {0}; i < count; ++i) {
         append(value);
     }
 }
 
-template<class T, class Allocator>
+template<class T, class Allocator, bool Pooled, bool Indexed>
 template<class InputIt>
 requires is_it<InputIt>
-void List<T, Allocator>::assign(InputIt first, InputIt last) {
+void List<T, Allocator, Pooled, Indexed>::assign(InputIt first, InputIt last) {
     destroyAndDealloc();
     for(auto it=first; it != last; ++it) {
         append(*it);
     }
 }
 
-template<class T, class Allocator>
-void List<T, Allocator>::assign(std::initializer_list<T> iList) {
+template<class T, class Allocator, bool Pooled, bool Indexed>
+void List<T, Allocator, Pooled, Indexed>::assign(std::initializer_list<T> iList) {
     destroyAndDealloc();
     for(const auto& value: iList) {
         append(value);
     }
 }
 
-template<class T, class Allocator>
-List<T, Allocator>::iterator List<T, Allocator>::begin() noexcept {
+template<class T, class Allocator, bool Pooled, bool Indexed>
+List<T, Allocator, Pooled, Indexed>::iterator List<T, Allocator, Pooled, Indexed>::begin() noexcept {
     return Iterator(head_);
 }
 
-template<class T, class Allocator>
-List<T, Allocator>::iterator List<T, Allocator>::begin() const noexcept {
+template<class T, class Allocator, bool Pooled, bool Indexed>
+List<T, Allocator, Pooled, Indexed>::iterator List<T, Allocator, Pooled, Indexed>::begin() const noexcept {
     return Iterator(head_);
 }
 
-template<class T, class Allocator>
-List<T, Allocator>::iterator List<T, Allocator>::end() noexcept {
+template<class T, class Allocator, bool Pooled, bool Indexed>
+List<T, Allocator, Pooled, Indexed>::iterator List<T, Allocator, Pooled, Indexed>::end() noexcept {
     return Iterator(nullptr);
 }
 
-template<class T, class Allocator>
-List<T, Allocator>::iterator List<T, Allocator>::end() const noexcept {
+template<class T, class Allocator, bool Pooled, bool Indexed>
+List<T, Allocator, Pooled, Indexed>::iterator List<T, Allocator, Pooled, Indexed>::end() const noexcept {
     return Iterator(nullptr);
 }
 
-template<class T, class Allocator>
-void List<T, Allocator>::push_back(const T& value) {
+template<class T, class Allocator, bool Pooled, bool Indexed>
+void List<T, Allocator, Pooled, Indexed>::push_back(const T& value) {
     append(value);
 }
 
-template<class T, class Allocator>
-void List<T, Allocator>::push_back(T&& value) {
+template<class T, class Allocator, bool Pooled, bool Indexed>
+void List<T, Allocator, Pooled, Indexed>::push_back(T&& value) {
     append(std::move(value));
 }
 
-template<class T, class Allocator>
-void List<T, Allocator>::clear() noexcept {
+template<class T, class Allocator, bool Pooled, bool Indexed>
+void List<T, Allocator, Pooled, Indexed>::clear() noexcept {
     destroyAndDealloc();
 }
 
-template<class T, class Allocator>
-List<T, Allocator>::iterator List<T, Allocator>::insert(iterator pos, const T& value) {
+template<class T, class Allocator, bool Pooled, bool Indexed>
+List<T, Allocator, Pooled, Indexed>::iterator List<T, Allocator, Pooled, Indexed>::insert(iterator pos, const T& value) {
     return insertAtPos(pos, value);
 }
 
-template<class T, class Allocator>
-List<T, Allocator>::iterator List<T, Allocator>::insert(iterator pos, T&& value) {
+template<class T, class Allocator, bool Pooled, bool Indexed>
+List<T, Allocator, Pooled, Indexed>::iterator List<T, Allocator, Pooled, Indexed>::insert(iterator pos, T&& value) {
     return insertAtPos(pos, std::move(value));
 }
 
-template<class T, class Allocator>
-List<T, Allocator>::iterator List<T, Allocator>::insert( iterator pos, size_type count, const T& value ) {
+template<class T, class Allocator, bool Pooled, bool Indexed>
+List<T, Allocator, Pooled, Indexed>::iterator List<T, Allocator, Pooled, Indexed>::insert( iterator pos, size_type count, const T& value ) {
     if (count == 0) {
         return pos;
     }
@@ -396,10 +459,10 @@ List<T, Allocator>::iterator List<T, Allocator>::insert( iterator pos, size_type
     }
     return return_it;
 }
-template<class T, class Allocator>
+template<class T, class Allocator, bool Pooled, bool Indexed>
 template<class InputIt>
 requires is_it<InputIt>
-List<T, Allocator>::iterator List<T, Allocator>::insert(iterator pos, InputIt first, InputIt last) {
+List<T, Allocator, Pooled, Indexed>::iterator List<T, Allocator, Pooled, Indexed>::insert(iterator pos, InputIt first, InputIt last) {
     if (first == last) {
         return pos;
     }
@@ -412,8 +475,8 @@ List<T, Allocator>::iterator List<T, Allocator>::insert(iterator pos, InputIt fi
     return return_it;
 }
 
-template<class T, class Allocator>
-List<T, Allocator>::iterator List<T, Allocator>::insert(iterator pos, std::initializer_list<T> iList) {
+template<class T, class Allocator, bool Pooled, bool Indexed>
+List<T, Allocator, Pooled, Indexed>::iterator List<T, Allocator, Pooled, Indexed>::insert(iterator pos, std::initializer_list<T> iList) {
     Iterator it;
     for(int i{0};const auto& value: iList) {
        if (i == 0) {
@@ -426,30 +489,35 @@ List<T, Allocator>::iterator List<T, Allocator>::insert(iterator pos, std::initi
     return it;
 }
 
-template<class T, class Allocator>
+template<class T, class Allocator, bool Pooled, bool Indexed>
 template<class... Args>
-List<T, Allocator>::iterator List<T, Allocator>::emplace(iterator pos, Args&&... args) {
+List<T, Allocator, Pooled, Indexed>::iterator List<T, Allocator, Pooled, Indexed>::emplace(iterator pos, Args&&... args) {
     return insertAtPos(pos, value_type(std::forward<Args>(args)...));
 }
 
-template<class T, class Allocator>
+template<class T, class Allocator, bool Pooled, bool Indexed>
 template<class... Args>
-List<T, Allocator>::reference List<T, Allocator>::emplace_back(Args&&... args) {
+List<T, Allocator, Pooled, Indexed>::reference List<T, Allocator, Pooled, Indexed>::emplace_back(Args&&... args) {
     append(value_type(std::forward<Args>(args)...));
     return tail_->data_;
 }
 
-template<class T, class Allocator>
+template<class T, class Allocator, bool Pooled, bool Indexed>
 template<class... Args>
-List<T, Allocator>::reference List<T, Allocator>::emplace_front(Args&&... args) {
+List<T, Allocator, Pooled, Indexed>::reference List<T, Allocator, Pooled, Indexed>::emplace_front(Args&&... args) {
     insertAtFront(value_type(std::forward<Args>(args)...));
     return head_->data_;
 }
 
 
 
-template<class T, class Allocator>
-List<T, Allocator>::iterator List<T, Allocator>::erase(iterator pos) {
+template<class T, class Allocator, bool Pooled, bool Indexed>
+List<T, Allocator, Pooled, Indexed>::iterator List<T, Allocator, Pooled, Indexed>::erase(iterator pos) {
+    if constexpr(Indexed) {
+        if(pos.ptr_) {
+            skip_index_.erase(pos.ptr_, skip_index_.indexOf(pos.ptr_, size_));
+        }
+    }
     Node* temp {pos.ptr_};
     Node* pointer_to_return {nullptr};
     if((pos==begin()) && (pos == end())) {
@@ -475,8 +543,15 @@ List<T, Allocator>::iterator List<T, Allocator>::erase(iterator pos) {
     return iterator(pointer_to_return);
 }
 
-template<class T, class Allocator>
-List<T, Allocator>::iterator List<T, Allocator>::erase(iterator first, iterator last) {
+template<class T, class Allocator, bool Pooled, bool Indexed>
+List<T, Allocator, Pooled, Indexed>::iterator List<T, Allocator, Pooled, Indexed>::erase(iterator first, iterator last) {
+    if constexpr(Indexed) {
+        // Every node has to leave the index one by one
+        while(first != last) {
+            first = erase(first);
+        }
+        return last;
+    }
     Node* pointer_to_return {nullptr};
 
     size_type num_deleted_nodes = std::distance(first, last);
@@ -517,9 +592,12 @@ List<T, Allocator>::iterator List<T, Allocator>::erase(iterator first, iterator
     return iterator(pointer_to_return);
 }
 
-template<class T, class Allocator>
-void List<T, Allocator>::pop_back() {
+template<class T, class Allocator, bool Pooled, bool Indexed>
+void List<T, Allocator, Pooled, Indexed>::pop_back() {
     if(!tail_) {return;}
+    if constexpr(Indexed) {
+        skip_index_.erase(tail_, size_ - 1);
+    }
     --size_;
     if(tail_ == head_) {
         deallocNode(tail_);
@@ -531,19 +609,22 @@ void List<T, Allocator>::pop_back() {
     tail_->next_ = nullptr;
 }
 
-template<class T, class Allocator>
-void List<T, Allocator>::push_front(const T& value) {
+template<class T, class Allocator, bool Pooled, bool Indexed>
+void List<T, Allocator, Pooled, Indexed>::push_front(const T& value) {
    insertAtFront(value); 
 }
 
-template<class T, class Allocator>
-void List<T, Allocator>::push_front(T&& value) {
+template<class T, class Allocator, bool Pooled, bool Indexed>
+void List<T, Allocator, Pooled, Indexed>::push_front(T&& value) {
    insertAtFront(std::move(value)); 
 }
 
-template<class T, class Allocator>
-void List<T, Allocator>::pop_front() {
+template<class T, class Allocator, bool Pooled, bool Indexed>
+void List<T, Allocator, Pooled, Indexed>::pop_front() {
     if(!head_) {return;}
+    if constexpr(Indexed) {
+        skip_index_.erase(head_, 0);
+    }
     --size_;
     if(tail_ == head_) {
         deallocNode(head_);
@@ -556,14 +637,17 @@ void List<T, Allocator>::pop_front() {
     head_->prev_ = nullptr;
 }
 
-template<class T, class Allocator>
-void List<T, Allocator>::resize(size_type count, const T& value) {
+template<class T, class Allocator, bool Pooled, bool Indexed>
+void List<T, Allocator, Pooled, Indexed>::resize(size_type count, const T& value) {
     if(size_ == count) {return;}
     if(count < size_) {
         Node* temp {tail_};
         Node* prev_temp {temp};
         for(size_type i {size_}; i > count; --i) {
             prev_temp = temp->prev_;
+            if constexpr(Indexed) {
+                skip_index_.erase(temp, i - 1);
+            }
             deallocNode(temp);
             temp = prev_temp;
         }
@@ -577,8 +661,8 @@ void List<T, Allocator>::resize(size_type count, const T& value) {
     }
 }
 
-template<class T, class Allocator>
-void List<T, Allocator>::swap(List& other) {
+template<class T, class Allocator, bool Pooled, bool Indexed>
+void List<T, Allocator, Pooled, Indexed>::swap(List& other) {
     Node* temp_head {head_};
     Node* temp_tail {tail_};
     size_type temp_size {size_};
@@ -590,100 +674,131 @@ void List<T, Allocator>::swap(List& other) {
     other.head_ = temp_head;
     other.tail_ = temp_tail;
     other.size_ = temp_size;
-}
-
-// Operation functions
 
-template<class T, class Allocator>
-void List<T, Allocator>::merge(const List& other) {
-    if(&other == this) {
-        return;
+    using std::swap;
+    if constexpr(Pooled) {
+        swap(pool_, other.pool_);
     }
-    
-    for(auto it=other.begin(); it != other.end(); ++it) {
-       append(*it);
+    if constexpr(Indexed) {
+        swap(skip_index_, other.skip_index_);
     }
 }
 
-template<class T, class Allocator>
-void List<T, Allocator>::merge(List&& other) {
-    if(&other == this) {
-        return;
-    }
-    
-    tail_->next_ = other.head_;
-    other.head_->prev_ = tail_;
-    tail_ = other.tail_;
-    size_ += other.size_;
+// Operation functions
 
-    other.head_ = other.tail_ = nullptr;
-    other.size_ = 0;
+template<class T, class Allocator, bool Pooled, bool Indexed>
+void List<T, Allocator, Pooled, Indexed>::merge(const List& other) {
+    merge(other, std::less<T>{});
+}
+
+template<class T, class Allocator, bool Pooled, bool Indexed>
+void List<T, Allocator, Pooled, Indexed>::merge(List&& other) {
+    merge(std::move(other), std::less<T>{});
 }
 
-template<class T, class Allocator>
+template<class T, class Allocator, bool Pooled, bool Indexed>
 template<class Compare>
-void List<T, Allocator>::merge(const List& other, Compare comp) {
+void List<T, Allocator, Pooled, Indexed>::merge(const List& other, Compare comp) {
     if(&other == this) {
         return;
     }
-    
-    for(auto it=other.begin(); it != other.end(); ++it) {
-       append(*it);
-    }
-
-    sort(comp);
-     
+    List copy(other);
+    merge(std::move(copy), comp);
 }
 
-template<class T, class Allocator>
+template<class T, class Allocator, bool Pooled, bool Indexed>
 template<class Compare>
-void List<T, Allocator>::merge(List&& other, Compare comp) {
-    if(&other == this) {
+void List<T, Allocator, Pooled, Indexed>::merge(List&& other, Compare comp) {
+    if(&other == this || !other.head_) {
         return;
     }
-    
-    tail_->next_ = other.head_;
-    other.head_->prev_ = tail_;
-    tail_ = other.tail_;
+    if constexpr(Pooled) {
+        // The nodes of 'other' live in its slabs
+        pool_.adopt(other.pool_);
+    }
+    Node* merged {head_};
+    Node* theirs {other.head_};
     size_ += other.size_;
-
     other.head_ = other.tail_ = nullptr;
     other.size_ = 0;
-
-    sort(comp);
-    
+    if constexpr(Indexed) {
+        // relink() rebuilds the index over the nodes of both lists
+        other.skip_index_.clear();
+    }
+    try {
+        mergeRuns(merged, theirs, comp);
+    } catch(...) {
+        relink(merged);
+        throw;
+    }
+    relink(merged);
 }
 
-template<class T, class Allocator>
+template<class T, class Allocator, bool Pooled, bool Indexed>
 template<class Compare>
-void List<T, Allocator>::sort(Compare comp) {
+void List<T, Allocator, Pooled, Indexed>::sort(Compare comp) {
     if(size_ <= 1) {
         return;
     }
-    Node* curr {head_};
-    while(curr->next_) {
-        Node* index {curr->next_};
-        while(index) {
-            if(comp(index->data_, curr->data_)) {
-                T tmp { std::move(curr->data_) }; 
-                curr->data_ = std::move(index->data_); 
-                index->data_ = std::move(tmp); 
+    // bins[i] is empty or holds a sorted run of 2^i nodes, like the digits
+    // of a binary counter. Earlier nodes sit in higher bins.
+    std::array<Node*, std::numeric_limits<size_type>::digits + 1> bins {};
+    size_type used {0};
+    Node* rest {head_};
+    Node* carry {nullptr};
+    try {
+        while(rest) {
+            carry = rest;
+            rest = rest->next_;
+            carry->next_ = nullptr;
+            size_type i {0};
+            for(; i < used && bins[i]; ++i) {
+                mergeRuns(bins[i], carry, comp);
+                carry = std::exchange(bins[i], nullptr);
             }
-            index = index->next_;
-
+            bins[i] = std::exchange(carry, nullptr);
+            used = std::max(used, i + 1);
         }
-        curr = curr->next_;
+        for(size_type i {0}; i < used; ++i) {
+            if(bins[i]) {
+                mergeRuns(bins[i], carry, comp);
+                carry = std::exchange(bins[i], nullptr);
+            }
+        }
+    } catch(...) {
+        // Every node is still in a bin, in 'carry' or in 'rest'
+        for(Node* run: bins) {
+            if(run) {
+                Node* last {run};
+                while(last->next_) {
+                    last = last->next_;
+                }
+                last->next_ = carry;
+                carry = run;
+            }
+        }
+        if(carry) {
+            Node* last {carry};
+            while(last->next_) {
+                last = last->next_;
+            }
+            last->next_ = rest;
+            rest = carry;
+        }
+        relink(rest);
+        throw;
     }
+    relink(carry);
 }
 
-template<class T, class Allocator>
-void List<T, Allocator>::unique() {
+template<class T, class Allocator, bool Pooled, bool Indexed>
+void List<T, Allocator, Pooled, Indexed>::unique() {
     ds::List<T> sorted_list {std::move(*this)};
     sorted_list.sort();
 }
 
-template<class T, class Allocator>
-void List<T, Allocator>::reverse() noexcept {
+template<class T, class Allocator, bool Pooled, bool Indexed>
+void List<T, Allocator, Pooled, Indexed>::reverse() noexcept {
     Node* temp {nullptr};
     Node* current {head_};
 
@@ -701,10 +816,13 @@ void List<T, Allocator>::reverse() noexcept {
         head_ = tail_;
         tail_ = temp;
     }
+    if constexpr(Indexed) {
+        skip_index_.rebuild(head_, size_);
+    }
 }
 
-template<class T, class Allocator>
-List<T, Allocator>::size_type List<T, Allocator>::remove(const T& value) {
+template<class T, class Allocator, bool Pooled, bool Indexed>
+List<T, Allocator, Pooled, Indexed>::size_type List<T, Allocator, Pooled, Indexed>::remove(const T& value) {
     Node* temp {head_};
     Node* next_node {nullptr};
     size_type deleted_nodes {0};
@@ -719,9 +837,9 @@ List<T, Allocator>::size_type List<T, Allocator>::remove(const T& value) {
     return deleted_nodes;
 }
 
-template<class T, class Allocator>
+template<class T, class Allocator, bool Pooled, bool Indexed>
 template<class UnaryPredicate>
-List<T, Allocator>::size_type List<T, Allocator>::remove_if(UnaryPredicate p) {
+List<T, Allocator, Pooled, Indexed>::size_type List<T, Allocator, Pooled, Indexed>::remove_if(UnaryPredicate p) {
     Node* temp {head_};
     Node* next_node {nullptr};
     size_type deleted_nodes {0};
@@ -736,75 +854,74 @@ List<T, Allocator>::size_type List<T, Allocator>::remove_if(UnaryPredicate p) {
     return deleted_nodes;
 }
 
-template<class T, class Allocator>
-List<T, Allocator>::reference List<T, Allocator>::operator[](const size_type index) {
-    if(index >= size_/2) {
-        Node* temp {tail_};
-        for(size_type i {size_- 1}; i != index; --i) {
-            temp = temp->prev_;
-        }
-        return temp->data_;
-    } else {
-        Node* temp {head_};
-        for(size_type i {0}; i != index; ++i) {
-            temp = temp->next_;
-        }
-        return temp->data_;
+template<class T, class Allocator, bool Pooled, bool Indexed>
+List<T, Allocator, Pooled, Indexed>::reference List<T, Allocator, Pooled, Indexed>::operator[](const size_type index) {
+    return nodeAt(index)->data_;
+}
+
+template<class T, class Allocator, bool Pooled, bool Indexed>
+List<T, Allocator, Pooled, Indexed>::const_reference List<T, Allocator, Pooled, Indexed>::operator[](const size_type index) const {
+    return nodeAt(index)->data_;
+}
 
+// nth(size()) is end()
+template<class T, class Allocator, bool Pooled, bool Indexed>
+List<T, Allocator, Pooled, Indexed>::iterator List<T, Allocator, Pooled, Indexed>::nth(const size_type index) const noexcept {
+    if(index >= size_) {
+        return Iterator(nullptr);
     }
+    return Iterator(nodeAt(index));
 }
 
-template<class T, class Allocator>
-List<T, Allocator>::const_reference List<T, Allocator>::operator[](const size_type index) const {
-    if(index >= size_/2) {
-        Node* temp {tail_};
-        for(size_type i {size_ - 1}; i != index; --i) {
-            temp = temp->prev_;
-        }
-        return temp->data_;
+template<class T, class Allocator, bool Pooled, bool Indexed>
+List<T, Allocator, Pooled, Indexed>::size_type List<T, Allocator, Pooled, Indexed>::index_of(iterator pos) const noexcept {
+    if constexpr(Indexed) {
+        return skip_index_.indexOf(pos.ptr_, size_);
     } else {
-        Node* temp {head_};
-        for(size_type i {0}; i != index; ++i) {
-            temp = temp->next_;
+        size_type index {0};
+        for(Node* node {head_}; node != pos.ptr_; node = node->next_) {
+            ++index;
         }
-        return temp->data_;
-
+        return index;
     }
 }
 
-template<class T, class Allocator>
-List<T, Allocator>::reference List<T, Allocator>::front() {
+template<class T, class Allocator, bool Pooled, bool Indexed>
+List<T, Allocator, Pooled, Indexed>::reference List<T, Allocator, Pooled, Indexed>::front() {
     return head_->data_;
 }
 
-template<class T, class Allocator>
-List<T, Allocator>::const_reference List<T, Allocator>::front() const {
+template<class T, class Allocator, bool Pooled, bool Indexed>
+List<T, Allocator, Pooled, Indexed>::const_reference List<T, Allocator, Pooled, Indexed>::front() const {
     return head_->data_;
 }
 
-template<class T, class Allocator>
-List<T, Allocator>::reference List<T, Allocator>::back() {
+template<class T, class Allocator, bool Pooled, bool Indexed>
+List<T, Allocator, Pooled, Indexed>::reference List<T, Allocator, Pooled, Indexed>::back() {
     return tail_->data_;
 }
 
-template<class T, class Allocator>
-List<T, Allocator>::const_reference List<T, Allocator>::back() const {
+template<class T, class Allocator, bool Pooled, bool Indexed>
+List<T, Allocator, Pooled, Indexed>::const_reference List<T, Allocator, Pooled, Indexed>::back() const {
     return tail_->data_;
 }
 
-template<class T, class Allocator>
-List<T, Allocator>& List<T, Allocator>::operator=(const List& other) {
-    alloc_ = std::allocator_traits<allocator_type>::select_on_container_copy_construction(other.get_allocator());
-    size_ = other.size_;
+template<class T, class Allocator, bool Pooled, bool Indexed>
+List<T, Allocator, Pooled, Indexed>& List<T, Allocator, Pooled, Indexed>::operator=(const List& other) {
+    if(this == &other) {
+        return *this;
+    }
+    // append counts size_ up, the skip index relies on it
     destroyAndDealloc();
+    alloc_ = std::allocator_traits<allocator_type>::select_on_container_copy_construction(other.get_allocator());
     for(auto it=other.begin(); it != other.end(); ++it) {
         append(*it);
     }
     return *this;
 }
 
-template<class T, class Allocator>
-List<T, Allocator>& List<T, Allocator>::operator=(List&& other) noexcept {
+template<class T, class Allocator, bool Pooled, bool Indexed>
+List<T, Allocator, Pooled, Indexed>& List<T, Allocator, Pooled, Indexed>::operator=(List&& other) noexcept {
     alloc_ = std::allocator_traits<allocator_type>::select_on_container_copy_construction(other.get_allocator());
     destroyAndDealloc();
 
@@ -815,12 +932,18 @@ List<T, Allocator>& List<T, Allocator>::operator=(List&& other) noexcept {
     tail_ = other.tail_;
     other.head_ = nullptr;
     other.tail_ = nullptr;
+    if constexpr(Pooled) {
+        pool_ = std::move(other.pool_);
+    }
+    if constexpr(Indexed) {
+        skip_index_ = std::move(other.skip_index_);
+    }
 
     return *this;
 }
 
-template<class T, class Allocator>
-List<T, Allocator>& List<T, Allocator>::operator=(std::initializer_list<T> iList) {
+template<class T, class Allocator, bool Pooled, bool Indexed>
+List<T, Allocator, Pooled, Indexed>& List<T, Allocator, Pooled, Indexed>::operator=(std::initializer_list<T> iList) {
     destroyAndDealloc();
     for(const auto& value: iList) {
         append(value);
@@ -828,38 +951,48 @@ List<T, Allocator>& List<T, Allocator>::operator=(std::initializer_list<T> iList
     return *this;
 }
 
-template<class T, class Allocator>
+template<class T, class Allocator, bool Pooled, bool Indexed>
 template<class Type>
-void List<T, Allocator>::append(Type&& value) {
+void List<T, Allocator, Pooled, Indexed>::append(Type&& value) {
     Node* new_node {getNewNode(std::forward<Type>(value))};
     ++size_;
     if(!tail_) {
         tail_ = head_ = new_node;
-        return;
+    } else {
+        tail_->next_ = new_node;
+        new_node->prev_ = tail_;
+        tail_ = new_node;
+    }
+    if constexpr(Indexed) {
+        skip_index_.insert(new_node, size_ - 1, size_);
     }
-    tail_->next_ = new_node;
-    new_node->prev_ = tail_;
-    tail_ = new_node;
 }
 
-template<class T, class Allocator>
+template<class T, class Allocator, bool Pooled, bool Indexed>
 template<class Type>
-void List<T, Allocator>::insertAtFront(Type&& value) {
+void List<T, Allocator, Pooled, Indexed>::insertAtFront(Type&& value) {
     Node* new_node {getNewNode(std::forward<Type>(value))};
     ++size_;
     if(!head_) {
         tail_ = head_ = new_node;
-        return;
+    } else {
+        new_node->next_ = head_; 
+        head_->prev_ = new_node;
+        head_ = new_node;
+    }
+    if constexpr(Indexed) {
+        skip_index_.insert(new_node, 0, size_);
     }
-    new_node->next_ = head_; 
-    head_->prev_ = new_node;
-    head_ = new_node;
 }
 
-template<class T, class Allocator>
+template<class T, class Allocator, bool Pooled, bool Indexed>
 template<class Type>
-List<T, Allocator>::iterator List<T, Allocator>::insertAtPos(iterator pos, Type&& value) {
+List<T, Allocator, Pooled, Indexed>::iterator List<T, Allocator, Pooled, Indexed>::insertAtPos(iterator pos, Type&& value) {
     Node* new_node {getNewNode(std::forward<Type>(value))};
+    size_type index {0};
+    if constexpr(Indexed) {
+        index = skip_index_.indexOf(pos.ptr_, size_);
+    }
     ++size_;
     if((pos == end()) && (pos == begin())) {
         tail_ = head_ = new_node;
@@ -878,21 +1011,25 @@ List<T, Allocator>::iterator List<T, Allocator>::insertAtPos(iterator pos, Type&
         new_node->next_ = temp;
         temp->prev_ = new_node;
     }
+    if constexpr(Indexed) {
+        skip_index_.insert(new_node, index, size_);
+    }
     return Iterator(new_node);
 }
 
 
-template<class T, class Allocator>
-constexpr List<T, Allocator>::allocator_type List<T, Allocator>::get_allocator() const noexcept {
+template<class T, class Allocator, bool Pooled, bool Indexed>
+constexpr List<T, Allocator, Pooled, Indexed>::allocator_type List<T, Allocator, Pooled, Indexed>::get_allocator() const noexcept {
     return alloc_;
 }
 
-template<class T, class Allocator>
-class List<T, Allocator>::Node {
+template<class T, class Allocator, bool Pooled, bool Indexed>
+class List<T, Allocator, Pooled, Indexed>::Node {
 public:
     value_type data_;
     Node* next_;
     Node* prev_;
+    [[no_unique_address]] std::conditional_t<Indexed, typename SkipIndex<Node>::Entry*, NoIndex> entry_ {};
 
     Node(const value_type& data, Node* next, Node* prev): data_ {data}, next_ {next}, prev_ {prev}
     {}
@@ -902,13 +1039,102 @@ public:
     
 };
 
-template<class T, class Allocator>
-List<T, Allocator>::Node* List<T, Allocator>::getNewNode(const value_type& value, Node* head, Node* tail) {
-        Node* new_node {traits_t_i::allocate(alloc_, 1)};
-        traits_t_i::construct(alloc_, new_node, value, head, tail);
-        return new_node;
+template<class T, class Allocator, bool Pooled, bool Indexed>
+List<T, Allocator, Pooled, Indexed>::Node* List<T, Allocator, Pooled, Indexed>::getNewNode(const value_type& value, Node* head, Node* tail) {
+        if constexpr(Pooled) {
+            Node* new_node {pool_.allocate()};
+            try {
+                std::construct_at(new_node, value, head, tail);
+            } catch(...) {
+                pool_.deallocate(new_node);
+                throw;
+            }
+            return new_node;
+        } else {
+            Node* new_node {traits_t_i::allocate(alloc_, 1)};
+            try {
+                traits_t_i::construct(alloc_, new_node, value, head, tail);
+            } catch(...) {
+                traits_t_i::deallocate(alloc_, new_node, 1);
+                throw;
+            }
+            return new_node;
+        }
+    }
+
+template<class T, class Allocator, bool Pooled, bool Indexed>
+template<class Compare>
+void List<T, Allocator, Pooled, Indexed>::mergeRuns(Node*& first, Node*& second, Compare& comp) {
+    Node* a {first};
+    Node* b {second};
+    Node* merged {nullptr};
+    Node** link {&merged};
+    try {
+        while(a && b) {
+            // Take from 'second' only if it is really smaller, that keeps it stable
+            if(comp(b->data_, a->data_)) {
+                *link = b;
+                b = b->next_;
+            } else {
+                *link = a;
+                a = a->next_;
+            }
+            link = &((*link)->next_);
+        }
+    } catch(...) {
+        *link = a;
+        while(*link) {
+            link = &((*link)->next_);
+        }
+        *link = b;
+        first = merged;
+        second = nullptr;
+        throw;
+    }
+    *link = a ? a : b;
+    first = merged;
+    second = nullptr;
+}
+
+template<class T, class Allocator, bool Pooled, bool Indexed>
+void List<T, Allocator, Pooled, Indexed>::relink(Node* first) noexcept {
+    head_ = first;
+    tail_ = nullptr;
+    for(Node* node {first}; node; node = node->next_) {
+        node->prev_ = tail_;
+        tail_ = node;
     }
+    if constexpr(Indexed) {
+        skip_index_.rebuild(head_, size_);
+    }
+}
+
+template<class T, class Allocator, bool Pooled, bool Indexed>
+List<T, Allocator, Pooled, Indexed>::Node* List<T, Allocator, Pooled, Indexed>::nodeAt(size_type index) const noexcept {
+    if constexpr(Indexed) {
+        return skip_index_.nodeAt(index, head_);
+    }
+    if(index >= size_/2) {
+        Node* temp {tail_};
+        for(size_type i {size_ - 1}; i != index; --i) {
+            temp = temp->prev_;
+        }
+        return temp;
+    }
+    Node* temp {head_};
+    for(size_type i {0}; i != index; ++i) {
+        temp = temp->next_;
+    }
+    return temp;
+}
+
+// List whose nodes come from its own NodePool
+template<class T>
+using PooledList = List<T, std::allocator<T>, true>;
 
+// List with O(log n) positional access
+template<class T>
+using IndexedList = List<T, std::allocator<T>, false, true>;
 
 }
 
@@ -0,0 +1,336 @@
+#ifndef MAPPED_HASH_TABLE_HPP
+#define MAPPED_HASH_TABLE_HPP
+
+#include "concepts.hpp"
+#include "hash.hpp"
+#include "hashtable.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ds {
+
+// Read only view of a snapshot written by HashTable::save. The file gets
+// mapped as is, nothing gets parsed or copied: opening costs one mmap and
+// lookups fault in only the pages they touch. Probing is the same as in
+// HashTable, so the view has to use the hash function the table was saved
+// with. A sample of the stored keys gets checked against it on open.
+template<class Key, class T, HashFunction<Key> Hash = FastHash<Key>, class KeyEqual = std::equal_to<Key>>
+requires (std::is_trivially_copyable_v<Key> && std::is_trivially_copyable_v<T>)
+class MappedHashTable {
+public:
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = detail::SnapshotSlot<Key, T>;
+    using size_type = std::size_t;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+
+public:
+    // Throws std::runtime_error if 'path' can not be mapped or is no
+    // snapshot of a HashTable<Key, T>
+    explicit MappedHashTable(const std::string& path, const Hash& hash = Hash(), const KeyEqual& equal = KeyEqual());
+    MappedHashTable(const MappedHashTable& other) = delete;
+    MappedHashTable(MappedHashTable&& other) noexcept;
+    MappedHashTable& operator=(const MappedHashTable& other) = delete;
+    MappedHashTable& operator=(MappedHashTable&& other) noexcept;
+    ~MappedHashTable();
+
+    // Size functions
+    size_type size() const noexcept;
+    size_type capacity() const noexcept;
+    bool empty() const noexcept;
+
+    // Lookup, pointers stay valid as long as the view exists
+    bool exists(const key_type& key) const;
+    const mapped_type* find(const key_type& key) const;
+    const mapped_type& at(const key_type& key) const;
+
+    // Calls 'f' with every stored element as const value_type&
+    template<class F>
+    void for_each(F&& f) const;
+
+private:
+    using ctrl_t = detail::ctrl_t;
+    using Group = detail::Group;
+
+    // Number of stored keys compared against the hash function on open
+    static constexpr size_type kHashSamples {64};
+
+    void* map_ {nullptr};
+    size_type map_size_ {0};
+    size_type capacity_ {0};
+    size_type size_ {0};
+    const ctrl_t* ctrl_ {nullptr};
+    const value_type* slots_ {nullptr};
+    [[no_unique_address]] hasher hash_;
+    [[no_unique_address]] key_equal equal_;
+
+private:
+    void validate(const std::string& path);
+    void unmap() noexcept;
+    size_type findIndex(const key_type& key) const;
+    // Same split of the hash as in HashTable
+    static size_type h1(size_type hash);
+    static ctrl_t h2(size_type hash);
+};
+
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+requires (std::is_trivially_copyable_v<Key> && std::is_trivially_copyable_v<T>)
+MappedHashTable<Key, T, Hash, KeyEqual>::MappedHashTable(const std::string& path, const Hash& hash, const KeyEqual& equal)
+    : hash_ {hash}
+    , equal_ {equal}
+{
+    int fd {::open(path.c_str(), O_RDONLY)};
+    if(fd < 0) {
+        throw std::runtime_error("Can not open snapshot " + path);
+    }
+    struct stat info {};
+    if(::fstat(fd, &info) != 0 || static_cast<size_type>(info.st_size) < sizeof(detail::SnapshotHeader)) {
+        ::close(fd);
+        throw std::runtime_error("Not a snapshot: " + path);
+    }
+    map_size_ = static_cast<size_type>(info.st_size);
+    void* map {::mmap(nullptr, map_size_, PROT_READ, MAP_SHARED, fd, 0)};
+    // The mapping keeps its own reference to the file
+    ::close(fd);
+    if(map == MAP_FAILED) {
+        throw std::runtime_error("Can not map snapshot " + path);
+    }
+    map_ = map;
+    // Probes jump around, read ahead would only pull in pages nobody needs
+    ::madvise(map_, map_size_, MADV_RANDOM);
+
+    try {
+        validate(path);
+    } catch(...) {
+        unmap();
+        throw;
+    }
+}
+
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+requires (std::is_trivially_copyable_v<Key> && std::is_trivially_copyable_v<T>)
+MappedHashTable<Key, T, Hash, KeyEqual>::MappedHashTable(MappedHashTable&& other) noexcept
+    : map_ {std::exchange(other.map_, nullptr)}
+    , map_size_ {std::exchange(other.map_size_, 0)}
+    , capacity_ {std::exchange(other.capacity_, 0)}
+    , size_ {std::exchange(other.size_, 0)}
+    , ctrl_ {std::exchange(other.ctrl_, nullptr)}
+    , slots_ {std::exchange(other.slots_, nullptr)}
+    , hash_ {std::move(other.hash_)}
+    , equal_ {std::move(other.equal_)}
+{
+}
+
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+requires (std::is_trivially_copyable_v<Key> && std::is_trivially_copyable_v<T>)
+MappedHashTable<Key, T, Hash, KeyEqual>& MappedHashTable<Key, T, Hash, KeyEqual>::operator=(MappedHashTable&& other) noexcept {
+    if(this != &other) {
+        unmap();
+        map_ = std::exchange(other.map_, nullptr);
+        map_size_ = std::exchange(other.map_size_, 0);
+        capacity_ = std::exchange(other.capacity_, 0);
+        size_ = std::exchange(other.size_, 0);
+        ctrl_ = std::exchange(other.ctrl_, nullptr);
+        slots_ = std::exchange(other.slots_, nullptr);
+        hash_ = std::move(other.hash_);
+        equal_ = std::move(other.equal_);
+    }
+    return *this;
+}
+
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+requires (std::is_trivially_copyable_v<Key> && std::is_trivially_copyable_v<T>)
+MappedHashTable<Key, T, Hash, KeyEqual>::~MappedHashTable() {
+    unmap();
+}
+
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+requires (std::is_trivially_copyable_v<Key> && std::is_trivially_copyable_v<T>)
+MappedHashTable<Key, T, Hash, KeyEqual>::size_type MappedHashTable<Key, T, Hash, KeyEqual>::size() const noexcept {
+    return size_;
+}
+
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+requires (std::is_trivially_copyable_v<Key> && std::is_trivially_copyable_v<T>)
+MappedHashTable<Key, T, Hash, KeyEqual>::size_type MappedHashTable<Key, T, Hash, KeyEqual>::capacity() const noexcept {
+    return capacity_;
+}
+
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+requires (std::is_trivially_copyable_v<Key> && std::is_trivially_copyable_v<T>)
+bool MappedHashTable<Key, T, Hash, KeyEqual>::empty() const noexcept {
+    return size_ == 0;
+}
+
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+requires (std::is_trivially_copyable_v<Key> && std::is_trivially_copyable_v<T>)
+bool MappedHashTable<Key, T, Hash, KeyEqual>::exists(const key_type& key) const {
+    return findIndex(key) != capacity_;
+}
+
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+requires (std::is_trivially_copyable_v<Key> && std::is_trivially_copyable_v<T>)
+const T* MappedHashTable<Key, T, Hash, KeyEqual>::find(const key_type& key) const {
+    size_type index {findIndex(key)};
+    return index == capacity_ ? nullptr : &slots_[index].second;
+}
+
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+requires (std::is_trivially_copyable_v<Key> && std::is_trivially_copyable_v<T>)
+const T& MappedHashTable<Key, T, Hash, KeyEqual>::at(const key_type& key) const {
+    const mapped_type* value {find(key)};
+    if(!value) {
+        throw std::out_of_range("Element does not exist!");
+    }
+    return *value;
+}
+
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+requires (std::is_trivially_copyable_v<Key> && std::is_trivially_copyable_v<T>)
+template<class F>
+void MappedHashTable<Key, T, Hash, KeyEqual>::for_each(F&& f) const {
+    for(size_type pos {0}; pos < capacity_; pos += Group::width) {
+        for(int i: Group {ctrl_ + pos}.matchFull()) {
+            if(pos + i < capacity_) {
+                f(slots_[pos + i]);
+            }
+        }
+    }
+}
+
+// Checks everything a lookup relies on before the first one can run:
+// format, version, byte order, element layout, that all sections lie inside
+// of the file, that the control bytes are valid, mirrored and leave an
+// empty slot for probes to stop at, and that the keys were placed with the
+// same hash function.
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+requires (std::is_trivially_copyable_v<Key> && std::is_trivially_copyable_v<T>)
+void MappedHashTable<Key, T, Hash, KeyEqual>::validate(const std::string& path) {
+    detail::SnapshotHeader header;
+    std::memcpy(&header, map_, sizeof(header));
+    if(std::memcmp(header.magic, detail::kSnapshotMagic, sizeof(header.magic)) != 0) {
+        throw std::runtime_error("Not a snapshot: " + path);
+    }
+    if(header.version != detail::kSnapshotVersion) {
+        throw std::runtime_error("Unsupported snapshot version " + std::to_string(header.version) + ": " + path);
+    }
+    if(header.byte_order != detail::kSnapshotByteOrder) {
+        throw std::runtime_error("Snapshot was written with another byte order: " + path);
+    }
+    if(header.key_size != sizeof(Key) || header.mapped_size != sizeof(T)
+       || header.value_size != sizeof(value_type) || header.value_align != alignof(value_type)) {
+        throw std::runtime_error("Snapshot holds other key or value types: " + path);
+    }
+    if(header.capacity != 0 && !std::has_single_bit(header.capacity)) {
+        throw std::runtime_error("Corrupt snapshot capacity: " + path);
+    }
+    size_type ctrl_end {sizeof(header) + static_cast<size_type>(header.capacity) + Group::width};
+    if(header.size > header.capacity || header.slots_offset < ctrl_end || header.slots_offset > map_size_
+       || header.slots_offset % alignof(value_type) != 0 || (map_size_ - header.slots_offset) / sizeof(value_type) < header.capacity) {
+        throw std::runtime_error("Truncated or corrupt snapshot: " + path);
+    }
+
+    capacity_ = static_cast<size_type>(header.capacity);
+    size_ = static_cast<size_type>(header.size);
+    const std::byte* base {static_cast<const std::byte*>(map_)};
+    ctrl_ = reinterpret_cast<const ctrl_t*>(base + sizeof(header));
+    slots_ = reinterpret_cast<const value_type*>(base + header.slots_offset);
+
+    bool has_empty {false};
+    for(size_type i {0}; i < capacity_ + Group::width; ++i) {
+        const ctrl_t ctrl {ctrl_[i]};
+        if(!detail::isFull(ctrl) && ctrl != detail::kEmpty && ctrl != detail::kDeleted) {
+            throw std::runtime_error("Corrupt snapshot control bytes: " + path);
+        }
+        // The bytes behind the table repeat its start, see HashTable::setCtrl
+        if(i >= capacity_ && capacity_ != 0 && ctrl != ctrl_[(i - capacity_) % capacity_]) {
+            throw std::runtime_error("Corrupt snapshot control bytes: " + path);
+        }
+        has_empty = has_empty || (i < capacity_ && ctrl == detail::kEmpty);
+    }
+    // findIndex only stops probing at an empty slot
+    if(capacity_ != 0 && !has_empty) {
+        throw std::runtime_error("Corrupt snapshot control bytes: " + path);
+    }
+
+    size_type checked {0};
+    for(size_type i {0}; i < capacity_ && checked < kHashSamples; ++i) {
+        if(detail::isFull(ctrl_[i])) {
+            if(h2(static_cast<size_type>(hash_(slots_[i].first))) != ctrl_[i]) {
+                throw std::runtime_error("Snapshot was written with another hash function: " + path);
+            }
+            ++checked;
+        }
+    }
+}
+
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+requires (std::is_trivially_copyable_v<Key> && std::is_trivially_copyable_v<T>)
+void MappedHashTable<Key, T, Hash, KeyEqual>::unmap() noexcept {
+    if(map_) {
+        ::munmap(map_, map_size_);
+        map_ = nullptr;
+    }
+}
+
+// Same probe sequence as HashTable::findIndex, see there
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+requires (std::is_trivially_copyable_v<Key> && std::is_trivially_copyable_v<T>)
+MappedHashTable<Key, T, Hash, KeyEqual>::size_type MappedHashTable<Key, T, Hash, KeyEqual>::findIndex(const key_type& key) const {
+    if(capacity_ == 0) {
+        return capacity_;
+    }
+    size_type hash {static_cast<size_type>(hash_(key))};
+    size_type pos {h1(hash) & (capacity_ - 1)};
+    for(size_type step {Group::width}; true; step += Group::width) {
+        Group group {ctrl_ + pos};
+        for(int i: group.match(h2(hash))) {
+            size_type index {(pos + i) & (capacity_ - 1)};
+            if(equal_(slots_[index].first, key)) {
+                return index;
+            }
+        }
+        if(group.matchEmpty()) {
+            return capacity_;
+        }
+        pos = (pos + step) & (capacity_ - 1);
+    }
+}
+
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+requires (std::is_trivially_copyable_v<Key> && std::is_trivially_copyable_v<T>)
+MappedHashTable<Key, T, Hash, KeyEqual>::size_type MappedHashTable<Key, T, Hash, KeyEqual>::h1(size_type hash) {
+    return hash >> 7;
+}
+
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+requires (std::is_trivially_copyable_v<Key> && std::is_trivially_copyable_v<T>)
+MappedHashTable<Key, T, Hash, KeyEqual>::ctrl_t MappedHashTable<Key, T, Hash, KeyEqual>::h2(size_type hash) {
+    return static_cast<ctrl_t>(hash & 0x7F);
+}
+
+// Maps the snapshot at 'path', same as constructing the view directly
+template<class Key, class T, HashFunction<Key> Hash = FastHash<Key>, class KeyEqual = std::equal_to<Key>>
+requires (std::is_trivially_copyable_v<Key> && std::is_trivially_copyable_v<T>)
+MappedHashTable<Key, T, Hash, KeyEqual> open_mapped(const std::string& path, const Hash& hash = Hash(), const KeyEqual& equal = KeyEqual()) {
+    return MappedHashTable<Key, T, Hash, KeyEqual>(path, hash, equal);
+}
+
+}
+
+#endif //MAPPED_HASH_TABLE_HPP
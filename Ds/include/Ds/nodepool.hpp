@@ -0,0 +1,197 @@
+#ifndef DS_NODEPOOL_HPP
+#define DS_NODEPOOL_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace ds {
+
+template<class T>
+class NodePool;
+
+template<class T>
+void swap(NodePool<T>& first, NodePool<T>& second) noexcept;
+
+// Slab allocator for fixed size nodes. Nodes get carved out of slabs which
+// double in size up to 'kMaxSlab' nodes, freed nodes go onto an intrusive
+// free list and get reused first. Slabs start on a cache line, so nodes
+// allocated one after another sit next to each other in memory.
+// The pool only hands out raw storage, the owner constructs and destroys
+// the objects in it. release() returns all slabs at once without touching
+// single nodes.
+template<class T>
+class NodePool {
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+
+public:
+    NodePool() = default;
+    NodePool(const NodePool& other) = delete;
+    NodePool(NodePool&& other) noexcept;
+    ~NodePool();
+
+    NodePool& operator=(NodePool other) noexcept;
+
+    // Storage for one T, not constructed
+    T* allocate();
+    // Gives the storage of an already destroyed T back to the pool
+    void deallocate(T* node) noexcept;
+    // Frees every slab. All nodes handed out become invalid.
+    void release() noexcept;
+    // Makes sure the next 'count' allocations need at most one new slab
+    void reserve(size_type count);
+    // Takes over all slabs of 'other', its nodes now belong to this pool
+    void adopt(NodePool& other);
+
+    size_type slab_count() const noexcept;
+    // Number of nodes the slabs can hold in total
+    size_type capacity() const noexcept;
+
+    friend void swap<T>(NodePool<T>& first, NodePool<T>& second) noexcept;
+
+private:
+    union Slot {
+        Slot* next;
+        alignas(T) std::byte storage[sizeof(T)];
+    };
+
+    struct Slab {
+        Slot* slots;
+        size_type count;
+    };
+
+    static constexpr size_type kMinSlab {16};
+    static constexpr size_type kMaxSlab {4096};
+    static constexpr std::align_val_t kSlabAlignment {std::max<std::size_t>(alignof(Slot), 64)};
+
+    Slot* free_ {nullptr};
+    Slot* current_ {nullptr};
+    Slot* end_ {nullptr};
+    size_type capacity_ {0};
+    std::vector<Slab> slabs_;
+
+private:
+    void addSlab(size_type count);
+};
+
+template<class T>
+NodePool<T>::NodePool(NodePool&& other) noexcept: NodePool() {
+    swap(*this, other);
+}
+
+template<class T>
+NodePool<T>::~NodePool() {
+    release();
+}
+
+template<class T>
+NodePool<T>& NodePool<T>::operator=(NodePool other) noexcept {
+    swap(*this, other);
+    return *this;
+}
+
+template<class T>
+T* NodePool<T>::allocate() {
+    if(free_) {
+        Slot* slot {free_};
+        free_ = slot->next;
+        return reinterpret_cast<T*>(slot->storage);
+    }
+    if(current_ == end_) {
+        addSlab(std::clamp(capacity_, kMinSlab, kMaxSlab));
+    }
+    return reinterpret_cast<T*>((current_++)->storage);
+}
+
+template<class T>
+void NodePool<T>::deallocate(T* node) noexcept {
+    Slot* slot {reinterpret_cast<Slot*>(node)};
+    slot->next = free_;
+    free_ = slot;
+}
+
+template<class T>
+void NodePool<T>::release() noexcept {
+    for(const Slab& slab: slabs_) {
+        ::operator delete(slab.slots, slab.count * sizeof(Slot), kSlabAlignment);
+    }
+    slabs_.clear();
+    free_ = current_ = end_ = nullptr;
+    capacity_ = 0;
+}
+
+template<class T>
+void NodePool<T>::reserve(size_type count) {
+    size_type left {static_cast<size_type>(end_ - current_)};
+    if(count > left) {
+        addSlab(count - left);
+    }
+}
+
+template<class T>
+void NodePool<T>::adopt(NodePool& other) {
+    if(&other == this) {
+        return;
+    }
+    slabs_.insert(slabs_.end(), other.slabs_.begin(), other.slabs_.end());
+    other.slabs_.clear();
+    while(other.current_ != other.end_) {
+        deallocate(reinterpret_cast<T*>((other.current_++)->storage));
+    }
+    while(other.free_) {
+        Slot* slot {other.free_};
+        other.free_ = slot->next;
+        deallocate(reinterpret_cast<T*>(slot->storage));
+    }
+    capacity_ += other.capacity_;
+    other.release();
+}
+
+template<class T>
+NodePool<T>::size_type NodePool<T>::slab_count() const noexcept {
+    return slabs_.size();
+}
+
+template<class T>
+NodePool<T>::size_type NodePool<T>::capacity() const noexcept {
+    return capacity_;
+}
+
+template<class T>
+void NodePool<T>::addSlab(size_type count) {
+    // Grows geometrically, and before the slab gets allocated so a failing
+    // push_back can't leak it
+    if(slabs_.size() == slabs_.capacity()) {
+        slabs_.reserve(2 * slabs_.size() + 1);
+    }
+    Slot* slots {static_cast<Slot*>(::operator new(count * sizeof(Slot), kSlabAlignment))};
+    slabs_.push_back(Slab {slots, count});
+
+    // Whatever is left of the current slab would be lost, keep it on the free list
+    while(current_ != end_) {
+        deallocate(reinterpret_cast<T*>((current_++)->storage));
+    }
+    current_ = slots;
+    end_ = slots + count;
+    capacity_ += count;
+}
+
+template<class T>
+void swap(NodePool<T>& first, NodePool<T>& second) noexcept {
+    using std::swap;
+
+    swap(first.free_, second.free_);
+    swap(first.current_, second.current_);
+    swap(first.end_, second.end_);
+    swap(first.capacity_, second.capacity_);
+    swap(first.slabs_, second.slabs_);
+}
+
+}
+
+#endif //DS_NODEPOOL_HPP
@@ -0,0 +1,264 @@
+#ifndef READ_MOSTLY_HASH_TABLE_HPP
+#define READ_MOSTLY_HASH_TABLE_HPP
+
+#include "concepts.hpp"
+#include "epoch.hpp"
+#include "hash.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+namespace ds {
+
+// Thread safe hashtable with separate chaining for read mostly workloads.
+// Lookups take no lock and write no shared memory: they pin an epoch,
+// follow atomic chain pointers and copy the value out. Writers serialize
+// on one mutex and never modify a published node. An assignment links in
+// a new node and retires the old one, growing builds a new bucket array
+// with copies of all nodes and retires the old array as a whole. Retired
+// memory gets freed by the EpochDomain once no reader can still see it.
+template<class Key, MappedConcept T, HashFunction<Key> Hash = FastHash<Key>, class KeyEqual = std::equal_to<Key>>
+class ReadMostlyHT {
+public:
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = std::pair<Key, T>;
+    using size_type = std::size_t;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+
+public:
+    explicit ReadMostlyHT(size_type capacity = 16, const Hash& hash = Hash(), const KeyEqual& equal = KeyEqual());
+    ReadMostlyHT(const ReadMostlyHT& other) = delete;
+    ReadMostlyHT& operator=(const ReadMostlyHT& other) = delete;
+    ~ReadMostlyHT();
+
+    size_type size() const noexcept;
+    size_type capacity() const;
+    bool empty() const noexcept;
+
+    // Lock free lookups
+    bool exists(const key_type& key) const;
+    mapped_type at(const key_type& key) const;
+    std::optional<mapped_type> find(const key_type& key) const;
+    // Calls 'f' with a const reference to the value of 'key'. The value
+    // stays valid for the call only. Returns false if 'key' does not exist.
+    template<class F>
+    bool visit(const key_type& key, F&& f) const;
+
+    // Modifiers, serialized with each other but never blocking lookups
+    bool insert(const key_type& key, const mapped_type& value);
+    template<class Type>
+    bool insert_or_assign(const key_type& key, Type&& obj);
+    bool erase(const key_type& key);
+
+    // Memory waiting for readers to move on, see EpochDomain::pending
+    size_type pending_reclamation() const;
+
+private:
+    struct Node {
+        template<class... Args>
+        Node(Node* n, Args&&... args): next {n}, value(std::forward<Args>(args)...) {}
+
+        std::atomic<Node*> next;
+        const value_type value;
+    };
+
+    // Owns the nodes reachable from its heads
+    struct Table {
+        explicit Table(size_type count): count {count}, heads {std::make_unique<std::atomic<Node*>[]>(count)} {}
+        ~Table() {
+            for(size_type i {0}; i < count; ++i) {
+                Node* node {heads[i].load(std::memory_order_relaxed)};
+                while(node) {
+                    Node* next {node->next.load(std::memory_order_relaxed)};
+                    delete node;
+                    node = next;
+                }
+            }
+        }
+
+        size_type count;
+        std::unique_ptr<std::atomic<Node*>[]> heads;
+    };
+
+    std::atomic<Table*> table_;
+    std::atomic<size_type> size_ {0};
+    std::mutex write_mutex_;
+    mutable EpochDomain epoch_;
+    [[no_unique_address]] hasher hash_;
+    [[no_unique_address]] key_equal equal_;
+
+private:
+    std::atomic<Node*>& bucketFor(const Table& table, const key_type& key) const;
+    // Writer side. Returns the link pointing at the node of 'key' or at the
+    // end of its chain.
+    std::atomic<Node*>* findLink(Table& table, const key_type& key);
+    void growIfFull();
+};
+
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
+ReadMostlyHT<Key, T, Hash, KeyEqual>::ReadMostlyHT(size_type capacity, const Hash& hash, const KeyEqual& equal)
+    : table_ {new Table(capacity < 1 ? 1 : capacity)}
+    , hash_ {hash}
+    , equal_ {equal}
+{
+}
+
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
+ReadMostlyHT<Key, T, Hash, KeyEqual>::~ReadMostlyHT() {
+    delete table_.load(std::memory_order_relaxed);
+}
+
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
+ReadMostlyHT<Key, T, Hash, KeyEqual>::size_type ReadMostlyHT<Key, T, Hash, KeyEqual>::size() const noexcept {
+    return size_.load(std::memory_order_relaxed);
+}
+
+// Not noexcept, pinning may allocate the epoch slot of the calling thread
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
+ReadMostlyHT<Key, T, Hash, KeyEqual>::size_type ReadMostlyHT<Key, T, Hash, KeyEqual>::capacity() const {
+    auto guard = epoch_.pin();
+    return table_.load(std::memory_order_acquire)->count;
+}
+
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
+bool ReadMostlyHT<Key, T, Hash, KeyEqual>::empty() const noexcept {
+    return size() == 0;
+}
+
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
+bool ReadMostlyHT<Key, T, Hash, KeyEqual>::exists(const key_type& key) const {
+    return visit(key, [](const mapped_type&) {});
+}
+
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
+ReadMostlyHT<Key, T, Hash, KeyEqual>::mapped_type ReadMostlyHT<Key, T, Hash, KeyEqual>::at(const key_type& key) const {
+    std::optional<mapped_type> value {find(key)};
+    if(!value) {
+        throw std::out_of_range("Element does not exist!");
+    }
+    return std::move(*value);
+}
+
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
+std::optional<T> ReadMostlyHT<Key, T, Hash, KeyEqual>::find(const key_type& key) const {
+    std::optional<mapped_type> value;
+    visit(key, [&value](const mapped_type& found) { value.emplace(found); });
+    return value;
+}
+
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
+template<class F>
+bool ReadMostlyHT<Key, T, Hash, KeyEqual>::visit(const key_type& key, F&& f) const {
+    auto guard = epoch_.pin();
+    const Table* table {table_.load(std::memory_order_acquire)};
+    for(Node* node {bucketFor(*table, key).load(std::memory_order_acquire)}; node; node = node->next.load(std::memory_order_acquire)) {
+        if(equal_(node->value.first, key)) {
+            f(node->value.second);
+            return true;
+        }
+    }
+    return false;
+}
+
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
+bool ReadMostlyHT<Key, T, Hash, KeyEqual>::insert(const key_type& key, const mapped_type& value) {
+    std::lock_guard lock {write_mutex_};
+    growIfFull();
+    Table& table {*table_.load(std::memory_order_relaxed)};
+    std::atomic<Node*>* link {findLink(table, key)};
+    if(link->load(std::memory_order_relaxed)) {
+        return false;
+    }
+    // Readers see either nothing or the fully constructed node
+    link->store(new Node(nullptr, key, value), std::memory_order_release);
+    size_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
+template<class Type>
+bool ReadMostlyHT<Key, T, Hash, KeyEqual>::insert_or_assign(const key_type& key, Type&& obj) {
+    std::lock_guard lock {write_mutex_};
+    growIfFull();
+    Table& table {*table_.load(std::memory_order_relaxed)};
+    std::atomic<Node*>* link {findLink(table, key)};
+    Node* old {link->load(std::memory_order_relaxed)};
+    if(!old) {
+        link->store(new Node(nullptr, key, std::forward<Type>(obj)), std::memory_order_release);
+        size_.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    // Readers still on 'old' can continue through its unchanged next pointer
+    link->store(new Node(old->next.load(std::memory_order_relaxed), key, std::forward<Type>(obj)), std::memory_order_release);
+    epoch_.retire(old);
+    return false;
+}
+
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
+bool ReadMostlyHT<Key, T, Hash, KeyEqual>::erase(const key_type& key) {
+    std::lock_guard lock {write_mutex_};
+    Table& table {*table_.load(std::memory_order_relaxed)};
+    std::atomic<Node*>* link {findLink(table, key)};
+    Node* old {link->load(std::memory_order_relaxed)};
+    if(!old) {
+        return false;
+    }
+    link->store(old->next.load(std::memory_order_relaxed), std::memory_order_release);
+    size_.fetch_sub(1, std::memory_order_relaxed);
+    epoch_.retire(old);
+    return true;
+}
+
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
+ReadMostlyHT<Key, T, Hash, KeyEqual>::size_type ReadMostlyHT<Key, T, Hash, KeyEqual>::pending_reclamation() const {
+    return epoch_.pending();
+}
+
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
+std::atomic<typename ReadMostlyHT<Key, T, Hash, KeyEqual>::Node*>& ReadMostlyHT<Key, T, Hash, KeyEqual>::bucketFor(const Table& table, const key_type& key) const {
+    return table.heads[detail::fastRange(hash_(key), table.count)];
+}
+
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
+std::atomic<typename ReadMostlyHT<Key, T, Hash, KeyEqual>::Node*>* ReadMostlyHT<Key, T, Hash, KeyEqual>::findLink(Table& table, const key_type& key) {
+    std::atomic<Node*>* link {&bucketFor(table, key)};
+    for(Node* node {link->load(std::memory_order_relaxed)}; node; node = link->load(std::memory_order_relaxed)) {
+        if(equal_(node->value.first, key)) {
+            break;
+        }
+        link = &node->next;
+    }
+    return link;
+}
+
+// Doubles the bucket count once there are as many elements as buckets. The
+// nodes of the old table can not be relinked, readers might still walk
+// them, so the new table gets copies and the old one gets retired.
+template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
+void ReadMostlyHT<Key, T, Hash, KeyEqual>::growIfFull() {
+    Table* old {table_.load(std::memory_order_relaxed)};
+    if(size_.load(std::memory_order_relaxed) < old->count) {
+        return;
+    }
+    auto grown = std::make_unique<Table>(old->count * 2);
+    for(size_type i {0}; i < old->count; ++i) {
+        for(Node* node {old->heads[i].load(std::memory_order_relaxed)}; node; node = node->next.load(std::memory_order_relaxed)) {
+            std::atomic<Node*>& head {bucketFor(*grown, node->value.first)};
+            head.store(new Node(head.load(std::memory_order_relaxed), node->value), std::memory_order_relaxed);
+        }
+    }
+    table_.store(grown.release(), std::memory_order_release);
+    epoch_.retire(old);
+}
+
+}
+
+#endif //READ_MOSTLY_HASH_TABLE_HPP
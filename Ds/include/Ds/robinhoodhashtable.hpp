@@ -0,0 +1,495 @@
+#ifndef ROBIN_HOOD_HASH_TABLE_HPP
+#define ROBIN_HOOD_HASH_TABLE_HPP
+
+#include "concepts.hpp"
+#include "hash.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ds {
+
+template<class Key, class T, HashFunction<Key> Hash = FastHash<Key>, class KeyEqual = std::equal_to<Key>>
+class RobinHoodHashTable;
+
+template<class KeyF, class TF, class HashF, class KeyEqualF>
+void swap(RobinHoodHashTable<KeyF, TF, HashF, KeyEqualF>& first, RobinHoodHashTable<KeyF, TF, HashF, KeyEqualF>& second) noexcept;
+
+// Open addressing hashtable with linear probing and Robin Hood insertion.
+// Every slot stores how far it is away from its home slot. An insert takes
+// the slot of any element that is closer to its home, which keeps the
+// probe lengths of all elements close to each other. A lookup can stop as
+// soon as it sees a slot closer to its home than the probe itself, and
+// erase shifts the following elements back instead of leaving tombstones.
+// Same interface as HashTable, so tables can switch between both.
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+class RobinHoodHashTable {
+public:
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = std::pair<Key, T>;
+    using size_type = std::size_t;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+    using allocator_type = std::allocator<value_type>;
+    using traits_t = std::allocator_traits<allocator_type>;
+    using pointer = typename traits_t::pointer;
+
+public:
+    RobinHoodHashTable();
+    RobinHoodHashTable(size_type size, const Hash& hash = Hash(), const KeyEqual& equal = KeyEqual());
+    RobinHoodHashTable(std::initializer_list<value_type> iList);
+    RobinHoodHashTable(const RobinHoodHashTable& other);
+    RobinHoodHashTable(RobinHoodHashTable&& other) noexcept;
+    ~RobinHoodHashTable();
+
+    // Size functions
+    constexpr size_type size() const noexcept;
+    constexpr size_type capacity() const noexcept;
+    constexpr bool empty() const noexcept;
+    bool exists(const key_type& key) const;
+
+    // Lookup
+    mapped_type* find(const key_type& key);
+    const mapped_type* find(const key_type& key) const;
+
+    // Hash policy
+    float load_factor() const noexcept;
+    float max_load_factor() const noexcept;
+    void max_load_factor(float ml);
+    void rehash(size_type count);
+    void reserve(size_type count);
+    hasher hash_function() const;
+    key_equal key_eq() const;
+
+    // Introspection. The probe length of an element is its distance to
+    // its home slot, so 0 means it got found with the first comparison.
+    std::vector<size_type> probe_length_histogram() const;
+    size_type max_probe_length() const;
+
+    // Modifiers
+    bool insert(const key_type& key, const mapped_type& value);
+    bool insert(const key_type& key, mapped_type&& value);
+    template<class... Args>
+    std::pair<mapped_type*, bool> try_emplace(const key_type& key, Args&&... args);
+    T& operator[](const key_type& key);
+    const T& operator[](const key_type& key) const;
+    void erase(const key_type& key);
+
+    RobinHoodHashTable& operator=(RobinHoodHashTable other) noexcept;
+
+    template<class KeyF, class TF, class HashF, class KeyEqualF>
+    friend void swap(RobinHoodHashTable<KeyF, TF, HashF, KeyEqualF>& first, RobinHoodHashTable<KeyF, TF, HashF, KeyEqualF>& second) noexcept;
+
+private:
+    // Probe distance + 1 of every slot, 0 marks an empty slot
+    using dist_t = std::uint16_t;
+
+    size_type capacity_;
+    size_type size_;
+    float max_load_factor_;
+    std::vector<dist_t> dist_;
+    allocator_type alloc_;
+    pointer arr_;
+    [[no_unique_address]] hasher hash_;
+    [[no_unique_address]] key_equal equal_;
+
+private:
+    size_type hashFunction(const Key& key) const;
+    size_type moduloIndex(size_type index) const;
+    size_type maxElements(size_type capacity) const;
+    size_type minCapacityFor(size_type count) const;
+    size_type findIndex(const Key& key) const;
+    bool probe(const Key& key, size_type& index, dist_t& dist) const;
+    void shiftUp(size_type index);
+    void shiftDown(size_type index);
+    void destroyAndDealloc();
+};
+
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+RobinHoodHashTable<Key, T, Hash, KeyEqual>::RobinHoodHashTable(): RobinHoodHashTable(0) {}
+
+// 'size' gets rounded up to the next power of two
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+RobinHoodHashTable<Key, T, Hash, KeyEqual>::RobinHoodHashTable(size_type size, const Hash& hash, const KeyEqual& equal)
+    : capacity_ {size == 0 ? 0 : std::bit_ceil(size)}
+    , size_ {0}
+    , max_load_factor_ {0.875f}
+    , dist_(capacity_, 0)
+    , arr_ {capacity_ ? traits_t::allocate(alloc_, capacity_) : nullptr}
+    , hash_ {hash}
+    , equal_ {equal}
+{
+}
+
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+RobinHoodHashTable<Key, T, Hash, KeyEqual>::RobinHoodHashTable(std::initializer_list<value_type> iList): RobinHoodHashTable() {
+    reserve(iList.size());
+    for(const auto& elem: iList) {
+        try_emplace(elem.first, elem.second);
+    }
+}
+
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+RobinHoodHashTable<Key, T, Hash, KeyEqual>::RobinHoodHashTable(const RobinHoodHashTable& other): RobinHoodHashTable(other.capacity_, other.hash_, other.equal_) {
+    max_load_factor_ = other.max_load_factor_;
+    for(size_type i {0}; i < capacity_; ++i) {
+        if(other.dist_[i]) {
+            traits_t::construct(alloc_, arr_ + i, other.arr_[i]);
+            dist_[i] = other.dist_[i];
+        }
+    }
+    size_ = other.size_;
+}
+
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+RobinHoodHashTable<Key, T, Hash, KeyEqual>::RobinHoodHashTable(RobinHoodHashTable&& other) noexcept: RobinHoodHashTable() {
+    swap(*this, other);
+}
+
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+RobinHoodHashTable<Key, T, Hash, KeyEqual>::~RobinHoodHashTable() {
+    destroyAndDealloc();
+}
+
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+constexpr RobinHoodHashTable<Key, T, Hash, KeyEqual>::size_type RobinHoodHashTable<Key, T, Hash, KeyEqual>::size() const noexcept {
+    return size_;
+}
+
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+constexpr RobinHoodHashTable<Key, T, Hash, KeyEqual>::size_type RobinHoodHashTable<Key, T, Hash, KeyEqual>::capacity() const noexcept {
+    return capacity_;
+}
+
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+constexpr bool RobinHoodHashTable<Key, T, Hash, KeyEqual>::empty() const noexcept {
+    return size_ == 0;
+}
+
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+bool RobinHoodHashTable<Key, T, Hash, KeyEqual>::exists(const key_type& key) const {
+    return findIndex(key) != capacity_;
+}
+
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+RobinHoodHashTable<Key, T, Hash, KeyEqual>::mapped_type* RobinHoodHashTable<Key, T, Hash, KeyEqual>::find(const key_type& key) {
+    size_type index {findIndex(key)};
+    return index == capacity_ ? nullptr : &(arr_[index].second);
+}
+
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+const RobinHoodHashTable<Key, T, Hash, KeyEqual>::mapped_type* RobinHoodHashTable<Key, T, Hash, KeyEqual>::find(const key_type& key) const {
+    size_type index {findIndex(key)};
+    return index == capacity_ ? nullptr : &(arr_[index].second);
+}
+
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+float RobinHoodHashTable<Key, T, Hash, KeyEqual>::load_factor() const noexcept {
+    return capacity_ == 0 ? 0.0f : static_cast<float>(size_) / static_cast<float>(capacity_);
+}
+
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+float RobinHoodHashTable<Key, T, Hash, KeyEqual>::max_load_factor() const noexcept {
+    return max_load_factor_;
+}
+
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+void RobinHoodHashTable<Key, T, Hash, KeyEqual>::max_load_factor(float ml) {
+    if(!(ml > 0.0f && ml <= 1.0f)) {
+        throw std::invalid_argument("Max load factor has to be in (0, 1]");
+    }
+    max_load_factor_ = ml;
+    rehash(capacity_);
+}
+
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+void RobinHoodHashTable<Key, T, Hash, KeyEqual>::rehash(size_type count) {
+    size_type new_capacity {std::max(count, minCapacityFor(size_))};
+    new_capacity = new_capacity == 0 ? 0 : std::bit_ceil(new_capacity);
+    if(new_capacity == capacity_) {
+        return;
+    }
+
+    RobinHoodHashTable other(new_capacity, hash_, equal_);
+    other.max_load_factor_ = max_load_factor_;
+    for(size_type i {0}; i < capacity_; ++i) {
+        if(dist_[i]) {
+            other.try_emplace(arr_[i].first, std::move(arr_[i].second));
+        }
+    }
+    swap(*this, other);
+}
+
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+void RobinHoodHashTable<Key, T, Hash, KeyEqual>::reserve(size_type count) {
+    if(count > size_) {
+        rehash(minCapacityFor(count));
+    }
+}
+
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+RobinHoodHashTable<Key, T, Hash, KeyEqual>::hasher RobinHoodHashTable<Key, T, Hash, KeyEqual>::hash_function() const {
+    return hash_;
+}
+
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+RobinHoodHashTable<Key, T, Hash, KeyEqual>::key_equal RobinHoodHashTable<Key, T, Hash, KeyEqual>::key_eq() const {
+    return equal_;
+}
+
+// Entry i counts the elements with a probe length of i
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+std::vector<typename RobinHoodHashTable<Key, T, Hash, KeyEqual>::size_type> RobinHoodHashTable<Key, T, Hash, KeyEqual>::probe_length_histogram() const {
+    std::vector<size_type> histogram(max_probe_length() + 1, 0);
+    for(size_type i {0}; i < capacity_; ++i) {
+        if(dist_[i]) {
+            ++histogram[dist_[i] - 1];
+        }
+    }
+    return histogram;
+}
+
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+RobinHoodHashTable<Key, T, Hash, KeyEqual>::size_type RobinHoodHashTable<Key, T, Hash, KeyEqual>::max_probe_length() const {
+    dist_t max_dist {0};
+    for(size_type i {0}; i < capacity_; ++i) {
+        max_dist = std::max(max_dist, dist_[i]);
+    }
+    return max_dist == 0 ? 0 : max_dist - 1;
+}
+
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+bool RobinHoodHashTable<Key, T, Hash, KeyEqual>::insert(const key_type& key, const mapped_type& value) {
+    return try_emplace(key, value).second;
+}
+
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+bool RobinHoodHashTable<Key, T, Hash, KeyEqual>::insert(const key_type& key, mapped_type&& value) {
+    return try_emplace(key, std::move(value)).second;
+}
+
+// The element gets built before the table changes: 'key' and 'args' may
+// refer to an element that the rehash or shiftUp moves.
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+template<class... Args>
+std::pair<typename RobinHoodHashTable<Key, T, Hash, KeyEqual>::mapped_type*, bool> RobinHoodHashTable<Key, T, Hash, KeyEqual>::try_emplace(const key_type& key, Args&&... args) {
+    size_type index {0};
+    dist_t dist {1};
+    if(probe(key, index, dist)) {
+        return std::make_pair(&(arr_[index].second), false);
+    }
+    value_type value(std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Args>(args)...));
+    if(size_ >= maxElements(capacity_)) {
+        rehash(capacity_ == 0 ? 16 : capacity_ * 2);
+        probe(value.first, index, dist);
+    }
+    if(dist_[index]) {
+        shiftUp(index);
+        traits_t::destroy(alloc_, arr_ + index);
+        dist_[index] = 0;
+    }
+    try {
+        traits_t::construct(alloc_, arr_ + index, std::move(value));
+    } catch(...) {
+        // Moves the elements shiftUp moved away back into the empty slot
+        shiftDown(index);
+        throw;
+    }
+    dist_[index] = dist;
+    ++size_;
+    return std::make_pair(&(arr_[index].second), true);
+}
+
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+T& RobinHoodHashTable<Key, T, Hash, KeyEqual>::operator[](const key_type& key) {
+    return *(try_emplace(key).first);
+}
+
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+const T& RobinHoodHashTable<Key, T, Hash, KeyEqual>::operator[](const key_type& key) const {
+    size_type index {findIndex(key)};
+    if (index == capacity_) {
+        throw std::invalid_argument("Key is not present in the Hashtable");
+    }
+    return arr_[index].second;
+}
+
+// Backward shift deletion: every following element which is not in its home
+// slot moves one slot closer to it, so no tombstone is needed.
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+void RobinHoodHashTable<Key, T, Hash, KeyEqual>::erase(const key_type& key) {
+    size_type index {findIndex(key)};
+    if(index == capacity_) {
+        return;
+    }
+    traits_t::destroy(alloc_, arr_ + index);
+    dist_[index] = 0;
+    shiftDown(index);
+    --size_;
+}
+
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+RobinHoodHashTable<Key, T, Hash, KeyEqual>& RobinHoodHashTable<Key, T, Hash, KeyEqual>::operator=(RobinHoodHashTable other) noexcept {
+    swap(*this, other);
+
+    return *this;
+}
+
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+RobinHoodHashTable<Key, T, Hash, KeyEqual>::size_type RobinHoodHashTable<Key, T, Hash, KeyEqual>::hashFunction(const Key& key) const {
+    return static_cast<size_type>(hash_(key));
+}
+
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+RobinHoodHashTable<Key, T, Hash, KeyEqual>::size_type RobinHoodHashTable<Key, T, Hash, KeyEqual>::moduloIndex(size_type index) const {
+    return index & (capacity_ - 1);
+}
+
+// At least one slot always stays empty, so every probe sequence ends
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+RobinHoodHashTable<Key, T, Hash, KeyEqual>::size_type RobinHoodHashTable<Key, T, Hash, KeyEqual>::maxElements(size_type capacity) const {
+    if(capacity == 0) {
+        return 0;
+    }
+    return std::min(static_cast<size_type>(static_cast<double>(capacity) * max_load_factor_), capacity - 1);
+}
+
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+RobinHoodHashTable<Key, T, Hash, KeyEqual>::size_type RobinHoodHashTable<Key, T, Hash, KeyEqual>::minCapacityFor(size_type count) const {
+    if(count == 0) {
+        return 0;
+    }
+    size_type capacity {std::bit_ceil(static_cast<size_type>(static_cast<double>(count) / max_load_factor_))};
+    while(maxElements(capacity) < count) {
+        capacity *= 2;
+    }
+    return capacity;
+}
+
+// Returns the index of 'key' or capacity_. Stops early once the probe is
+// further away from home than the element in the current slot, because
+// Robin Hood insertion would have put 'key' there.
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+RobinHoodHashTable<Key, T, Hash, KeyEqual>::size_type RobinHoodHashTable<Key, T, Hash, KeyEqual>::findIndex(const Key& key) const {
+    if(capacity_ == 0) {
+        return capacity_;
+    }
+    size_type index {moduloIndex(hashFunction(key))};
+    for(size_type dist {1}; dist <= dist_[index]; ++dist) {
+        if(dist == dist_[index] && equal_(arr_[index].first, key)) {
+            return index;
+        }
+        index = moduloIndex(index + 1);
+    }
+    return capacity_;
+}
+
+// Walks the probe sequence until 'key' shows up or a slot is closer to its
+// home than the probe, which is where 'key' belongs. Returns if 'key' got
+// found, 'index' and 'dist' are its slot or the slot it belongs in.
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+bool RobinHoodHashTable<Key, T, Hash, KeyEqual>::probe(const Key& key, size_type& index, dist_t& dist) const {
+    index = 0;
+    dist = 1;
+    if(capacity_ == 0) {
+        return false;
+    }
+    index = moduloIndex(hashFunction(key));
+    while(dist <= dist_[index]) {
+        if(dist == dist_[index] && equal_(arr_[index].first, key)) {
+            return true;
+        }
+        ++index;
+        index = moduloIndex(index);
+        if(dist == std::numeric_limits<dist_t>::max()) {
+            throw std::length_error("Probe length of the RobinHoodHashTable overflowed");
+        }
+        ++dist;
+    }
+    return false;
+}
+
+// Moves the elements from 'index' up to the next empty slot one slot
+// further, which keeps them ordered by home slot
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+void RobinHoodHashTable<Key, T, Hash, KeyEqual>::shiftUp(size_type index) {
+    size_type empty_index {index};
+    while(dist_[empty_index]) {
+        if(dist_[empty_index] == std::numeric_limits<dist_t>::max()) {
+            throw std::length_error("Probe length of the RobinHoodHashTable overflowed");
+        }
+        empty_index = moduloIndex(empty_index + 1);
+    }
+    while(empty_index != index) {
+        size_type prev {moduloIndex(empty_index - 1)};
+        if(dist_[empty_index]) {
+            arr_[empty_index] = std::move(arr_[prev]);
+        } else {
+            traits_t::construct(alloc_, arr_ + empty_index, std::move(arr_[prev]));
+        }
+        dist_[empty_index] = dist_[prev] + 1;
+        empty_index = prev;
+    }
+}
+
+// The slot at 'index' is empty, every following element which is not in
+// its home slot moves one slot closer to it
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+void RobinHoodHashTable<Key, T, Hash, KeyEqual>::shiftDown(size_type index) {
+    size_type next {moduloIndex(index + 1)};
+    while(dist_[next] > 1) {
+        traits_t::construct(alloc_, arr_ + index, std::move(arr_[next]));
+        traits_t::destroy(alloc_, arr_ + next);
+        dist_[index] = dist_[next] - 1;
+        dist_[next] = 0;
+        index = next;
+        next = moduloIndex(next + 1);
+    }
+}
+
+template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+void RobinHoodHashTable<Key, T, Hash, KeyEqual>::destroyAndDealloc() {
+    if(!arr_) {
+        return;
+    }
+    for(size_type i {0}; i < capacity_; ++i) {
+        if(dist_[i]) {
+            traits_t::destroy(alloc_, arr_ + i);
+        }
+    }
+    traits_t::deallocate(alloc_, arr_, capacity_);
+    arr_ = nullptr;
+}
+
+template<class KeyF, class TF, class HashF, class KeyEqualF>
+void swap(RobinHoodHashTable<KeyF, TF, HashF, KeyEqualF>& first, RobinHoodHashTable<KeyF, TF, HashF, KeyEqualF>& second) noexcept {
+    using std::swap;
+
+    swap(first.hash_, second.hash_);
+    swap(first.equal_, second.equal_);
+    swap(first.size_, second.size_);
+    swap(first.capacity_, second.capacity_);
+    swap(first.max_load_factor_, second.max_load_factor_);
+    swap(first.dist_, second.dist_);
+    swap(first.arr_, second.arr_);
+}
+
+}
+
+#endif //ROBIN_HOOD_HASH_TABLE_HPP
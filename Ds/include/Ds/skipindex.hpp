@@ -0,0 +1,293 @@
+#ifndef DS_SKIPINDEX_HPP
+#define DS_SKIPINDEX_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#include "nodepool.hpp"
+
+namespace ds {
+
+template<class Node>
+class SkipIndex;
+
+template<class Node>
+void swap(SkipIndex<Node>& first, SkipIndex<Node>& second) noexcept;
+
+// Order statistic skip list over the nodes of a linked list. It finds the
+// node at a position and the position of a node in expected O(log n).
+// The linked list itself is the lowest level, a node gets an entry on index
+// level k with probability 4^-(k+1). Every entry stores the number of steps
+// to the next entry on its level, the last entry of a level counts up to the
+// end of the list.
+// Ranks count from the head, which has rank 0: the node at position i has
+// rank i + 1 and the end of the list has rank size + 1.
+// 'Node' needs a 'Node* next_' and an 'Entry* entry_' member, entry_ points
+// to the lowest entry of the node or is nullptr. The owner links the nodes
+// and reports every insert and erase, the index only reads next_.
+template<class Node>
+class SkipIndex {
+public:
+    using size_type = std::size_t;
+
+    struct Entry {
+        Node* node_;
+        Entry* right_;
+        Entry* down_;
+        Entry* up_;
+        size_type width_;
+    };
+
+public:
+    SkipIndex() = default;
+    SkipIndex(const SkipIndex& other) = delete;
+    SkipIndex(SkipIndex&& other) noexcept;
+
+    SkipIndex& operator=(SkipIndex other) noexcept;
+
+    // Node at 'index', 'first' is the first node of the list
+    Node* nodeAt(size_type index, Node* first) const noexcept;
+    // Position of 'node' in a list of 'size' nodes
+    size_type indexOf(const Node* node, size_type size) const noexcept;
+    // 'node' just got linked in at 'index', 'size' counts it already. If an
+    // entry can't be allocated the node gets a lower tower, the index stays
+    // correct.
+    void insert(Node* node, size_type index, size_type size) noexcept;
+    // 'node' at 'index' is about to get unlinked
+    void erase(Node* node, size_type index) noexcept;
+    // Builds an evenly spaced index over the list starting at 'first', after
+    // the owner relinked its nodes
+    void rebuild(Node* first, size_type size) noexcept;
+    // Drops every entry, the nodes have to go away or get rebuilt
+    void clear() noexcept;
+
+    size_type levels() const noexcept;
+
+    friend void swap<Node>(SkipIndex<Node>& first, SkipIndex<Node>& second) noexcept;
+
+private:
+    static constexpr size_type kMaxLevel {32};
+
+    // The heads are entries without a node, nothing points at them
+    std::array<Entry, kMaxLevel> heads_ {};
+    size_type levels_ {0};
+    std::uint64_t random_ {0x9E3779B97F4A7C15};
+    NodePool<Entry> pool_;
+
+private:
+    size_type randomHeight() noexcept;
+};
+
+template<class Node>
+SkipIndex<Node>::SkipIndex(SkipIndex&& other) noexcept: SkipIndex() {
+    swap(*this, other);
+}
+
+template<class Node>
+SkipIndex<Node>& SkipIndex<Node>::operator=(SkipIndex other) noexcept {
+    swap(*this, other);
+    return *this;
+}
+
+template<class Node>
+Node* SkipIndex<Node>::nodeAt(size_type index, Node* first) const noexcept {
+    const size_type target {index + 1};
+    size_type rank {0};
+    const Entry* at {nullptr};
+    for(size_type level {levels_}; level-- > 0;) {
+        at = (at && at->node_) ? at->down_ : &heads_[level];
+        while(at->right_ && rank + at->width_ <= target) {
+            rank += at->width_;
+            at = at->right_;
+        }
+    }
+    Node* node {first};
+    if(at && at->node_) {
+        node = at->node_;
+    } else {
+        rank = 1;
+    }
+    for(; rank < target; ++rank) {
+        node = node->next_;
+    }
+    return node;
+}
+
+// Walks right to the next node with an entry, then up and right to the end
+// of the list, adding up the steps
+template<class Node>
+SkipIndex<Node>::size_type SkipIndex<Node>::indexOf(const Node* node, size_type size) const noexcept {
+    size_type steps {0};
+    while(node && !node->entry_) {
+        node = node->next_;
+        ++steps;
+    }
+    if(node) {
+        const Entry* at {node->entry_};
+        while(true) {
+            while(at->up_) {
+                at = at->up_;
+            }
+            steps += at->width_;
+            if(!at->right_) {
+                break;
+            }
+            at = at->right_;
+        }
+    }
+    return size - steps;
+}
+
+template<class Node>
+void SkipIndex<Node>::insert(Node* node, size_type index, size_type size) noexcept {
+    std::array<Entry*, kMaxLevel> tower {};
+    size_type height {randomHeight()};
+    size_type built {0};
+    try {
+        for(; built < height; ++built) {
+            tower[built] = pool_.allocate();
+        }
+    } catch(...) {
+        height = built;
+    }
+    for(; levels_ < height; ++levels_) {
+        // Empty level, the head spans the list as it was before the insert
+        heads_[levels_] = Entry {nullptr, nullptr, nullptr, nullptr, size};
+    }
+
+    const size_type target {index + 1};
+    size_type rank {0};
+    Entry* at {nullptr};
+    for(size_type level {levels_}; level-- > 0;) {
+        at = (at && at->node_) ? at->down_ : &heads_[level];
+        while(at->right_ && rank + at->width_ < target) {
+            rank += at->width_;
+            at = at->right_;
+        }
+        if(level < height) {
+            // Everything behind the new node moved one step to the right
+            tower[level] = std::construct_at(tower[level], Entry {
+                node, at->right_, level > 0 ? tower[level - 1] : nullptr,
+                level + 1 < height ? tower[level + 1] : nullptr,
+                rank + at->width_ + 1 - target});
+            at->right_ = tower[level];
+            at->width_ = target - rank;
+        } else {
+            ++at->width_;
+        }
+    }
+    node->entry_ = height > 0 ? tower[0] : nullptr;
+}
+
+template<class Node>
+void SkipIndex<Node>::erase(Node* node, size_type index) noexcept {
+    const size_type target {index + 1};
+    size_type rank {0};
+    Entry* at {nullptr};
+    for(size_type level {levels_}; level-- > 0;) {
+        at = (at && at->node_) ? at->down_ : &heads_[level];
+        while(at->right_ && rank + at->width_ < target) {
+            rank += at->width_;
+            at = at->right_;
+        }
+        Entry* right {at->right_};
+        if(right && right->node_ == node) {
+            at->width_ += right->width_ - 1;
+            at->right_ = right->right_;
+            pool_.deallocate(right);
+        } else {
+            --at->width_;
+        }
+    }
+    while(levels_ > 0 && !heads_[levels_ - 1].right_) {
+        --levels_;
+    }
+    node->entry_ = nullptr;
+}
+
+// Every 4th node gets a level, every 16th two levels and so on
+template<class Node>
+void SkipIndex<Node>::rebuild(Node* first, size_type size) noexcept {
+    clear();
+    for(Node* node {first}; node; node = node->next_) {
+        node->entry_ = nullptr;
+    }
+    std::array<Entry*, kMaxLevel> last {};
+    std::array<size_type, kMaxLevel> last_rank {};
+    try {
+        size_type rank {0};
+        for(Node* node {first}; node; node = node->next_) {
+            ++rank;
+            const size_type height {std::min<size_type>(std::countr_zero(rank) / 2, kMaxLevel)};
+            Entry* below {nullptr};
+            for(size_type level {0}; level < height; ++level) {
+                Entry* entry {std::construct_at(pool_.allocate(), Entry {node, nullptr, below, nullptr, 0})};
+                if(level == levels_) {
+                    heads_[level] = Entry {};
+                    last[level] = &heads_[level];
+                    last_rank[level] = 0;
+                    ++levels_;
+                }
+                if(below) {
+                    below->up_ = entry;
+                } else {
+                    node->entry_ = entry;
+                }
+                last[level]->right_ = entry;
+                last[level]->width_ = rank - last_rank[level];
+                last[level] = entry;
+                last_rank[level] = rank;
+                below = entry;
+            }
+        }
+        for(size_type level {0}; level < levels_; ++level) {
+            last[level]->width_ = size + 1 - last_rank[level];
+        }
+    } catch(...) {
+        // Without entries every lookup walks the list, but stays correct
+        clear();
+        for(Node* node {first}; node; node = node->next_) {
+            node->entry_ = nullptr;
+        }
+    }
+}
+
+template<class Node>
+void SkipIndex<Node>::clear() noexcept {
+    pool_.release();
+    levels_ = 0;
+}
+
+template<class Node>
+SkipIndex<Node>::size_type SkipIndex<Node>::levels() const noexcept {
+    return levels_;
+}
+
+// xorshift64, the number of trailing zero bit pairs is the height
+template<class Node>
+SkipIndex<Node>::size_type SkipIndex<Node>::randomHeight() noexcept {
+    random_ ^= random_ << 13;
+    random_ ^= random_ >> 7;
+    random_ ^= random_ << 17;
+    const size_type height {static_cast<size_type>(std::countr_zero(random_)) / 2};
+    return std::min({height, levels_ + 1, kMaxLevel});
+}
+
+template<class Node>
+void swap(SkipIndex<Node>& first, SkipIndex<Node>& second) noexcept {
+    using std::swap;
+
+    swap(first.heads_, second.heads_);
+    swap(first.levels_, second.levels_);
+    swap(first.random_, second.random_);
+    swap(first.pool_, second.pool_);
+}
+
+}
+
+#endif //DS_SKIPINDEX_HPP
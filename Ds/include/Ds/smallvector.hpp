@@ -0,0 +1,693 @@
+#ifndef SMALLVECTOR_HPP
+#define SMALLVECTOR_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "concepts.hpp"
+#include "vectorclass.hpp"
+
+namespace ds {
+
+// Vector with the interface of VectorClass which keeps up to 'N' elements
+// in a buffer inside of the object. The allocator only gets used once the
+// elements do not fit anymore. Moving an inline vector moves its elements,
+// so unlike with VectorClass iterators do not survive a move.
+template<class T, std::size_t N, class Allocator = std::allocator<T>, GrowthPolicy Growth = DoublingGrowth>
+class SmallVector {
+    static_assert(N > 0, "Use VectorClass without inline elements");
+
+// Type aliases
+public:
+    using value_type = T;
+    using allocator = Allocator;
+    using traits_t = std::allocator_traits<allocator>;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using iterator = pointer;
+    using const_iterator = const_pointer;
+    using size_type = traits_t::size_type;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    using growth_policy = Growth;
+
+    static constexpr size_type inline_capacity {N};
+
+private:
+    size_type size_ {0};
+    size_type capacity_ {N};
+    [[no_unique_address]] allocator alloc_ {};
+    pointer array_ {inlineData()};
+    alignas(T) std::byte inline_[N * sizeof(T)];
+
+public:
+    // Constructors and Desctructor
+    SmallVector() noexcept {}
+    explicit SmallVector(const Allocator& alloc) noexcept;
+    SmallVector(size_type size, const T& value=T{}, const Allocator& alloc = Allocator());
+    SmallVector(const SmallVector& other);
+    SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>);
+    SmallVector(std::initializer_list<T> l, const Allocator& alloc = Allocator());
+    template<class InputIt>
+    requires is_it<InputIt>
+    SmallVector(InputIt first, InputIt last, const Allocator& alloc = Allocator());
+    ~SmallVector();
+
+    // Overloading assignment operator
+    SmallVector& operator=(const SmallVector& other);
+    SmallVector& operator=(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>);
+    SmallVector& operator=(std::initializer_list<T> l);
+
+    // Assign
+    void assign(size_type count, const T& value);
+    template<class InputIt>
+    requires is_it<InputIt>
+    void assign(InputIt first, InputIt last);
+    void assign(std::initializer_list<T> l);
+
+    // Length and capacity
+    constexpr bool empty() const noexcept;
+    constexpr size_type size() const noexcept;
+    constexpr size_type capacity() const noexcept;
+    // True while the elements live in the inline buffer
+    bool is_inline() const noexcept;
+    void reserve(size_type new_cap);
+    // Moves the elements back into the inline buffer if they fit
+    void shrink_to_fit();
+    void resize(size_type count, const value_type& value=T{});
+    // Same as in VectorClass, new elements get default initialized
+    void resize(size_type count, default_init_t);
+    void resize_uninitialized(size_type count) requires std::is_trivial_v<T>;
+
+    // Modifiers
+    void push_back(const T& value);
+    void push_back(T&& value);
+    template<class... Args>
+    reference emplace_back(Args&&... args);
+    template< class... Args >
+    iterator emplace(const_iterator pos, Args&&... args) {
+        return insert(pos, value_type(std::forward<Args>(args)...));
+    }
+    // Keeps the buffer
+    void clear() noexcept;
+    iterator insert(const_iterator pos, const T& value);
+    iterator insert(const_iterator pos, T&& value);
+    iterator insert(const_iterator pos, size_type count, const T& value);
+    template<class InputIt>
+    requires is_it<InputIt>
+    iterator insert(const_iterator pos, InputIt first, InputIt last);
+    iterator insert(const_iterator pos, std::initializer_list<T> ilist);
+    iterator erase(const_iterator pos);
+    iterator erase(const_iterator first, const_iterator last);
+    iterator unordered_erase(const_iterator pos);
+    void pop_back();
+    void swap(SmallVector& other);
+
+    // Pointers to first and last element
+    constexpr iterator begin() noexcept;
+    constexpr const_iterator begin() const noexcept;
+    constexpr const_iterator cbegin() const noexcept;
+    constexpr iterator end() noexcept;
+    constexpr const_iterator end() const noexcept;
+    constexpr const_iterator cend() const noexcept;
+
+    constexpr reverse_iterator rbegin() noexcept;
+    constexpr const_reverse_iterator rbegin() const noexcept;
+    constexpr const_reverse_iterator crbegin() const noexcept;
+    constexpr reverse_iterator rend() noexcept;
+    constexpr const_reverse_iterator rend() const noexcept;
+    constexpr const_reverse_iterator crend() const noexcept;
+
+    // Element access
+    constexpr reference front();
+    constexpr const_reference front() const;
+    constexpr reference back();
+    constexpr const_reference back() const;
+    pointer data() noexcept;
+    const_pointer data() const noexcept;
+    reference operator[] (const size_type index);
+    const_reference operator[] (const size_type index) const;
+    reference at(const size_type index);
+    const_reference at(const size_type index) const;
+
+    // Get allocator
+    constexpr allocator get_allocator() const noexcept;
+
+private:
+    pointer inlineData() noexcept;
+    void destroyAll() noexcept;
+    // Gives a heap buffer back, the elements have to be gone already
+    void releaseHeap() noexcept;
+    // Moves the elements into a heap buffer of 'new_cap' elements, or into
+    // the inline buffer if 'new_cap' is at most N
+    void reallocate(size_type new_cap);
+    size_type grownCapacity(size_type required) const noexcept;
+    // Same as in VectorClass, the ranges may overlap
+    void relocate(pointer dst, pointer src, size_type count);
+    pointer openGap(size_type index, size_type count);
+    template<class F>
+    iterator insertGap(const_iterator pos, size_type count, F&& construct);
+    // Takes the elements of 'other', 'this' has to be empty and inline
+    void steal(SmallVector& other);
+    // Appends 'count' elements in a constructor, 'append' emplaces one. Gives
+    // everything back if an element throws, no destructor runs then.
+    template<class F>
+    void initialize(size_type count, F&& append);
+};
+
+template<class T, std::size_t N, class Allocator, GrowthPolicy Growth>
+SmallVector<T, N, Allocator, Growth>::SmallVector(const Allocator& alloc) noexcept: alloc_ {alloc} {}
+
+template<class T, std::size_t N, class Allocator, GrowthPolicy Growth>
+SmallVector<T, N, Allocator, Growth>::SmallVector(size_type size, const T& value, const Allocator& alloc): alloc_ {alloc} {
+    initialize(size, [&]() { emplace_back(value); });
+}
+
+template<class T, std::size_t N, class Allocator, GrowthPolicy Growth>
+SmallVector<T, N, Allocator, Growth>::SmallVector(const SmallVector& other): alloc_ {traits_t::select_on_container_copy_construction(other.alloc_)} {
+    initialize(other.size_, [&, it = other.begin()]() mutable { emplace_back(*it++); });
+}
+
+template<class T, std::size_t N, class Allocator, GrowthPolicy Growth>
+SmallVector<T, N, Allocator, Growth>::SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>): alloc_ {std::move(other.alloc_)} {
+    steal(other);
+}
+
+template<class T, std::size_t N, class Allocator, GrowthPolicy Growth>
+SmallVector<T, N, Allocator, Growth>::SmallVector(std::initializer_list<T> l, const Allocator& alloc): alloc_ {alloc} {
+    initialize(l.size(), [&, it = l.begin()]() mutable { emplace_back(*it++); });
+}
+
+template<class T, std::size_t N, class Allocator, GrowthPolicy Growth>
+template<class InputIt>
+requires is_it<InputIt>
+SmallVector<T, N, Allocator, Growth>::SmallVector(InputIt first, InputIt last, const Allocator& alloc): alloc_ {alloc} {
+    initialize(static_cast<size_type>(std::distance(first, last)), [&]() { emplace_back(*first++); });
+}
+
+template<class T, std::size_t N, class Allocator, GrowthPolicy Growth>
+SmallVector<T, N, Allocator, Growth>::~SmallVector() {
+    destroyAll();
+    releaseHeap();
+}
+
+template<class T, std::size_t N, class Allocator, GrowthPolicy Growth>
+SmallVector<T, N, Allocator, Growth>& SmallVector<T, N, Allocator, Growth>::operator=(const SmallVector& other) {
+    if(&other != this) {
+        assign(other.begin(), other.end());
+    }
+    return *this;
+}
+
+template<class T, std::size_t N, class Allocator, GrowthPolicy Growth>
+SmallVector<T, N, Allocator, Growth>& SmallVector<T, N, Allocator, Growth>::operator=(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+    if(&other != this) {
+        destroyAll();
+        releaseHeap();
+        steal(other);
+    }
+    return *this;
+}
+
+template<class T, std::size_t N, class Allocator, GrowthPolicy Growth>
+SmallVector<T, N, Allocator, Growth>& SmallVector<T, N, Allocator, Growth>::operator=(std::initializer_list<T> l) {
+    assign(l.begin(), l.end());
+    return *this;
+}
+
+template<class T, std::size_t N, class Allocator, GrowthPolicy Growth>
+void SmallVector<T, N, Allocator, Growth>::assign(size_type count, const T& value) {
+    clear();
+    insert(cend(), count, value);
+}
+
+template<class T, std::size_t N, class Allocator, GrowthPolicy Growth>
+template<class InputIt>
+requires is_it<InputIt>
+void SmallVector<T, N, Allocator, Growth>::assign(InputIt first, InputIt last) {
+    clear();
+    insert(cend(), first, last);
+}
+
+template<class T, std::size_t N, class Allocator, GrowthPolicy Growth>
+void SmallVector<T, N, Allocator, Growth>::assign(std::initializer_list<T> l) {
+    assign(l.begin(), l.end());
+}
+
+template<class T, std::size_t N, class Allocator, GrowthPolicy Growth>
+constexpr bool SmallVector<T, N, Allocator, Growth>::empty() const noexcept {
+    return size_ == 0;
+}
+
+template<class T, std::size_t N, class Allocator, GrowthPolicy Growth>
+constexpr SmallVector<T, N, Allocator, Growth>::size_type SmallVector<T, N, Allocator, Growth>::size() const noexcept {
+    return size_;
+}
+
+template<class T, std::size_t N, class Allocator, GrowthPolicy Growth>
+constexpr SmallVector<T, N, Allocator, Growth>::size_type SmallVector<T, N, Allocator, Growth>::capacity() const noexcept {
+    return capacity_;
+}
+
+template<class T, std::size_t N, class Allocator, GrowthPolicy Growth>
+bool SmallVector<T, N, Allocator, Growth>::is_inline() const noexcept {
+    return array_ == reinterpret_cast<const_pointer>(inline_);
+}
+
+template<class T, std::size_t N, class Allocator, GrowthPolicy Growth>
+void SmallVector<T, N, Allocator, Growth>::reserve(size_type new_cap) {
+    if(new_cap > capacity_) {
+        reallocate(new_cap);
+    }
+}
+
+template<class T, std::size_t N, class Allocator, GrowthPolicy Growth>
+void SmallVector<T, N, Allocator, Growth>::shrink_to_fit() {
+    if(!is_inline() && size_ < capacity_) {
+        reallocate(size_);
+    }
+}
+
+template<class T, std::size_t N, class Allocator, GrowthPolicy Growth>
+void SmallVector<T, N, Allocator, Growth>::resize(size_type count, const value_type& value) {
+    if(count < size_) {
+        erase(cbegin() + count, cend());
+    } else {
+        insert(cend(), count - size_, value);
+    }
+}
+
+template<class T, std::size_t N, class Allocator, GrowthPolicy Growth>
+void SmallVector<T, N, Allocator, Growth>::resize(size_type count, default_init_t) {
+    if(count < size_) {
+        erase(cbegin() + count, cend());
+        return;
+    }
+    if(count > capacity_) {
+        reallocate(grownCapacity(count));
+    }
+    for(; size_ < count; ++size_) {
+        ::new(static_cast<void*>(array_ + size_)) T;
+    }
+}
+
+template<class T, std::size_t N, class Allocator, GrowthPolicy Growth>
+void SmallVector<T, N, Allocator, Growth>::resize_uninitialized(size_type count) requires std::is_trivial_v<T> {
+    resize(count, default_init);
+}
+
+template<class T, std::size_t N, class Allocator, GrowthPolicy Growth>
+void SmallVector<T, N, Allocator, Growth>::push_back(const T& value) {
+    emplace_back(value);
+}
+
+template<class T, std::size_t N, class Allocator, GrowthPolicy Growth>
+void SmallVector<T, N, Allocator, Growth>::push_back(T&& value) {
+    emplace_back(std::move(value));
+}
+
+// The new element gets constructed before the old ones move, 'args' may
+// refer to one of them
+template<class T, std::size_t N, class Allocator, GrowthPolicy Growth>
+template<class... Args>
+SmallVector<T, N, Allocator, Growth>::reference SmallVector<T, N, Allocator, Growth>::emplace_back(Args&&... args) {
+    if(size_ < capacity_) {
+        traits_t::construct(alloc_, array_ + size_, std::forward<Args>(args)...);
+    } else {
+        size_type new_cap {grownCapacity(size_ + 1)};
+        pointer new_arr {traits_t::allocate(alloc_, new_cap)};
+        try {
+            traits_t::construct(alloc_, new_arr + size_, std::forward<Args>(args)...);
+        } catch(...) {
+            traits_t::deallocate(alloc_, new_arr, new_cap);
+            throw;
+        }
+        relocate(new_arr, array_, size_);
+        releaseHeap();
+        array_ = new_arr;
+        capacity_ = new_cap;
+    }
+    return array_[size_++];
+}
+
+template<class T, std::size_t N, class Allocator, GrowthPolicy Growth>
+void SmallVector<T, N, Allocator, Growth>::clear() noexcept {
+    destroyAll();
+    size_ = 0;
+}
+
+template<class T, std::size_t N, class Allocator, GrowthPolicy Growth>
+SmallVector<T, N, Allocator, Growth>::iterator SmallVector<T, N, Allocator, Growth>::insert(const_iterator pos, const T& value) {
+    value_type copy(value);
+    return insert(pos, std::move(copy));
+}
+
+template<class T, std::size_t N, class Allocator, GrowthPolicy Growth>
+SmallVector<T, N, Allocator, Growth>::iterator SmallVector<T, N, Allocator, Growth>::insert(const_iterator pos, T&& value) {
+    return insertGap(pos, 1, [&](pointer slot) {
+        traits_t::construct(alloc_, slot, std::move(value));
+    });
+}
+
+template<class T, std::size_t N, class Allocator, GrowthPolicy Growth>
+SmallVector<T, N, Allocator, Growth>::iterator SmallVector<T, N, Allocator, Growth>::insert(const_iterator pos, size_type count, const T& value) {
+    value_type copy(value);
+    return insertGap(pos, count, [&](pointer slot) {
+        traits_t::construct(alloc_, slot, copy);
+    });
+}
+
+template<class T, std::size_t N, class Allocator, GrowthPolicy Growth>
+template<class InputIt>
+requires is_it<InputIt>
+SmallVector<T, N, Allocator, Growth>::iterator SmallVector<T, N, Allocator, Growth>::insert(const_iterator pos, InputIt first, InputIt last) {
+    const size_type count = std::distance(first, last);
+    return insertGap(pos, count, [&](pointer slot) {
+        traits_t::construct(alloc_, slot, *first);
+        ++first;
+    });
+}
+
+template<class T, std::size_t N, class Allocator, GrowthPolicy Growth>
+SmallVector<T, N, Allocator, Growth>::iterator SmallVector<T, N, Allocator, Growth>::insert(const_iterator pos, std::initializer_list<T> iList) {
+    return insert(pos, iList.begin(), iList.end());
+}
+
+template<class T, std::size_t N, class Allocator, GrowthPolicy Growth>
+SmallVector<T, N, Allocator, Growth>::iterator SmallVector<T, N, Allocator, Growth>::erase(const_iterator pos) {
+    if(!((pos >= begin()) and (pos < end()))) {
+        throw std::out_of_range("Iterator is out of bounds!");
+    }
+    return erase(pos, pos + 1);
+}
+
+template<class T, std::size_t N, class Allocator, GrowthPolicy Growth>
+SmallVector<T, N, Allocator, Growth>::iterator SmallVector<T, N, Allocator, Growth>::erase(const_iterator first, const_iterator last) {
+    if(!((first >= begin()) and (first <= last) and (last <= end()))) {
+        throw std::out_of_range("Iterator is out of bounds!");
+    }
+    iterator it = begin() + std::distance(cbegin(), first);
+    size_type count = std::distance(first, last);
+    for(size_type i {0}; i < count; ++i) {
+        traits_t::destroy(alloc_, it + i);
+    }
+    relocate(it, it + count, std::distance(it + count, end()));
+    size_ -= count;
+    return it;
+}
+
+template<class T, std::size_t N, class Allocator, GrowthPolicy Growth>
+SmallVector<T, N, Allocator, Growth>::iterator SmallVector<T, N, Allocator, Growth>::unordered_erase(const_iterator pos) {
+    if(!((pos >= begin()) and (pos < end()))) {
+        throw std::out_of_range("Iterator is out of bounds!");
+    }
+    iterator it = begin() + std::distance(cbegin(), pos);
+    if(it != end() - 1) {
+        *it = std::move(back());
+    }
+    pop_back();
+    return it;
+}
+
+template<class T, std::size_t N, class Allocator, GrowthPolicy Growth>
+void SmallVector<T, N, Allocator, Growth>::pop_back() {
+    if(size_ == 0) {
+        return;
+    }
+    traits_t::destroy(alloc_, array_ + (--size_));
+}
+
+template<class T, std::size_t N, class Allocator, GrowthPolicy Growth>
+void SmallVector<T, N, Allocator, Growth>::swap(SmallVector& other) {
+    SmallVector tmp(std::move(other));
+    other = std::move(*this);
+    *this = std::move(tmp);
+}
+
+template<class T, std::size_t N, class Allocator, GrowthPolicy Growth>
+constexpr SmallVector<T, N, Allocator, Growth>::iterator SmallVector<T, N, Allocator, Growth>::begin() noexcept {
+    return array_;
+}
+
+template<class T, std::size_t N, class Allocator, GrowthPolicy Growth>
+constexpr SmallVector<T, N, Allocator, Growth>::const_iterator SmallVector<T, N, Allocator, Growth>::begin() const noexcept {
+    return array_;
+}
+
+template<class T, std::size_t N, class Allocator, GrowthPolicy Growth>
+constexpr SmallVector<T, N, Allocator, Growth>::const_iterator SmallVector<T, N, Allocator, Growth>::cbegin() const noexcept {
+    return array_;
+}
+
+template<class T, std::size_t N, class Allocator, GrowthPolicy Growth>
+constexpr SmallVector<T, N, Allocator, Growth>::iterator SmallVector<T, N, Allocator, Growth>::end() noexcept {
+    return array_ + size_;
+}
+
+template<class T, std::size_t N, class Allocator, GrowthPolicy Growth>
+constexpr SmallVector<T, N, Allocator, Growth>::const_iterator SmallVector<T, N, Allocator, Growth>::end() const noexcept {
+    return array_ + size_;
+}
+
+template<class T, std::size_t N, class Allocator, GrowthPolicy Growth>
+constexpr SmallVector<T, N, Allocator, Growth>::const_iterator SmallVector<T, N, Allocator, Growth>::cend() const noexcept {
+    return array_ + size_;
+}
+
+template<class T, std::size_t N, class Allocator, GrowthPolicy Growth>
+constexpr SmallVector<T, N, Allocator, Growth>::reverse_iterator SmallVector<T, N, Allocator, Growth>::rbegin() noexcept {
+    return reverse_iterator(end());
+}
+
+template<class T, std::size_t N, class Allocator, GrowthPolicy Growth>
+constexpr SmallVector<T, N, Allocator, Growth>::const_reverse_iterator SmallVector<T, N, Allocator, Growth>::rbegin() const noexcept {
+    return const_reverse_iterator(end());
+}
+
+template<class T, std::size_t N, class Allocator, GrowthPolicy Growth>
+constexpr SmallVector<T, N, Allocator, Growth>::const_reverse_iterator SmallVector<T, N, Allocator, Growth>::crbegin() const noexcept {
+    return const_reverse_iterator(end());
+}
+
+template<class T, std::size_t N, class Allocator, GrowthPolicy Growth>
+constexpr SmallVector<T, N, Allocator, Growth>::reverse_iterator SmallVector<T, N, Allocator, Growth>::rend() noexcept {
+    return reverse_iterator(begin());
+}
+
+template<class T, std::size_t N, class Allocator, GrowthPolicy Growth>
+constexpr SmallVector<T, N, Allocator, Growth>::const_reverse_iterator SmallVector<T, N, Allocator, Growth>::rend() const noexcept {
+    return const_reverse_iterator(begin());
+}
+
+template<class T, std::size_t N, class Allocator, GrowthPolicy Growth>
+constexpr SmallVector<T, N, Allocator, Growth>::const_reverse_iterator SmallVector<T, N, Allocator, Growth>::crend() const noexcept {
+    return const_reverse_iterator(begin());
+}
+
+template<class T, std::size_t N, class Allocator, GrowthPolicy Growth>
+constexpr SmallVector<T, N, Allocator, Growth>::reference SmallVector<T, N, Allocator, Growth>::front() {
+    return array_[0];
+}
+
+template<class T, std::size_t N, class Allocator, GrowthPolicy Growth>
+constexpr SmallVector<T, N, Allocator, Growth>::const_reference SmallVector<T, N, Allocator, Growth>::front() const {
+    return array_[0];
+}
+
+template<class T, std::size_t N, class Allocator, GrowthPolicy Growth>
+constexpr SmallVector<T, N, Allocator, Growth>::reference SmallVector<T, N, Allocator, Growth>::back() {
+    return array_[size_ - 1];
+}
+
+template<class T, std::size_t N, class Allocator, GrowthPolicy Growth>
+constexpr SmallVector<T, N, Allocator, Growth>::const_reference SmallVector<T, N, Allocator, Growth>::back() const {
+    return array_[size_ - 1];
+}
+
+template<class T, std::size_t N, class Allocator, GrowthPolicy Growth>
+SmallVector<T, N, Allocator, Growth>::pointer SmallVector<T, N, Allocator, Growth>::data() noexcept {
+    return array_;
+}
+
+template<class T, std::size_t N, class Allocator, GrowthPolicy Growth>
+SmallVector<T, N, Allocator, Growth>::const_pointer SmallVector<T, N, Allocator, Growth>::data() const noexcept {
+    return array_;
+}
+
+template<class T, std::size_t N, class Allocator, GrowthPolicy Growth>
+SmallVector<T, N, Allocator, Growth>::reference SmallVector<T, N, Allocator, Growth>::operator[] (const size_type index) {
+    return array_[index];
+}
+
+template<class T, std::size_t N, class Allocator, GrowthPolicy Growth>
+SmallVector<T, N, Allocator, Growth>::const_reference SmallVector<T, N, Allocator, Growth>::operator[] (const size_type index) const {
+    return array_[index];
+}
+
+template<class T, std::size_t N, class Allocator, GrowthPolicy Growth>
+SmallVector<T, N, Allocator, Growth>::reference SmallVector<T, N, Allocator, Growth>::at(const size_type index) {
+    if(!(index < size_))
+        throw std::out_of_range("Index out of range");
+    return array_[index];
+}
+
+template<class T, std::size_t N, class Allocator, GrowthPolicy Growth>
+SmallVector<T, N, Allocator, Growth>::const_reference SmallVector<T, N, Allocator, Growth>::at(const size_type index) const {
+    if(!(index < size_))
+        throw std::out_of_range("Index out of range");
+    return array_[index];
+}
+
+template<class T, std::size_t N, class Allocator, GrowthPolicy Growth>
+constexpr SmallVector<T, N, Allocator, Growth>::allocator SmallVector<T, N, Allocator, Growth>::get_allocator() const noexcept {
+    return alloc_;
+}
+
+template<class T, std::size_t N, class Allocator, GrowthPolicy Growth>
+SmallVector<T, N, Allocator, Growth>::pointer SmallVector<T, N, Allocator, Growth>::inlineData() noexcept {
+    return reinterpret_cast<pointer>(inline_);
+}
+
+template<class T, std::size_t N, class Allocator, GrowthPolicy Growth>
+void SmallVector<T, N, Allocator, Growth>::destroyAll() noexcept {
+    for(size_type i {size_}; i > 0; --i) {
+        traits_t::destroy(alloc_, array_ + (i - 1));
+    }
+}
+
+template<class T, std::size_t N, class Allocator, GrowthPolicy Growth>
+void SmallVector<T, N, Allocator, Growth>::releaseHeap() noexcept {
+    if(!is_inline()) {
+        traits_t::deallocate(alloc_, array_, capacity_);
+        array_ = inlineData();
+        capacity_ = N;
+    }
+}
+
+template<class T, std::size_t N, class Allocator, GrowthPolicy Growth>
+void SmallVector<T, N, Allocator, Growth>::reallocate(size_type new_cap) {
+    if(new_cap <= N) {
+        if(!is_inline()) {
+            pointer heap {array_};
+            size_type heap_capacity {capacity_};
+            relocate(inlineData(), heap, size_);
+            traits_t::deallocate(alloc_, heap, heap_capacity);
+            array_ = inlineData();
+            capacity_ = N;
+        }
+        return;
+    }
+    pointer new_arr {traits_t::allocate(alloc_, new_cap)};
+    relocate(new_arr, array_, size_);
+    releaseHeap();
+    array_ = new_arr;
+    capacity_ = new_cap;
+}
+
+template<class T, std::size_t N, class Allocator, GrowthPolicy Growth>
+SmallVector<T, N, Allocator, Growth>::size_type SmallVector<T, N, Allocator, Growth>::grownCapacity(size_type required) const noexcept {
+    return std::max(required, static_cast<size_type>(Growth::grow(capacity_, required, sizeof(T))));
+}
+
+template<class T, std::size_t N, class Allocator, GrowthPolicy Growth>
+void SmallVector<T, N, Allocator, Growth>::relocate(pointer dst, pointer src, size_type count) {
+    if constexpr(is_trivially_relocatable_v<T>) {
+        if(count > 0) {
+            std::memmove(static_cast<void*>(dst), src, count * sizeof(T));
+        }
+    } else if(dst < src) {
+        for(size_type i {0}; i < count; ++i) {
+            traits_t::construct(alloc_, dst + i, std::move(src[i]));
+            traits_t::destroy(alloc_, src + i);
+        }
+    } else {
+        for(size_type i {count}; i > 0; --i) {
+            traits_t::construct(alloc_, dst + (i - 1), std::move(src[i - 1]));
+            traits_t::destroy(alloc_, src + (i - 1));
+        }
+    }
+}
+
+template<class T, std::size_t N, class Allocator, GrowthPolicy Growth>
+SmallVector<T, N, Allocator, Growth>::pointer SmallVector<T, N, Allocator, Growth>::openGap(size_type index, size_type count) {
+    if(size_ + count <= capacity_) {
+        relocate(array_ + index + count, array_ + index, size_ - index);
+    } else {
+        size_type new_cap {grownCapacity(size_ + count)};
+        pointer new_arr {traits_t::allocate(alloc_, new_cap)};
+        relocate(new_arr, array_, index);
+        relocate(new_arr + index + count, array_ + index, size_ - index);
+        releaseHeap();
+        array_ = new_arr;
+        capacity_ = new_cap;
+    }
+    return array_ + index;
+}
+
+template<class T, std::size_t N, class Allocator, GrowthPolicy Growth>
+template<class F>
+SmallVector<T, N, Allocator, Growth>::iterator SmallVector<T, N, Allocator, Growth>::insertGap(const_iterator pos, size_type count, F&& construct) {
+    if(!((pos >= begin()) and (pos <= end()))) {
+        throw std::out_of_range("Iterator is out of bounds!");
+    }
+    size_type index = std::distance(cbegin(), pos);
+    if(count == 0) {
+        return begin() + index;
+    }
+    pointer gap {openGap(index, count)};
+    size_type done {0};
+    try {
+        for(; done < count; ++done) {
+            construct(gap + done);
+        }
+    } catch(...) {
+        while(done > 0) {
+            traits_t::destroy(alloc_, gap + (--done));
+        }
+        relocate(gap, gap + count, size_ - index);
+        throw;
+    }
+    size_ += count;
+    return gap;
+}
+
+template<class T, std::size_t N, class Allocator, GrowthPolicy Growth>
+void SmallVector<T, N, Allocator, Growth>::steal(SmallVector& other) {
+    if(other.is_inline()) {
+        relocate(inlineData(), other.array_, other.size_);
+    } else {
+        array_ = std::exchange(other.array_, other.inlineData());
+        capacity_ = std::exchange(other.capacity_, N);
+    }
+    size_ = std::exchange(other.size_, 0);
+}
+
+template<class T, std::size_t N, class Allocator, GrowthPolicy Growth>
+template<class F>
+void SmallVector<T, N, Allocator, Growth>::initialize(size_type count, F&& append) {
+    if(count > capacity_) {
+        reallocate(grownCapacity(count));
+    }
+    try {
+        for(size_type i {0}; i < count; ++i) {
+            append();
+        }
+    } catch(...) {
+        destroyAll();
+        releaseHeap();
+        throw;
+    }
+}
+
+}
+#endif // SMALLVECTOR_HPP
@@ -0,0 +1,616 @@
+#ifndef SOAVECTOR_HPP
+#define SOAVECTOR_HPP
+
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "Tuple/tuple.hpp"
+#include "vectorclass.hpp"
+
+namespace ds {
+
+template<class... Ts>
+class SoAVector;
+
+// Reference to one row of a SoAVector. Looks like a ds::Tuple of
+// references: get<I>() and ds::get<I>(ref) return the field in its column,
+// assigning a Tuple writes every field.
+template<bool IsConst, class... Ts>
+class SoAReference {
+public:
+    using owner_type = std::conditional_t<IsConst, const SoAVector<Ts...>, SoAVector<Ts...>>;
+    using size_type = std::size_t;
+
+    SoAReference(const SoAReference& other) = default;
+    // reference converts to const_reference
+    template<bool OtherConst>
+    requires (IsConst && !OtherConst)
+    SoAReference(const SoAReference<OtherConst, Ts...>& other): owner_ {other.owner_}, index_ {other.index_} {}
+
+    template<std::size_t I>
+    auto& get() const { return owner_->template data<I>()[index_]; }
+
+    // Copies the fields into a Tuple
+    Tuple<Ts...> to_tuple() const;
+
+    // Assign the fields, not the reference
+    const SoAReference& operator=(const SoAReference& other) const requires (!IsConst);
+    const SoAReference& operator=(const Tuple<Ts...>& value) const requires (!IsConst);
+    const SoAReference& operator=(Tuple<Ts...>&& value) const requires (!IsConst);
+
+    friend void swap(const SoAReference& a, const SoAReference& b) requires (!IsConst) {
+        [&]<std::size_t... I>(std::index_sequence<I...>) {
+            using std::swap;
+            (swap(a.template get<I>(), b.template get<I>()), ...);
+        }(std::index_sequence_for<Ts...>{});
+    }
+
+private:
+    SoAReference(owner_type* owner, size_type index): owner_ {owner}, index_ {index} {}
+
+    owner_type* owner_;
+    size_type index_;
+
+    template<bool, class...>
+    friend class SoAReference;
+    friend class SoAVector<Ts...>;
+};
+
+template<std::size_t index, bool IsConst, class... Ts>
+auto& get(const SoAReference<IsConst, Ts...>& ref) {
+    return ref.template get<index>();
+}
+
+// Vector of rows which stores every field of the row in its own array, so a
+// scan over one field only reads that field. All columns live in one
+// buffer, every column starts on a kColumnAlignment boundary.
+// Growing moves the columns one after another, so the fields have to be
+// nothrow move constructible.
+template<class... Ts>
+class SoAVector {
+public:
+    static constexpr std::size_t kColumnAlignment {64};
+
+    static_assert(sizeof...(Ts) > 0, "SoAVector needs at least one column");
+    static_assert(((alignof(Ts) <= kColumnAlignment) && ...), "Columns are only aligned to kColumnAlignment");
+    static_assert((std::is_nothrow_move_constructible_v<Ts> && ...), "Columns are moved one after another while growing");
+
+private:
+    template<bool IsConst>
+    class Iterator;
+
+// Type aliases
+public:
+    using value_type = Tuple<Ts...>;
+    using reference = SoAReference<false, Ts...>;
+    using const_reference = SoAReference<true, Ts...>;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+    template<std::size_t I>
+    using column_type = ExtractTypeAt_t<I, Ts...>;
+
+private:
+    using indices = std::index_sequence_for<Ts...>;
+
+    std::byte* buffer_ {nullptr};
+    Tuple<Ts*...> columns_ {static_cast<Ts*>(nullptr)...};
+    size_type size_ {0};
+    size_type capacity_ {0};
+
+public:
+    // Constructors and Desctructor
+    SoAVector() = default;
+    explicit SoAVector(size_type size);
+    SoAVector(const SoAVector& other);
+    SoAVector(SoAVector&& other) noexcept;
+    ~SoAVector();
+
+    // Overloading assignment operator
+    SoAVector& operator=(const SoAVector& other);
+    SoAVector& operator=(SoAVector&& other) noexcept;
+
+    // Length and capacity
+    bool empty() const noexcept;
+    size_type size() const noexcept;
+    size_type capacity() const noexcept;
+    void reserve(size_type new_cap);
+    void shrink_to_fit();
+    void resize(size_type count);
+    void resize(size_type count, default_init_t);
+
+    // Columns. data<I>() is aligned to kColumnAlignment.
+    template<std::size_t I>
+    column_type<I>* data() noexcept;
+    template<std::size_t I>
+    const column_type<I>* data() const noexcept;
+    template<std::size_t I>
+    std::span<column_type<I>> column() noexcept;
+    template<std::size_t I>
+    std::span<const column_type<I>> column() const noexcept;
+
+    // Modifiers
+    void push_back(const value_type& value);
+    void push_back(value_type&& value);
+    // One argument per column
+    template<class... Args>
+    requires (sizeof...(Args) == sizeof...(Ts))
+    reference emplace_back(Args&&... fields);
+    void pop_back();
+    void clear() noexcept;
+    iterator erase(const_iterator pos);
+    iterator unordered_erase(const_iterator pos);
+    void swap(SoAVector& other) noexcept;
+
+    // Iterators, random access over proxy references
+    iterator begin() noexcept;
+    const_iterator begin() const noexcept;
+    const_iterator cbegin() const noexcept;
+    iterator end() noexcept;
+    const_iterator end() const noexcept;
+    const_iterator cend() const noexcept;
+
+    // Element access
+    reference front();
+    const_reference front() const;
+    reference back();
+    const_reference back() const;
+    reference operator[] (const size_type index);
+    const_reference operator[] (const size_type index) const;
+    reference at(const size_type index);
+    const_reference at(const size_type index) const;
+
+private:
+    static size_type columnBytes(size_type bytes) noexcept;
+    void reallocate(size_type new_cap);
+    // Constructs the rows [size_, count) column by column with
+    // 'init(column, first, last)', which has to clean up its own column if
+    // it throws
+    template<class Init>
+    void constructRows(size_type count, Init init);
+    void destroyRows(size_type first, size_type last) noexcept;
+};
+
+template<class... Ts>
+template<bool IsConst>
+class SoAVector<Ts...>::Iterator {
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using difference_type   = std::ptrdiff_t;
+    using value_type        = SoAVector::value_type;
+    using pointer           = void;
+    using reference         = std::conditional_t<IsConst, SoAVector::const_reference, SoAVector::reference>;
+
+    Iterator() = default;
+    // iterator converts to const_iterator
+    template<bool OtherConst>
+    requires (IsConst && !OtherConst)
+    Iterator(const Iterator<OtherConst>& other): owner_ {other.owner_}, index_ {other.index_} {}
+
+    reference operator*() const { return reference(owner_, index_); }
+    reference operator[](difference_type n) const { return reference(owner_, index_ + n); }
+
+    Iterator& operator++() { ++index_; return *this; }
+    Iterator operator++(int) { Iterator tmp = *this; ++index_; return tmp; }
+    Iterator& operator--() { --index_; return *this; }
+    Iterator operator--(int) { Iterator tmp = *this; --index_; return tmp; }
+    Iterator& operator+=(difference_type n) { index_ += n; return *this; }
+    Iterator& operator-=(difference_type n) { index_ -= n; return *this; }
+
+    friend Iterator operator+(Iterator it, difference_type n) { return it += n; }
+    friend Iterator operator+(difference_type n, Iterator it) { return it += n; }
+    friend Iterator operator-(Iterator it, difference_type n) { return it -= n; }
+    friend difference_type operator-(const Iterator& a, const Iterator& b) {
+        return static_cast<difference_type>(a.index_) - static_cast<difference_type>(b.index_);
+    }
+    friend bool operator==(const Iterator& a, const Iterator& b) { return a.index_ == b.index_; }
+    friend auto operator<=>(const Iterator& a, const Iterator& b) { return a.index_ <=> b.index_; }
+
+private:
+    using owner_type = std::conditional_t<IsConst, const SoAVector, SoAVector>;
+
+    Iterator(owner_type* owner, size_type index): owner_ {owner}, index_ {index} {}
+
+    owner_type* owner_ {nullptr};
+    size_type index_ {0};
+
+    template<bool>
+    friend class Iterator;
+    friend class SoAVector;
+};
+
+template<bool IsConst, class... Ts>
+Tuple<Ts...> SoAReference<IsConst, Ts...>::to_tuple() const {
+    return [&]<std::size_t... I>(std::index_sequence<I...>) {
+        return Tuple<Ts...> {Ts(get<I>())...};
+    }(std::index_sequence_for<Ts...>{});
+}
+
+template<bool IsConst, class... Ts>
+const SoAReference<IsConst, Ts...>& SoAReference<IsConst, Ts...>::operator=(const SoAReference& other) const requires (!IsConst) {
+    [&]<std::size_t... I>(std::index_sequence<I...>) {
+        ((get<I>() = other.template get<I>()), ...);
+    }(std::index_sequence_for<Ts...>{});
+    return *this;
+}
+
+template<bool IsConst, class... Ts>
+const SoAReference<IsConst, Ts...>& SoAReference<IsConst, Ts...>::operator=(const Tuple<Ts...>& value) const requires (!IsConst) {
+    [&]<std::size_t... I>(std::index_sequence<I...>) {
+        ((get<I>() = ds::get<I>(value)), ...);
+    }(std::index_sequence_for<Ts...>{});
+    return *this;
+}
+
+template<bool IsConst, class... Ts>
+const SoAReference<IsConst, Ts...>& SoAReference<IsConst, Ts...>::operator=(Tuple<Ts...>&& value) const requires (!IsConst) {
+    [&]<std::size_t... I>(std::index_sequence<I...>) {
+        ((get<I>() = std::move(ds::get<I>(value))), ...);
+    }(std::index_sequence_for<Ts...>{});
+    return *this;
+}
+
+template<class... Ts>
+SoAVector<Ts...>::SoAVector(size_type size) {
+    resize(size);
+}
+
+template<class... Ts>
+SoAVector<Ts...>::SoAVector(const SoAVector& other) {
+    reserve(other.size_);
+    constructRows(other.size_, [&other](auto column, auto first, auto last) {
+        const auto* source {other.template data<decltype(column)::value>()};
+        std::uninitialized_copy(source, source + (last - first), first);
+    });
+}
+
+template<class... Ts>
+SoAVector<Ts...>::SoAVector(SoAVector&& other) noexcept {
+    swap(other);
+}
+
+template<class... Ts>
+SoAVector<Ts...>::~SoAVector() {
+    clear();
+    if(buffer_) {
+        ::operator delete(buffer_, std::align_val_t {kColumnAlignment});
+    }
+}
+
+template<class... Ts>
+SoAVector<Ts...>& SoAVector<Ts...>::operator=(const SoAVector& other) {
+    if(&other != this) {
+        SoAVector copy(other);
+        swap(copy);
+    }
+    return *this;
+}
+
+template<class... Ts>
+SoAVector<Ts...>& SoAVector<Ts...>::operator=(SoAVector&& other) noexcept {
+    if(&other != this) {
+        SoAVector moved(std::move(other));
+        swap(moved);
+    }
+    return *this;
+}
+
+template<class... Ts>
+bool SoAVector<Ts...>::empty() const noexcept {
+    return size_ == 0;
+}
+
+template<class... Ts>
+SoAVector<Ts...>::size_type SoAVector<Ts...>::size() const noexcept {
+    return size_;
+}
+
+template<class... Ts>
+SoAVector<Ts...>::size_type SoAVector<Ts...>::capacity() const noexcept {
+    return capacity_;
+}
+
+template<class... Ts>
+void SoAVector<Ts...>::reserve(size_type new_cap) {
+    if(new_cap > capacity_) {
+        reallocate(new_cap);
+    }
+}
+
+template<class... Ts>
+void SoAVector<Ts...>::shrink_to_fit() {
+    if(size_ < capacity_) {
+        reallocate(size_);
+    }
+}
+
+template<class... Ts>
+void SoAVector<Ts...>::resize(size_type count) {
+    if(count < size_) {
+        destroyRows(count, size_);
+        size_ = count;
+        return;
+    }
+    reserve(count);
+    constructRows(count, [](auto, auto first, auto last) {
+        std::uninitialized_value_construct(first, last);
+    });
+}
+
+template<class... Ts>
+void SoAVector<Ts...>::resize(size_type count, default_init_t) {
+    if(count < size_) {
+        destroyRows(count, size_);
+        size_ = count;
+        return;
+    }
+    reserve(count);
+    constructRows(count, [](auto, auto first, auto last) {
+        std::uninitialized_default_construct(first, last);
+    });
+}
+
+template<class... Ts>
+template<std::size_t I>
+typename SoAVector<Ts...>::template column_type<I>* SoAVector<Ts...>::data() noexcept {
+    return std::assume_aligned<kColumnAlignment>(ds::get<I>(columns_));
+}
+
+template<class... Ts>
+template<std::size_t I>
+const typename SoAVector<Ts...>::template column_type<I>* SoAVector<Ts...>::data() const noexcept {
+    return std::assume_aligned<kColumnAlignment>(ds::get<I>(columns_));
+}
+
+template<class... Ts>
+template<std::size_t I>
+std::span<typename SoAVector<Ts...>::template column_type<I>> SoAVector<Ts...>::column() noexcept {
+    return std::span<column_type<I>>(data<I>(), size_);
+}
+
+template<class... Ts>
+template<std::size_t I>
+std::span<const typename SoAVector<Ts...>::template column_type<I>> SoAVector<Ts...>::column() const noexcept {
+    return std::span<const column_type<I>>(data<I>(), size_);
+}
+
+template<class... Ts>
+void SoAVector<Ts...>::push_back(const value_type& value) {
+    [&]<std::size_t... I>(std::index_sequence<I...>) {
+        emplace_back(ds::get<I>(value)...);
+    }(indices{});
+}
+
+template<class... Ts>
+void SoAVector<Ts...>::push_back(value_type&& value) {
+    [&]<std::size_t... I>(std::index_sequence<I...>) {
+        emplace_back(std::move(ds::get<I>(value))...);
+    }(indices{});
+}
+
+template<class... Ts>
+template<class... Args>
+requires (sizeof...(Args) == sizeof...(Ts))
+SoAVector<Ts...>::reference SoAVector<Ts...>::emplace_back(Args&&... fields) {
+    if(size_ == capacity_) {
+        // 'fields' can refer to own elements, build the row before growing
+        value_type row {Ts(std::forward<Args>(fields))...};
+        reallocate(DoublingGrowth::grow(capacity_, size_ + 1, (sizeof(Ts) + ...)));
+        [&]<std::size_t... I>(std::index_sequence<I...>) {
+            (::new(static_cast<void*>(ds::get<I>(columns_) + size_)) Ts(std::move(ds::get<I>(row))), ...);
+        }(indices{});
+    } else {
+        [&]<std::size_t... I>(std::index_sequence<I...>) {
+            std::size_t done {0};
+            try {
+                ((::new(static_cast<void*>(ds::get<I>(columns_) + size_)) Ts(std::forward<Args>(fields)), ++done), ...);
+            } catch(...) {
+                ((I < done ? std::destroy_at(ds::get<I>(columns_) + size_) : void()), ...);
+                throw;
+            }
+        }(indices{});
+    }
+    ++size_;
+    return back();
+}
+
+template<class... Ts>
+void SoAVector<Ts...>::pop_back() {
+    if(size_ == 0) {
+        return;
+    }
+    destroyRows(size_ - 1, size_);
+    --size_;
+}
+
+template<class... Ts>
+void SoAVector<Ts...>::clear() noexcept {
+    destroyRows(0, size_);
+    size_ = 0;
+}
+
+template<class... Ts>
+SoAVector<Ts...>::iterator SoAVector<Ts...>::erase(const_iterator pos) {
+    if(pos.owner_ != this || !(pos.index_ < size_)) {
+        throw std::out_of_range("Iterator is out of bounds!");
+    }
+    [&]<std::size_t... I>(std::index_sequence<I...>) {
+        (std::move(ds::get<I>(columns_) + pos.index_ + 1, ds::get<I>(columns_) + size_, ds::get<I>(columns_) + pos.index_), ...);
+    }(indices{});
+    pop_back();
+    return begin() + pos.index_;
+}
+
+template<class... Ts>
+SoAVector<Ts...>::iterator SoAVector<Ts...>::unordered_erase(const_iterator pos) {
+    if(pos.owner_ != this || !(pos.index_ < size_)) {
+        throw std::out_of_range("Iterator is out of bounds!");
+    }
+    if(pos.index_ != size_ - 1) {
+        [&]<std::size_t... I>(std::index_sequence<I...>) {
+            ((ds::get<I>(columns_)[pos.index_] = std::move(ds::get<I>(columns_)[size_ - 1])), ...);
+        }(indices{});
+    }
+    pop_back();
+    return begin() + pos.index_;
+}
+
+template<class... Ts>
+void SoAVector<Ts...>::swap(SoAVector& other) noexcept {
+    using std::swap;
+    swap(buffer_, other.buffer_);
+    [&]<std::size_t... I>(std::index_sequence<I...>) {
+        (swap(ds::get<I>(columns_), ds::get<I>(other.columns_)), ...);
+    }(indices{});
+    swap(size_, other.size_);
+    swap(capacity_, other.capacity_);
+}
+
+template<class... Ts>
+SoAVector<Ts...>::iterator SoAVector<Ts...>::begin() noexcept {
+    return iterator(this, 0);
+}
+
+template<class... Ts>
+SoAVector<Ts...>::const_iterator SoAVector<Ts...>::begin() const noexcept {
+    return const_iterator(this, 0);
+}
+
+template<class... Ts>
+SoAVector<Ts...>::const_iterator SoAVector<Ts...>::cbegin() const noexcept {
+    return const_iterator(this, 0);
+}
+
+template<class... Ts>
+SoAVector<Ts...>::iterator SoAVector<Ts...>::end() noexcept {
+    return iterator(this, size_);
+}
+
+template<class... Ts>
+SoAVector<Ts...>::const_iterator SoAVector<Ts...>::end() const noexcept {
+    return const_iterator(this, size_);
+}
+
+template<class... Ts>
+SoAVector<Ts...>::const_iterator SoAVector<Ts...>::cend() const noexcept {
+    return const_iterator(this, size_);
+}
+
+template<class... Ts>
+SoAVector<Ts...>::reference SoAVector<Ts...>::front() {
+    return reference(this, 0);
+}
+
+template<class... Ts>
+SoAVector<Ts...>::const_reference SoAVector<Ts...>::front() const {
+    return const_reference(this, 0);
+}
+
+template<class... Ts>
+SoAVector<Ts...>::reference SoAVector<Ts...>::back() {
+    return reference(this, size_ - 1);
+}
+
+template<class... Ts>
+SoAVector<Ts...>::const_reference SoAVector<Ts...>::back() const {
+    return const_reference(this, size_ - 1);
+}
+
+template<class... Ts>
+SoAVector<Ts...>::reference SoAVector<Ts...>::operator[] (const size_type index) {
+    return reference(this, index);
+}
+
+template<class... Ts>
+SoAVector<Ts...>::const_reference SoAVector<Ts...>::operator[] (const size_type index) const {
+    return const_reference(this, index);
+}
+
+template<class... Ts>
+SoAVector<Ts...>::reference SoAVector<Ts...>::at(const size_type index) {
+    if(!(index < size_))
+        throw std::out_of_range("Index out of range");
+    return reference(this, index);
+}
+
+template<class... Ts>
+SoAVector<Ts...>::const_reference SoAVector<Ts...>::at(const size_type index) const {
+    if(!(index < size_))
+        throw std::out_of_range("Index out of range");
+    return const_reference(this, index);
+}
+
+template<class... Ts>
+SoAVector<Ts...>::size_type SoAVector<Ts...>::columnBytes(size_type bytes) noexcept {
+    return (bytes + kColumnAlignment - 1) / kColumnAlignment * kColumnAlignment;
+}
+
+template<class... Ts>
+void SoAVector<Ts...>::reallocate(size_type new_cap) {
+    if(new_cap > std::numeric_limits<size_type>::max() / kColumnAlignment / sizeof...(Ts)) {
+        throw std::length_error("SoAVector can not grow any further");
+    }
+    std::byte* buffer {nullptr};
+    if(new_cap > 0) {
+        buffer = static_cast<std::byte*>(::operator new((columnBytes(new_cap * sizeof(Ts)) + ...), std::align_val_t {kColumnAlignment}));
+    }
+    size_type offset {0};
+    [&]<std::size_t... I>(std::index_sequence<I...>) {
+        ([&] {
+            using column_t = column_type<I>;
+            column_t* source {ds::get<I>(columns_)};
+            column_t* target {reinterpret_cast<column_t*>(buffer + offset)};
+            offset += columnBytes(new_cap * sizeof(column_t));
+            if constexpr(is_trivially_relocatable_v<column_t>) {
+                if(size_ > 0) {
+                    std::memcpy(static_cast<void*>(target), source, size_ * sizeof(column_t));
+                }
+            } else {
+                std::uninitialized_move(source, source + size_, target);
+                std::destroy(source, source + size_);
+            }
+            ds::get<I>(columns_) = buffer ? target : nullptr;
+        }(), ...);
+    }(indices{});
+    if(buffer_) {
+        ::operator delete(buffer_, std::align_val_t {kColumnAlignment});
+    }
+    buffer_ = buffer;
+    capacity_ = new_cap;
+}
+
+template<class... Ts>
+template<class Init>
+void SoAVector<Ts...>::constructRows(size_type count, Init init) {
+    [&]<std::size_t... I>(std::index_sequence<I...>) {
+        std::size_t done {0};
+        try {
+            ((init(std::integral_constant<std::size_t, I> {}, ds::get<I>(columns_) + size_, ds::get<I>(columns_) + count), ++done), ...);
+        } catch(...) {
+            ((I < done ? std::destroy(ds::get<I>(columns_) + size_, ds::get<I>(columns_) + count) : void()), ...);
+            throw;
+        }
+    }(indices{});
+    size_ = count;
+}
+
+template<class... Ts>
+void SoAVector<Ts...>::destroyRows(size_type first, size_type last) noexcept {
+    [&]<std::size_t... I>(std::index_sequence<I...>) {
+        (std::destroy(ds::get<I>(columns_) + first, ds::get<I>(columns_) + last), ...);
+    }(indices{});
+}
+
+}
+#endif // SOAVECTOR_HPP
@@ -0,0 +1,661 @@
+#ifndef STABLEVECTOR_HPP
+#define STABLEVECTOR_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <compare>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "concepts.hpp"
+#include "vectorclass.hpp"
+
+namespace ds {
+
+namespace detail {
+
+// Index math for blocks which double in size: block k holds BlockSize << k
+// elements and starts at index BlockSize * (2^k - 1), so index + BlockSize
+// has its highest bit at position k + kShift
+template<std::size_t BlockSize>
+struct GeometricBlocks {
+    static_assert(std::has_single_bit(BlockSize), "BlockSize has to be a power of two");
+
+    static constexpr std::size_t kShift {static_cast<std::size_t>(std::countr_zero(BlockSize))};
+    // Enough blocks to address every std::size_t index
+    static constexpr std::size_t kMaxBlocks {std::numeric_limits<std::size_t>::digits - kShift};
+
+    static constexpr std::size_t blockOf(std::size_t index) noexcept {
+        return static_cast<std::size_t>(std::bit_width((index >> kShift) + 1)) - 1;
+    }
+    static constexpr std::size_t blockStart(std::size_t block) noexcept {
+        return (BlockSize << block) - BlockSize;
+    }
+    static constexpr std::size_t blockCapacity(std::size_t block) noexcept {
+        return BlockSize << block;
+    }
+};
+
+}
+
+// Vector made of blocks which double in size: block k holds
+// BlockSize << k elements. Blocks never move or get copied when the vector
+// grows, so pointers and references to elements stay valid until the
+// element gets erased, and growing only ever allocates one new block.
+// The block table has a fixed size, an index gets split into block and
+// offset with a bit_width and a subtraction.
+// Only insert and erase in the middle move elements, like in VectorClass.
+template<class T, class Allocator = std::allocator<T>, std::size_t BlockSize = 16>
+class StableVector {
+private:
+    template<bool IsConst>
+    class Iterator;
+
+// Type aliases
+public:
+    using value_type = T;
+    using allocator = Allocator;
+    using traits_t = std::allocator_traits<allocator>;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using pointer = traits_t::pointer;
+    using const_pointer = traits_t::const_pointer;
+    using size_type = traits_t::size_type;
+    using difference_type = std::ptrdiff_t;
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+private:
+    using blocks_t = detail::GeometricBlocks<BlockSize>;
+
+    std::array<pointer, blocks_t::kMaxBlocks> blocks_ {};
+    size_type block_count_ {0};
+    size_type size_ {0};
+    [[no_unique_address]] allocator alloc_ {};
+
+public:
+    // Constructors and Desctructor
+    StableVector() = default;
+    explicit StableVector(const Allocator& alloc) noexcept;
+    StableVector(size_type size, const T& value=T{}, const Allocator& alloc = Allocator());
+    StableVector(const StableVector& other);
+    StableVector(StableVector&& other) noexcept;
+    StableVector(std::initializer_list<T> l, const Allocator& alloc = Allocator());
+    template<class InputIt>
+    requires is_it<InputIt>
+    StableVector(InputIt first, InputIt last, const Allocator& alloc = Allocator());
+    ~StableVector();
+
+    // Overloading assignment operator
+    StableVector& operator=(const StableVector& other);
+    StableVector& operator=(StableVector&& other) noexcept;
+    StableVector& operator=(std::initializer_list<T> l);
+
+    // Assign
+    void assign(size_type count, const T& value);
+    template<class InputIt>
+    requires is_it<InputIt>
+    void assign(InputIt first, InputIt last);
+    void assign(std::initializer_list<T> l);
+
+    // Length and capacity
+    constexpr bool empty() const noexcept;
+    constexpr size_type size() const noexcept;
+    constexpr size_type capacity() const noexcept;
+    void reserve(size_type new_cap);
+    // Frees the blocks behind the last element
+    void shrink_to_fit();
+    void resize(size_type count, const value_type& value=T{});
+    void resize(size_type count, default_init_t);
+
+    // Blocks. Block k holds BlockSize << k elements, only the used part of
+    // it is in the span.
+    size_type segment_count() const noexcept;
+    std::span<T> segment(size_type block);
+    std::span<const T> segment(size_type block) const;
+
+    // Modifiers. Appending never moves an element.
+    void push_back(const T& value);
+    void push_back(T&& value);
+    template<class... Args>
+    reference emplace_back(Args&&... args);
+    template<class... Args>
+    iterator emplace(const_iterator pos, Args&&... args);
+    // Keeps the blocks
+    void clear() noexcept;
+    // Inserts append and rotate the new elements into place
+    iterator insert(const_iterator pos, const T& value);
+    iterator insert(const_iterator pos, T&& value);
+    iterator insert(const_iterator pos, size_type count, const T& value);
+    template<class InputIt>
+    requires is_it<InputIt>
+    iterator insert(const_iterator pos, InputIt first, InputIt last);
+    iterator insert(const_iterator pos, std::initializer_list<T> ilist);
+    iterator erase(const_iterator pos);
+    iterator erase(const_iterator first, const_iterator last);
+    iterator unordered_erase(const_iterator pos);
+    void pop_back();
+    void swap(StableVector& other) noexcept;
+
+    // Iterators, random access
+    iterator begin() noexcept;
+    const_iterator begin() const noexcept;
+    const_iterator cbegin() const noexcept;
+    iterator end() noexcept;
+    const_iterator end() const noexcept;
+    const_iterator cend() const noexcept;
+
+    reverse_iterator rbegin() noexcept;
+    const_reverse_iterator rbegin() const noexcept;
+    const_reverse_iterator crbegin() const noexcept;
+    reverse_iterator rend() noexcept;
+    const_reverse_iterator rend() const noexcept;
+    const_reverse_iterator crend() const noexcept;
+
+    // Element access
+    reference front();
+    const_reference front() const;
+    reference back();
+    const_reference back() const;
+    reference operator[] (const size_type index);
+    const_reference operator[] (const size_type index) const;
+    reference at(const size_type index);
+    const_reference at(const size_type index) const;
+
+    // Get allocator
+    constexpr allocator get_allocator() const noexcept;
+
+private:
+    pointer slot(size_type index) const noexcept;
+    void addBlock();
+    // Frees the blocks from 'first' on, they have to be empty
+    void releaseBlocks(size_type first) noexcept;
+    size_type indexOf(const_iterator pos) const;
+};
+
+template<class T, class Allocator, std::size_t BlockSize>
+template<bool IsConst>
+class StableVector<T, Allocator, BlockSize>::Iterator {
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using difference_type   = std::ptrdiff_t;
+    using value_type        = StableVector::value_type;
+    using pointer           = std::conditional_t<IsConst, const value_type*, value_type*>;
+    using reference         = std::conditional_t<IsConst, const value_type&, value_type&>;
+
+    Iterator() = default;
+    // iterator converts to const_iterator
+    template<bool OtherConst>
+    requires (IsConst && !OtherConst)
+    Iterator(const Iterator<OtherConst>& other): owner_ {other.owner_}, index_ {other.index_} {}
+
+    reference operator*() const { return *owner_->slot(index_); }
+    pointer operator->() const { return std::to_address(owner_->slot(index_)); }
+    reference operator[](difference_type n) const { return *owner_->slot(index_ + n); }
+
+    Iterator& operator++() { ++index_; return *this; }
+    Iterator operator++(int) { Iterator tmp = *this; ++index_; return tmp; }
+    Iterator& operator--() { --index_; return *this; }
+    Iterator operator--(int) { Iterator tmp = *this; --index_; return tmp; }
+    Iterator& operator+=(difference_type n) { index_ += n; return *this; }
+    Iterator& operator-=(difference_type n) { index_ -= n; return *this; }
+
+    friend Iterator operator+(Iterator it, difference_type n) { return it += n; }
+    friend Iterator operator+(difference_type n, Iterator it) { return it += n; }
+    friend Iterator operator-(Iterator it, difference_type n) { return it -= n; }
+    friend difference_type operator-(const Iterator& a, const Iterator& b) {
+        return static_cast<difference_type>(a.index_) - static_cast<difference_type>(b.index_);
+    }
+    friend bool operator==(const Iterator& a, const Iterator& b) { return a.index_ == b.index_; }
+    friend auto operator<=>(const Iterator& a, const Iterator& b) { return a.index_ <=> b.index_; }
+
+private:
+    using owner_type = std::conditional_t<IsConst, const StableVector, StableVector>;
+
+    Iterator(owner_type* owner, size_type index): owner_ {owner}, index_ {index} {}
+
+    owner_type* owner_ {nullptr};
+    size_type index_ {0};
+
+    template<bool>
+    friend class Iterator;
+    friend class StableVector;
+};
+
+template<class T, class Allocator, std::size_t BlockSize>
+StableVector<T, Allocator, BlockSize>::StableVector(const Allocator& alloc) noexcept: alloc_ {alloc} {}
+
+template<class T, class Allocator, std::size_t BlockSize>
+StableVector<T, Allocator, BlockSize>::StableVector(size_type size, const T& value, const Allocator& alloc): alloc_ {alloc} {
+    resize(size, value);
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+StableVector<T, Allocator, BlockSize>::StableVector(const StableVector& other): alloc_ {traits_t::select_on_container_copy_construction(other.alloc_)} {
+    assign(other.begin(), other.end());
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+StableVector<T, Allocator, BlockSize>::StableVector(StableVector&& other) noexcept
+    : blocks_ {std::exchange(other.blocks_, {})}
+    , block_count_ {std::exchange(other.block_count_, 0)}
+    , size_ {std::exchange(other.size_, 0)}
+    , alloc_ {std::move(other.alloc_)}
+{
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+StableVector<T, Allocator, BlockSize>::StableVector(std::initializer_list<T> l, const Allocator& alloc): alloc_ {alloc} {
+    assign(l.begin(), l.end());
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+template<class InputIt>
+requires is_it<InputIt>
+StableVector<T, Allocator, BlockSize>::StableVector(InputIt first, InputIt last, const Allocator& alloc): alloc_ {alloc} {
+    assign(first, last);
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+StableVector<T, Allocator, BlockSize>::~StableVector() {
+    clear();
+    releaseBlocks(0);
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+StableVector<T, Allocator, BlockSize>& StableVector<T, Allocator, BlockSize>::operator=(const StableVector& other) {
+    if(&other != this) {
+        assign(other.begin(), other.end());
+    }
+    return *this;
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+StableVector<T, Allocator, BlockSize>& StableVector<T, Allocator, BlockSize>::operator=(StableVector&& other) noexcept {
+    if(&other != this) {
+        clear();
+        releaseBlocks(0);
+        swap(other);
+    }
+    return *this;
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+StableVector<T, Allocator, BlockSize>& StableVector<T, Allocator, BlockSize>::operator=(std::initializer_list<T> l) {
+    assign(l.begin(), l.end());
+    return *this;
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+void StableVector<T, Allocator, BlockSize>::assign(size_type count, const T& value) {
+    clear();
+    resize(count, value);
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+template<class InputIt>
+requires is_it<InputIt>
+void StableVector<T, Allocator, BlockSize>::assign(InputIt first, InputIt last) {
+    clear();
+    for(; first != last; ++first) {
+        emplace_back(*first);
+    }
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+void StableVector<T, Allocator, BlockSize>::assign(std::initializer_list<T> l) {
+    assign(l.begin(), l.end());
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+constexpr bool StableVector<T, Allocator, BlockSize>::empty() const noexcept {
+    return size_ == 0;
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+constexpr StableVector<T, Allocator, BlockSize>::size_type StableVector<T, Allocator, BlockSize>::size() const noexcept {
+    return size_;
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+constexpr StableVector<T, Allocator, BlockSize>::size_type StableVector<T, Allocator, BlockSize>::capacity() const noexcept {
+    return blocks_t::blockStart(block_count_);
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+void StableVector<T, Allocator, BlockSize>::reserve(size_type new_cap) {
+    while(capacity() < new_cap) {
+        addBlock();
+    }
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+void StableVector<T, Allocator, BlockSize>::shrink_to_fit() {
+    releaseBlocks(size_ == 0 ? 0 : blocks_t::blockOf(size_ - 1) + 1);
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+void StableVector<T, Allocator, BlockSize>::resize(size_type count, const value_type& value) {
+    while(size_ > count) {
+        pop_back();
+    }
+    // Nothing moves, so 'value' stays valid even if it is an element
+    reserve(count);
+    while(size_ < count) {
+        emplace_back(value);
+    }
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+void StableVector<T, Allocator, BlockSize>::resize(size_type count, default_init_t) {
+    while(size_ > count) {
+        pop_back();
+    }
+    reserve(count);
+    for(; size_ < count; ++size_) {
+        ::new(static_cast<void*>(std::to_address(slot(size_)))) T;
+    }
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+StableVector<T, Allocator, BlockSize>::size_type StableVector<T, Allocator, BlockSize>::segment_count() const noexcept {
+    return block_count_;
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+std::span<T> StableVector<T, Allocator, BlockSize>::segment(size_type block) {
+    if(!(block < block_count_)) {
+        throw std::out_of_range("Block does not exist!");
+    }
+    size_type start {blocks_t::blockStart(block)};
+    size_type used {size_ > start ? std::min(size_ - start, blocks_t::blockCapacity(block)) : 0};
+    return std::span<T>(std::to_address(blocks_[block]), used);
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+std::span<const T> StableVector<T, Allocator, BlockSize>::segment(size_type block) const {
+    return const_cast<StableVector*>(this)->segment(block);
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+void StableVector<T, Allocator, BlockSize>::push_back(const T& value) {
+    emplace_back(value);
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+void StableVector<T, Allocator, BlockSize>::push_back(T&& value) {
+    emplace_back(std::move(value));
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+template<class... Args>
+StableVector<T, Allocator, BlockSize>::reference StableVector<T, Allocator, BlockSize>::emplace_back(Args&&... args) {
+    if(size_ == capacity()) {
+        addBlock();
+    }
+    pointer p {slot(size_)};
+    traits_t::construct(alloc_, std::to_address(p), std::forward<Args>(args)...);
+    ++size_;
+    return *p;
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+template<class... Args>
+StableVector<T, Allocator, BlockSize>::iterator StableVector<T, Allocator, BlockSize>::emplace(const_iterator pos, Args&&... args) {
+    size_type index {indexOf(pos)};
+    emplace_back(std::forward<Args>(args)...);
+    std::rotate(begin() + index, end() - 1, end());
+    return begin() + index;
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+void StableVector<T, Allocator, BlockSize>::clear() noexcept {
+    while(size_ > 0) {
+        pop_back();
+    }
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+StableVector<T, Allocator, BlockSize>::iterator StableVector<T, Allocator, BlockSize>::insert(const_iterator pos, const T& value) {
+    return emplace(pos, value);
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+StableVector<T, Allocator, BlockSize>::iterator StableVector<T, Allocator, BlockSize>::insert(const_iterator pos, T&& value) {
+    return emplace(pos, std::move(value));
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+StableVector<T, Allocator, BlockSize>::iterator StableVector<T, Allocator, BlockSize>::insert(const_iterator pos, size_type count, const T& value) {
+    size_type index {indexOf(pos)};
+    size_type old_size {size_};
+    resize(size_ + count, value);
+    std::rotate(begin() + index, begin() + old_size, end());
+    return begin() + index;
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+template<class InputIt>
+requires is_it<InputIt>
+StableVector<T, Allocator, BlockSize>::iterator StableVector<T, Allocator, BlockSize>::insert(const_iterator pos, InputIt first, InputIt last) {
+    size_type index {indexOf(pos)};
+    size_type old_size {size_};
+    for(; first != last; ++first) {
+        emplace_back(*first);
+    }
+    std::rotate(begin() + index, begin() + old_size, end());
+    return begin() + index;
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+StableVector<T, Allocator, BlockSize>::iterator StableVector<T, Allocator, BlockSize>::insert(const_iterator pos, std::initializer_list<T> iList) {
+    return insert(pos, iList.begin(), iList.end());
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+StableVector<T, Allocator, BlockSize>::iterator StableVector<T, Allocator, BlockSize>::erase(const_iterator pos) {
+    if(!(indexOf(pos) < size_)) {
+        throw std::out_of_range("Iterator is out of bounds!");
+    }
+    return erase(pos, pos + 1);
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+StableVector<T, Allocator, BlockSize>::iterator StableVector<T, Allocator, BlockSize>::erase(const_iterator first, const_iterator last) {
+    size_type index {indexOf(first)};
+    size_type last_index {indexOf(last)};
+    if(index > last_index) {
+        throw std::out_of_range("Iterator is out of bounds!");
+    }
+    std::move(begin() + last_index, end(), begin() + index);
+    for(size_type count {last_index - index}; count > 0; --count) {
+        pop_back();
+    }
+    return begin() + index;
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+StableVector<T, Allocator, BlockSize>::iterator StableVector<T, Allocator, BlockSize>::unordered_erase(const_iterator pos) {
+    size_type index {indexOf(pos)};
+    if(!(index < size_)) {
+        throw std::out_of_range("Iterator is out of bounds!");
+    }
+    if(index != size_ - 1) {
+        (*this)[index] = std::move(back());
+    }
+    pop_back();
+    return begin() + index;
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+void StableVector<T, Allocator, BlockSize>::pop_back() {
+    if(size_ == 0) {
+        return;
+    }
+    --size_;
+    traits_t::destroy(alloc_, std::to_address(slot(size_)));
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+void StableVector<T, Allocator, BlockSize>::swap(StableVector& other) noexcept {
+    using std::swap;
+    swap(blocks_, other.blocks_);
+    swap(block_count_, other.block_count_);
+    swap(size_, other.size_);
+    swap(alloc_, other.alloc_);
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+StableVector<T, Allocator, BlockSize>::iterator StableVector<T, Allocator, BlockSize>::begin() noexcept {
+    return iterator(this, 0);
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+StableVector<T, Allocator, BlockSize>::const_iterator StableVector<T, Allocator, BlockSize>::begin() const noexcept {
+    return const_iterator(this, 0);
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+StableVector<T, Allocator, BlockSize>::const_iterator StableVector<T, Allocator, BlockSize>::cbegin() const noexcept {
+    return const_iterator(this, 0);
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+StableVector<T, Allocator, BlockSize>::iterator StableVector<T, Allocator, BlockSize>::end() noexcept {
+    return iterator(this, size_);
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+StableVector<T, Allocator, BlockSize>::const_iterator StableVector<T, Allocator, BlockSize>::end() const noexcept {
+    return const_iterator(this, size_);
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+StableVector<T, Allocator, BlockSize>::const_iterator StableVector<T, Allocator, BlockSize>::cend() const noexcept {
+    return const_iterator(this, size_);
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+StableVector<T, Allocator, BlockSize>::reverse_iterator StableVector<T, Allocator, BlockSize>::rbegin() noexcept {
+    return reverse_iterator(end());
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+StableVector<T, Allocator, BlockSize>::const_reverse_iterator StableVector<T, Allocator, BlockSize>::rbegin() const noexcept {
+    return const_reverse_iterator(end());
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+StableVector<T, Allocator, BlockSize>::const_reverse_iterator StableVector<T, Allocator, BlockSize>::crbegin() const noexcept {
+    return const_reverse_iterator(end());
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+StableVector<T, Allocator, BlockSize>::reverse_iterator StableVector<T, Allocator, BlockSize>::rend() noexcept {
+    return reverse_iterator(begin());
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+StableVector<T, Allocator, BlockSize>::const_reverse_iterator StableVector<T, Allocator, BlockSize>::rend() const noexcept {
+    return const_reverse_iterator(begin());
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+StableVector<T, Allocator, BlockSize>::const_reverse_iterator StableVector<T, Allocator, BlockSize>::crend() const noexcept {
+    return const_reverse_iterator(begin());
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+StableVector<T, Allocator, BlockSize>::reference StableVector<T, Allocator, BlockSize>::front() {
+    return *slot(0);
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+StableVector<T, Allocator, BlockSize>::const_reference StableVector<T, Allocator, BlockSize>::front() const {
+    return *slot(0);
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+StableVector<T, Allocator, BlockSize>::reference StableVector<T, Allocator, BlockSize>::back() {
+    return *slot(size_ - 1);
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+StableVector<T, Allocator, BlockSize>::const_reference StableVector<T, Allocator, BlockSize>::back() const {
+    return *slot(size_ - 1);
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+StableVector<T, Allocator, BlockSize>::reference StableVector<T, Allocator, BlockSize>::operator[] (const size_type index) {
+    return *slot(index);
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+StableVector<T, Allocator, BlockSize>::const_reference StableVector<T, Allocator, BlockSize>::operator[] (const size_type index) const {
+    return *slot(index);
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+StableVector<T, Allocator, BlockSize>::reference StableVector<T, Allocator, BlockSize>::at(const size_type index) {
+    if(!(index < size_))
+        throw std::out_of_range("Index out of range");
+    return *slot(index);
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+StableVector<T, Allocator, BlockSize>::const_reference StableVector<T, Allocator, BlockSize>::at(const size_type index) const {
+    if(!(index < size_))
+        throw std::out_of_range("Index out of range");
+    return *slot(index);
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+constexpr StableVector<T, Allocator, BlockSize>::allocator StableVector<T, Allocator, BlockSize>::get_allocator() const noexcept {
+    return alloc_;
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+StableVector<T, Allocator, BlockSize>::pointer StableVector<T, Allocator, BlockSize>::slot(size_type index) const noexcept {
+    size_type block {blocks_t::blockOf(index)};
+    return blocks_[block] + (index - blocks_t::blockStart(block));
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+void StableVector<T, Allocator, BlockSize>::addBlock() {
+    if(block_count_ == blocks_t::kMaxBlocks) {
+        throw std::length_error("StableVector can not grow any further");
+    }
+    blocks_[block_count_] = traits_t::allocate(alloc_, blocks_t::blockCapacity(block_count_));
+    ++block_count_;
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+void StableVector<T, Allocator, BlockSize>::releaseBlocks(size_type first) noexcept {
+    while(block_count_ > first) {
+        --block_count_;
+        traits_t::deallocate(alloc_, blocks_[block_count_], blocks_t::blockCapacity(block_count_));
+        blocks_[block_count_] = nullptr;
+    }
+}
+
+template<class T, class Allocator, std::size_t BlockSize>
+StableVector<T, Allocator, BlockSize>::size_type StableVector<T, Allocator, BlockSize>::indexOf(const_iterator pos) const {
+    if(pos.owner_ != this || pos.index_ > size_) {
+        throw std::out_of_range("Iterator is out of bounds!");
+    }
+    return pos.index_;
+}
+
+}
+#endif // STABLEVECTOR_HPP
@@ -0,0 +1,881 @@
+#ifndef UNROLLEDLIST_HPP
+#define UNROLLEDLIST_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "concepts.hpp"
+#include "vectorclass.hpp"
+
+namespace ds {
+
+// Doubly linked list of nodes which each hold a small array of elements.
+// A node takes CacheLines cache lines, so walking the list touches one node
+// header per array instead of one per element.
+// Inserting into a full node splits it in half, erasing merges a node which
+// dropped below half full with a neighbour when both fit into one node.
+// Inserts and erases move elements inside the touched nodes, so they
+// invalidate iterators and references into those nodes, like in a vector.
+template<class T, class Allocator = std::allocator<T>, std::size_t CacheLines = 2>
+class UnrolledList {
+    static_assert(CacheLines > 0, "A node needs at least one cache line");
+
+private:
+    struct Node;
+    template<bool IsConst>
+    class Iterator;
+
+// Type aliases
+public:
+    using value_type = T;
+    using allocator_type = Allocator;
+    using traits_t = std::allocator_traits<allocator_type>;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using pointer = typename traits_t::pointer;
+    using const_pointer = typename traits_t::const_pointer;
+    using size_type = typename traits_t::size_type;
+    using difference_type = std::ptrdiff_t;
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    static constexpr std::size_t kCacheLine {64};
+
+private:
+    // next_, prev_ and count_ in front of the elements
+    static constexpr std::size_t kHeaderSize {
+        (2 * sizeof(void*) + sizeof(size_type) + alignof(T) - 1) / alignof(T) * alignof(T)};
+
+public:
+    // Elements per node, at least one even if T is bigger than the node
+    static constexpr size_type kNodeCapacity {
+        std::max<std::size_t>(1, (CacheLines * kCacheLine - kHeaderSize) / sizeof(T))};
+
+private:
+    using node_allocator = typename traits_t::template rebind_alloc<Node>;
+    using node_traits = std::allocator_traits<node_allocator>;
+
+    Node* head_ {nullptr};
+    Node* tail_ {nullptr};
+    size_type size_ {0};
+    size_type node_count_ {0};
+    [[no_unique_address]] node_allocator alloc_ {};
+
+public:
+    // Constructors and Desctructor
+    UnrolledList() = default;
+    explicit UnrolledList(const Allocator& alloc) noexcept;
+    UnrolledList(size_type count, const T& value = T(), const Allocator& alloc = Allocator());
+    template<class InputIt>
+    requires is_it<InputIt>
+    UnrolledList(InputIt first, InputIt last, const Allocator& alloc = Allocator());
+    UnrolledList(const UnrolledList& other);
+    UnrolledList(UnrolledList&& other) noexcept;
+    UnrolledList(std::initializer_list<T> iList, const Allocator& alloc = Allocator());
+    ~UnrolledList();
+
+    // Overloading assignment operator
+    UnrolledList& operator=(const UnrolledList& other);
+    UnrolledList& operator=(UnrolledList&& other) noexcept;
+    UnrolledList& operator=(std::initializer_list<T> iList);
+
+    // Assign
+    void assign(size_type count, const T& value);
+    template<class InputIt>
+    requires is_it<InputIt>
+    void assign(InputIt first, InputIt last);
+    void assign(std::initializer_list<T> iList);
+
+    // Size functions
+    constexpr size_type size() const noexcept;
+    constexpr bool empty() const noexcept;
+    constexpr size_type node_count() const noexcept;
+
+    // Iterators, bidirectional
+    iterator begin() noexcept;
+    const_iterator begin() const noexcept;
+    const_iterator cbegin() const noexcept;
+    iterator end() noexcept;
+    const_iterator end() const noexcept;
+    const_iterator cend() const noexcept;
+
+    reverse_iterator rbegin() noexcept;
+    const_reverse_iterator rbegin() const noexcept;
+    const_reverse_iterator crbegin() const noexcept;
+    reverse_iterator rend() noexcept;
+    const_reverse_iterator rend() const noexcept;
+    const_reverse_iterator crend() const noexcept;
+
+    // Modifiers
+    void push_back(const T& value);
+    void push_back(T&& value);
+    void push_front(const T& value);
+    void push_front(T&& value);
+    template<class... Args>
+    reference emplace_back(Args&&... args);
+    template<class... Args>
+    reference emplace_front(Args&&... args);
+    template<class... Args>
+    iterator emplace(const_iterator pos, Args&&... args);
+    iterator insert(const_iterator pos, const T& value);
+    iterator insert(const_iterator pos, T&& value);
+    iterator insert(const_iterator pos, size_type count, const T& value);
+    template<class InputIt>
+    requires is_it<InputIt>
+    iterator insert(const_iterator pos, InputIt first, InputIt last);
+    iterator insert(const_iterator pos, std::initializer_list<T> iList);
+    iterator erase(const_iterator pos);
+    iterator erase(const_iterator first, const_iterator last);
+    void pop_back();
+    void pop_front();
+    void clear() noexcept;
+    void resize(size_type count, const T& value = T());
+    void swap(UnrolledList& other) noexcept;
+
+    // Operation functions
+    // Merging takes two sorted lists, elements of '*this' stay in front of
+    // equal elements of 'other'
+    void merge(UnrolledList&& other);
+    template<class Compare>
+    void merge(UnrolledList&& other, Compare comp);
+    // Stable sort. Sorts pointers to the elements, then moves the elements
+    // through a contiguous buffer into their place, the nodes stay as they are.
+    template<class Compare=std::less<T>>
+    void sort(Compare comp=Compare{});
+    // Removes consecutive equal elements
+    void unique();
+    void reverse();
+    size_type remove(const T& value);
+    template<class UnaryPredicate>
+    size_type remove_if(UnaryPredicate p);
+
+    // Element access, operator[] skips whole nodes
+    reference operator[](const size_type index);
+    const_reference operator[](const size_type index) const;
+    reference front();
+    const_reference front() const;
+    reference back();
+    const_reference back() const;
+
+    // Get allocator
+    constexpr allocator_type get_allocator() const noexcept;
+
+private:
+    void destroyAndDealloc() noexcept;
+    // Links a new empty node behind 'after', nullptr makes it the head
+    Node* newNode(Node* after);
+    // Unlinks and frees an empty node
+    void freeNode(Node* node) noexcept;
+    // Moves the upper half of a full node into a new node behind it
+    void split(Node* node);
+    // Moves the elements of node->next_ into 'node' and frees node->next_
+    void mergeWithNext(Node* node) noexcept;
+    // Inserts at 'index' of 'node', a nullptr node appends
+    template<class... Args>
+    iterator emplaceAt(Node* node, size_type index, Args&&... args);
+    iterator eraseAt(Node* node, size_type index);
+    Node* nodeOf(size_type& index) const noexcept;
+};
+
+template<class T, class Allocator, std::size_t CacheLines>
+struct alignas(UnrolledList<T, Allocator, CacheLines>::kCacheLine) UnrolledList<T, Allocator, CacheLines>::Node {
+    Node* next_ {nullptr};
+    Node* prev_ {nullptr};
+    size_type count_ {0};
+    alignas(T) unsigned char storage_[kNodeCapacity * sizeof(T)];
+
+    // Leaves the storage uninitialized
+    Node() noexcept {}
+
+    T* slot(size_type index) noexcept {
+        return reinterpret_cast<T*>(storage_) + index;
+    }
+};
+
+template<class T, class Allocator, std::size_t CacheLines>
+template<bool IsConst>
+class UnrolledList<T, Allocator, CacheLines>::Iterator {
+public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using difference_type   = std::ptrdiff_t;
+    using value_type        = UnrolledList::value_type;
+    using pointer           = std::conditional_t<IsConst, const value_type*, value_type*>;
+    using reference         = std::conditional_t<IsConst, const value_type&, value_type&>;
+
+    Iterator() = default;
+    // iterator converts to const_iterator
+    template<bool OtherConst>
+    requires (IsConst && !OtherConst)
+    Iterator(const Iterator<OtherConst>& other): owner_ {other.owner_}, node_ {other.node_}, index_ {other.index_} {}
+
+    reference operator*() const { return *node_->slot(index_); }
+    pointer operator->() const { return node_->slot(index_); }
+
+    Iterator& operator++() {
+        if(++index_ == node_->count_) {
+            node_ = node_->next_;
+            index_ = 0;
+        }
+        return *this;
+    }
+    Iterator operator++(int) { Iterator tmp = *this; ++(*this); return tmp; }
+    // end() steps back to the last element of the tail
+    Iterator& operator--() {
+        if(!node_) {
+            node_ = owner_->tail_;
+            index_ = node_->count_ - 1;
+        } else if(index_ == 0) {
+            node_ = node_->prev_;
+            index_ = node_->count_ - 1;
+        } else {
+            --index_;
+        }
+        return *this;
+    }
+    Iterator operator--(int) { Iterator tmp = *this; --(*this); return tmp; }
+
+    friend bool operator==(const Iterator& a, const Iterator& b) {
+        return a.node_ == b.node_ && a.index_ == b.index_;
+    }
+
+private:
+    using owner_type = std::conditional_t<IsConst, const UnrolledList, UnrolledList>;
+
+    Iterator(owner_type* owner, Node* node, size_type index): owner_ {owner}, node_ {node}, index_ {index} {}
+
+    owner_type* owner_ {nullptr};
+    Node* node_ {nullptr};
+    size_type index_ {0};
+
+    template<bool>
+    friend class Iterator;
+    friend class UnrolledList;
+};
+
+template<class T, class Allocator, std::size_t CacheLines>
+UnrolledList<T, Allocator, CacheLines>::UnrolledList(const Allocator& alloc) noexcept: alloc_ {alloc} {}
+
+template<class T, class Allocator, std::size_t CacheLines>
+UnrolledList<T, Allocator, CacheLines>::UnrolledList(size_type count, const T& value, const Allocator& alloc): alloc_ {alloc} {
+    assign(count, value);
+}
+
+template<class T, class Allocator, std::size_t CacheLines>
+template<class InputIt>
+requires is_it<InputIt>
+UnrolledList<T, Allocator, CacheLines>::UnrolledList(InputIt first, InputIt last, const Allocator& alloc): alloc_ {alloc} {
+    assign(first, last);
+}
+
+template<class T, class Allocator, std::size_t CacheLines>
+UnrolledList<T, Allocator, CacheLines>::UnrolledList(const UnrolledList& other)
+    : alloc_ {node_traits::select_on_container_copy_construction(other.alloc_)}
+{
+    assign(other.begin(), other.end());
+}
+
+template<class T, class Allocator, std::size_t CacheLines>
+UnrolledList<T, Allocator, CacheLines>::UnrolledList(UnrolledList&& other) noexcept
+    : head_ {std::exchange(other.head_, nullptr)}
+    , tail_ {std::exchange(other.tail_, nullptr)}
+    , size_ {std::exchange(other.size_, 0)}
+    , node_count_ {std::exchange(other.node_count_, 0)}
+    , alloc_ {std::move(other.alloc_)}
+{}
+
+template<class T, class Allocator, std::size_t CacheLines>
+UnrolledList<T, Allocator, CacheLines>::UnrolledList(std::initializer_list<T> iList, const Allocator& alloc): alloc_ {alloc} {
+    assign(iList);
+}
+
+template<class T, class Allocator, std::size_t CacheLines>
+UnrolledList<T, Allocator, CacheLines>::~UnrolledList() {
+    destroyAndDealloc();
+}
+
+template<class T, class Allocator, std::size_t CacheLines>
+UnrolledList<T, Allocator, CacheLines>& UnrolledList<T, Allocator, CacheLines>::operator=(const UnrolledList& other) {
+    if(this != &other) {
+        assign(other.begin(), other.end());
+    }
+    return *this;
+}
+
+template<class T, class Allocator, std::size_t CacheLines>
+UnrolledList<T, Allocator, CacheLines>& UnrolledList<T, Allocator, CacheLines>::operator=(UnrolledList&& other) noexcept {
+    if(this != &other) {
+        destroyAndDealloc();
+        head_ = std::exchange(other.head_, nullptr);
+        tail_ = std::exchange(other.tail_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+        node_count_ = std::exchange(other.node_count_, 0);
+        alloc_ = std::move(other.alloc_);
+    }
+    return *this;
+}
+
+template<class T, class Allocator, std::size_t CacheLines>
+UnrolledList<T, Allocator, CacheLines>& UnrolledList<T, Allocator, CacheLines>::operator=(std::initializer_list<T> iList) {
+    assign(iList);
+    return *this;
+}
+
+template<class T, class Allocator, std::size_t CacheLines>
+void UnrolledList<T, Allocator, CacheLines>::assign(size_type count, const T& value) {
+    destroyAndDealloc();
+    for(size_type i {0}; i < count; ++i) {
+        emplaceAt(nullptr, 0, value);
+    }
+}
+
+template<class T, class Allocator, std::size_t CacheLines>
+template<class InputIt>
+requires is_it<InputIt>
+void UnrolledList<T, Allocator, CacheLines>::assign(InputIt first, InputIt last) {
+    destroyAndDealloc();
+    for(; first != last; ++first) {
+        emplaceAt(nullptr, 0, *first);
+    }
+}
+
+template<class T, class Allocator, std::size_t CacheLines>
+void UnrolledList<T, Allocator, CacheLines>::assign(std::initializer_list<T> iList) {
+    assign(iList.begin(), iList.end());
+}
+
+template<class T, class Allocator, std::size_t CacheLines>
+constexpr UnrolledList<T, Allocator, CacheLines>::size_type UnrolledList<T, Allocator, CacheLines>::size() const noexcept {
+    return size_;
+}
+
+template<class T, class Allocator, std::size_t CacheLines>
+constexpr bool UnrolledList<T, Allocator, CacheLines>::empty() const noexcept {
+    return size_ == 0;
+}
+
+template<class T, class Allocator, std::size_t CacheLines>
+constexpr UnrolledList<T, Allocator, CacheLines>::size_type UnrolledList<T, Allocator, CacheLines>::node_count() const noexcept {
+    return node_count_;
+}
+
+template<class T, class Allocator, std::size_t CacheLines>
+UnrolledList<T, Allocator, CacheLines>::iterator UnrolledList<T, Allocator, CacheLines>::begin() noexcept {
+    return iterator(this, head_, 0);
+}
+
+template<class T, class Allocator, std::size_t CacheLines>
+UnrolledList<T, Allocator, CacheLines>::const_iterator UnrolledList<T, Allocator, CacheLines>::begin() const noexcept {
+    return const_iterator(this, head_, 0);
+}
+
+template<class T, class Allocator, std::size_t CacheLines>
+UnrolledList<T, Allocator, CacheLines>::const_iterator UnrolledList<T, Allocator, CacheLines>::cbegin() const noexcept {
+    return begin();
+}
+
+template<class T, class Allocator, std::size_t CacheLines>
+UnrolledList<T, Allocator, CacheLines>::iterator UnrolledList<T, Allocator, CacheLines>::end() noexcept {
+    return iterator(this, nullptr, 0);
+}
+
+template<class T, class Allocator, std::size_t CacheLines>
+UnrolledList<T, Allocator, CacheLines>::const_iterator UnrolledList<T, Allocator, CacheLines>::end() const noexcept {
+    return const_iterator(this, nullptr, 0);
+}
+
+template<class T, class Allocator, std::size_t CacheLines>
+UnrolledList<T, Allocator, CacheLines>::const_iterator UnrolledList<T, Allocator, CacheLines>::cend() const noexcept {
+    return end();
+}
+
+template<class T, class Allocator, std::size_t CacheLines>
+UnrolledList<T, Allocator, CacheLines>::reverse_iterator UnrolledList<T, Allocator, CacheLines>::rbegin() noexcept {
+    return reverse_iterator(end());
+}
+
+template<class T, class Allocator, std::size_t CacheLines>
+UnrolledList<T, Allocator, CacheLines>::const_reverse_iterator UnrolledList<T, Allocator, CacheLines>::rbegin() const noexcept {
+    return const_reverse_iterator(end());
+}
+
+template<class T, class Allocator, std::size_t CacheLines>
+UnrolledList<T, Allocator, CacheLines>::const_reverse_iterator UnrolledList<T, Allocator, CacheLines>::crbegin() const noexcept {
+    return rbegin();
+}
+
+template<class T, class Allocator, std::size_t CacheLines>
+UnrolledList<T, Allocator, CacheLines>::reverse_iterator UnrolledList<T, Allocator, CacheLines>::rend() noexcept {
+    return reverse_iterator(begin());
+}
+
+template<class T, class Allocator, std::size_t CacheLines>
+UnrolledList<T, Allocator, CacheLines>::const_reverse_iterator UnrolledList<T, Allocator, CacheLines>::rend() const noexcept {
+    return const_reverse_iterator(begin());
+}
+
+template<class T, class Allocator, std::size_t CacheLines>
+UnrolledList<T, Allocator, CacheLines>::const_reverse_iterator UnrolledList<T, Allocator, CacheLines>::crend() const noexcept {
+    return rend();
+}
+
+template<class T, class Allocator, std::size_t CacheLines>
+void UnrolledList<T, Allocator, CacheLines>::push_back(const T& value) {
+    emplaceAt(nullptr, 0, value);
+}
+
+template<class T, class Allocator, std::size_t CacheLines>
+void UnrolledList<T, Allocator, CacheLines>::push_back(T&& value) {
+    emplaceAt(nullptr, 0, std::move(value));
+}
+
+template<class T, class Allocator, std::size_t CacheLines>
+void UnrolledList<T, Allocator, CacheLines>::push_front(const T& value) {
+    emplaceAt(head_, 0, value);
+}
+
+template<class T, class Allocator, std::size_t CacheLines>
+void UnrolledList<T, Allocator, CacheLines>::push_front(T&& value) {
+    emplaceAt(head_, 0, std::move(value));
+}
+
+template<class T, class Allocator, std::size_t CacheLines>
+template<class... Args>
+UnrolledList<T, Allocator, CacheLines>::reference UnrolledList<T, Allocator, CacheLines>::emplace_back(Args&&... args) {
+    return *emplaceAt(nullptr, 0, std::forward<Args>(args)...);
+}
+
+template<class T, class Allocator, std::size_t CacheLines>
+template<class... Args>
+UnrolledList<T, Allocator, CacheLines>::reference UnrolledList<T, Allocator, CacheLines>::emplace_front(Args&&... args) {
+    return *emplaceAt(head_, 0, std::forward<Args>(args)...);
+}
+
+template<class T, class Allocator, std::size_t CacheLines>
+template<class... Args>
+UnrolledList<T, Allocator, CacheLines>::iterator UnrolledList<T, Allocator, CacheLines>::emplace(const_iterator pos, Args&&... args) {
+    return emplaceAt(pos.node_, pos.index_, std::forward<Args>(args)...);
+}
+
+template<class T, class Allocator, std::size_t CacheLines>
+UnrolledList<T, Allocator, CacheLines>::iterator UnrolledList<T, Allocator, CacheLines>::insert(const_iterator pos, const T& value) {
+    return emplaceAt(pos.node_, pos.index_, value);
+}
+
+template<class T, class Allocator, std::size_t CacheLines>
+UnrolledList<T, Allocator, CacheLines>::iterator UnrolledList<T, Allocator, CacheLines>::insert(const_iterator pos, T&& value) {
+    return emplaceAt(pos.node_, pos.index_, std::move(value));
+}
+
+template<class T, class Allocator, std::size_t CacheLines>
+UnrolledList<T, Allocator, CacheLines>::iterator UnrolledList<T, Allocator, CacheLines>::insert(const_iterator pos, size_type count, const T& value) {
+    if(count == 0) {
+        return iterator(this, pos.node_, pos.index_);
+    }
+    // 'value' may be an element which gets moved by the first insert
+    const value_type copy(value);
+    iterator it {emplaceAt(pos.node_, pos.index_, copy)};
+    for(size_type i {1}; i < count; ++i) {
+        it = emplace(std::next(it), copy);
+    }
+    return std::prev(it, count - 1);
+}
+
+template<class T, class Allocator, std::size_t CacheLines>
+template<class InputIt>
+requires is_it<InputIt>
+UnrolledList<T, Allocator, CacheLines>::iterator UnrolledList<T, Allocator, CacheLines>::insert(const_iterator pos, InputIt first, InputIt last) {
+    if(first == last) {
+        return iterator(this, pos.node_, pos.index_);
+    }
+    iterator it {emplaceAt(pos.node_, pos.index_, *first)};
+    size_type inserted {1};
+    for(++first; first != last; ++first, ++inserted) {
+        it = emplace(std::next(it), *first);
+    }
+    return std::prev(it, inserted - 1);
+}
+
+template<class T, class Allocator, std::size_t CacheLines>
+UnrolledList<T, Allocator, CacheLines>::iterator UnrolledList<T, Allocator, CacheLines>::insert(const_iterator pos, std::initializer_list<T> iList) {
+    return insert(pos, iList.begin(), iList.end());
+}
+
+template<class T, class Allocator, std::size_t CacheLines>
+UnrolledList<T, Allocator, CacheLines>::iterator UnrolledList<T, Allocator, CacheLines>::erase(const_iterator pos) {
+    return eraseAt(pos.node_, pos.index_);
+}
+
+template<class T, class Allocator, std::size_t CacheLines>
+UnrolledList<T, Allocator, CacheLines>::iterator UnrolledList<T, Allocator, CacheLines>::erase(const_iterator first, const_iterator last) {
+    iterator it {this, first.node_, first.index_};
+    for(auto count {std::distance(first, last)}; count > 0; --count) {
+        it = eraseAt(it.node_, it.index_);
+    }
+    return it;
+}
+
+template<class T, class Allocator, std::size_t CacheLines>
+void UnrolledList<T, Allocator, CacheLines>::pop_back() {
+    if(!tail_) {return;}
+    eraseAt(tail_, tail_->count_ - 1);
+}
+
+template<class T, class Allocator, std::size_t CacheLines>
+void UnrolledList<T, Allocator, CacheLines>::pop_front() {
+    if(!head_) {return;}
+    eraseAt(head_, 0);
+}
+
+template<class T, class Allocator, std::size_t CacheLines>
+void UnrolledList<T, Allocator, CacheLines>::clear() noexcept {
+    destroyAndDealloc();
+}
+
+template<class T, class Allocator, std::size_t CacheLines>
+void UnrolledList<T, Allocator, CacheLines>::resize(size_type count, const T& value) {
+    while(size_ > count) {
+        pop_back();
+    }
+    while(size_ < count) {
+        emplaceAt(nullptr, 0, value);
+    }
+}
+
+template<class T, class Allocator, std::size_t CacheLines>
+void UnrolledList<T, Allocator, CacheLines>::swap(UnrolledList& other) noexcept {
+    using std::swap;
+    swap(head_, other.head_);
+    swap(tail_, other.tail_);
+    swap(size_, other.size_);
+    swap(node_count_, other.node_count_);
+    swap(alloc_, other.alloc_);
+}
+
+// Operation functions
+
+template<class T, class Allocator, std::size_t CacheLines>
+void UnrolledList<T, Allocator, CacheLines>::merge(UnrolledList&& other) {
+    merge(std::move(other), std::less<T>{});
+}
+
+// The elements of 'other' get appended and merged in place. If 'comp'
+// throws every element is still in '*this', in unspecified order.
+template<class T, class Allocator, std::size_t CacheLines>
+template<class Compare>
+void UnrolledList<T, Allocator, CacheLines>::merge(UnrolledList&& other, Compare comp) {
+    if(&other == this || other.empty()) {
+        return;
+    }
+    if(empty()) {
+        swap(other);
+        return;
+    }
+    // Appending never moves the elements already in the tail
+    iterator middle {std::prev(end())};
+    for(T& value: other) {
+        emplaceAt(nullptr, 0, std::move(value));
+    }
+    other.clear();
+    std::inplace_merge(begin(), std::next(middle), end(), comp);
+}
+
+template<class T, class Allocator, std::size_t CacheLines>
+template<class Compare>
+void UnrolledList<T, Allocator, CacheLines>::sort(Compare comp) {
+    if(size_ <= 1) {
+        return;
+    }
+    // Only pointers move while 'comp' runs, so a throwing comparison leaves
+    // the list as it was
+    using pointer_allocator = typename traits_t::template rebind_alloc<T*>;
+    VectorClass<T*, pointer_allocator> order {pointer_allocator(get_allocator())};
+    order.reserve(size_);
+    for(T& value: *this) {
+        order.push_back(std::addressof(value));
+    }
+    std::stable_sort(order.begin(), order.end(), [&comp](const T* a, const T* b) {
+        return comp(*a, *b);
+    });
+    VectorClass<T, Allocator> sorted(get_allocator());
+    sorted.reserve(size_);
+    for(T* value: order) {
+        sorted.push_back(std::move(*value));
+    }
+    std::move(sorted.begin(), sorted.end(), begin());
+}
+
+template<class T, class Allocator, std::size_t CacheLines>
+void UnrolledList<T, Allocator, CacheLines>::unique() {
+    iterator it {begin()};
+    while(it != end()) {
+        iterator next {std::next(it)};
+        if(next != end() && *next == *it) {
+            // Erasing may merge nodes, the element in front of the returned
+            // iterator is still the one 'it' pointed to
+            it = std::prev(eraseAt(next.node_, next.index_));
+        } else {
+            it = next;
+        }
+    }
+}
+
+template<class T, class Allocator, std::size_t CacheLines>
+void UnrolledList<T, Allocator, CacheLines>::reverse() {
+    std::reverse(begin(), end());
+}
+
+template<class T, class Allocator, std::size_t CacheLines>
+UnrolledList<T, Allocator, CacheLines>::size_type UnrolledList<T, Allocator, CacheLines>::remove(const T& value) {
+    return remove_if([&value](const T& element) { return element == value; });
+}
+
+template<class T, class Allocator, std::size_t CacheLines>
+template<class UnaryPredicate>
+UnrolledList<T, Allocator, CacheLines>::size_type UnrolledList<T, Allocator, CacheLines>::remove_if(UnaryPredicate p) {
+    size_type removed {0};
+    iterator it {begin()};
+    while(it != end()) {
+        if(p(*it)) {
+            it = eraseAt(it.node_, it.index_);
+            ++removed;
+        } else {
+            ++it;
+        }
+    }
+    return removed;
+}
+
+template<class T, class Allocator, std::size_t CacheLines>
+UnrolledList<T, Allocator, CacheLines>::reference UnrolledList<T, Allocator, CacheLines>::operator[](const size_type index) {
+    size_type offset {index};
+    return *nodeOf(offset)->slot(offset);
+}
+
+template<class T, class Allocator, std::size_t CacheLines>
+UnrolledList<T, Allocator, CacheLines>::const_reference UnrolledList<T, Allocator, CacheLines>::operator[](const size_type index) const {
+    size_type offset {index};
+    return *nodeOf(offset)->slot(offset);
+}
+
+template<class T, class Allocator, std::size_t CacheLines>
+UnrolledList<T, Allocator, CacheLines>::reference UnrolledList<T, Allocator, CacheLines>::front() {
+    return *head_->slot(0);
+}
+
+template<class T, class Allocator, std::size_t CacheLines>
+UnrolledList<T, Allocator, CacheLines>::const_reference UnrolledList<T, Allocator, CacheLines>::front() const {
+    return *head_->slot(0);
+}
+
+template<class T, class Allocator, std::size_t CacheLines>
+UnrolledList<T, Allocator, CacheLines>::reference UnrolledList<T, Allocator, CacheLines>::back() {
+    return *tail_->slot(tail_->count_ - 1);
+}
+
+template<class T, class Allocator, std::size_t CacheLines>
+UnrolledList<T, Allocator, CacheLines>::const_reference UnrolledList<T, Allocator, CacheLines>::back() const {
+    return *tail_->slot(tail_->count_ - 1);
+}
+
+template<class T, class Allocator, std::size_t CacheLines>
+constexpr UnrolledList<T, Allocator, CacheLines>::allocator_type UnrolledList<T, Allocator, CacheLines>::get_allocator() const noexcept {
+    return allocator_type(alloc_);
+}
+
+// Private functions
+
+template<class T, class Allocator, std::size_t CacheLines>
+void UnrolledList<T, Allocator, CacheLines>::destroyAndDealloc() noexcept {
+    Node* node {head_};
+    while(node) {
+        Node* next {node->next_};
+        std::destroy(node->slot(0), node->slot(node->count_));
+        node_traits::destroy(alloc_, node);
+        node_traits::deallocate(alloc_, node, 1);
+        node = next;
+    }
+    head_ = tail_ = nullptr;
+    size_ = 0;
+    node_count_ = 0;
+}
+
+template<class T, class Allocator, std::size_t CacheLines>
+UnrolledList<T, Allocator, CacheLines>::Node* UnrolledList<T, Allocator, CacheLines>::newNode(Node* after) {
+    Node* node {node_traits::allocate(alloc_, 1)};
+    node_traits::construct(alloc_, node);
+    node->prev_ = after;
+    node->next_ = after ? after->next_ : head_;
+    if(node->next_) {
+        node->next_->prev_ = node;
+    } else {
+        tail_ = node;
+    }
+    if(after) {
+        after->next_ = node;
+    } else {
+        head_ = node;
+    }
+    ++node_count_;
+    return node;
+}
+
+template<class T, class Allocator, std::size_t CacheLines>
+void UnrolledList<T, Allocator, CacheLines>::freeNode(Node* node) noexcept {
+    if(node->prev_) {
+        node->prev_->next_ = node->next_;
+    } else {
+        head_ = node->next_;
+    }
+    if(node->next_) {
+        node->next_->prev_ = node->prev_;
+    } else {
+        tail_ = node->prev_;
+    }
+    node_traits::destroy(alloc_, node);
+    node_traits::deallocate(alloc_, node, 1);
+    --node_count_;
+}
+
+template<class T, class Allocator, std::size_t CacheLines>
+void UnrolledList<T, Allocator, CacheLines>::split(Node* node) {
+    Node* right {newNode(node)};
+    size_type half {node->count_ / 2};
+    try {
+        std::uninitialized_move(node->slot(half), node->slot(node->count_), right->slot(0));
+    } catch(...) {
+        freeNode(right);
+        throw;
+    }
+    std::destroy(node->slot(half), node->slot(node->count_));
+    right->count_ = node->count_ - half;
+    node->count_ = half;
+}
+
+template<class T, class Allocator, std::size_t CacheLines>
+void UnrolledList<T, Allocator, CacheLines>::mergeWithNext(Node* node) noexcept {
+    Node* next {node->next_};
+    std::uninitialized_move(next->slot(0), next->slot(next->count_), node->slot(node->count_));
+    std::destroy(next->slot(0), next->slot(next->count_));
+    node->count_ += next->count_;
+    freeNode(next);
+}
+
+// Appending never moves an element, so there 'args' may refer to an element
+// of the list. Everywhere else the value gets built before elements move.
+template<class T, class Allocator, std::size_t CacheLines>
+template<class... Args>
+UnrolledList<T, Allocator, CacheLines>::iterator UnrolledList<T, Allocator, CacheLines>::emplaceAt(Node* node, size_type index, Args&&... args) {
+    if(!node) {
+        if(tail_ && tail_->count_ < kNodeCapacity) {
+            std::construct_at(tail_->slot(tail_->count_), std::forward<Args>(args)...);
+        } else {
+            Node* fresh {newNode(tail_)};
+            try {
+                std::construct_at(fresh->slot(0), std::forward<Args>(args)...);
+            } catch(...) {
+                freeNode(fresh);
+                throw;
+            }
+        }
+        ++tail_->count_;
+        ++size_;
+        return iterator(this, tail_, tail_->count_ - 1);
+    }
+
+    value_type value(std::forward<Args>(args)...);
+    if(node->count_ == kNodeCapacity) {
+        if(index == 0) {
+            // In front of a full node the element goes to the end of the
+            // previous node, or into a new node if that is full as well
+            if(!node->prev_ || node->prev_->count_ == kNodeCapacity) {
+                newNode(node->prev_);
+            }
+            node = node->prev_;
+            index = node->count_;
+        } else {
+            split(node);
+            if(index > node->count_) {
+                index -= node->count_;
+                node = node->next_;
+            }
+        }
+    }
+
+    size_type count {node->count_};
+    if(index == count) {
+        std::construct_at(node->slot(count), std::move(value));
+        ++node->count_;
+        ++size_;
+    } else {
+        std::construct_at(node->slot(count), std::move(*node->slot(count - 1)));
+        ++node->count_;
+        ++size_;
+        std::move_backward(node->slot(index), node->slot(count - 1), node->slot(count));
+        *node->slot(index) = std::move(value);
+    }
+    return iterator(this, node, index);
+}
+
+template<class T, class Allocator, std::size_t CacheLines>
+UnrolledList<T, Allocator, CacheLines>::iterator UnrolledList<T, Allocator, CacheLines>::eraseAt(Node* node, size_type index) {
+    std::move(node->slot(index + 1), node->slot(node->count_), node->slot(index));
+    std::destroy_at(node->slot(node->count_ - 1));
+    --node->count_;
+    --size_;
+
+    if(node->count_ == 0) {
+        Node* next {node->next_};
+        freeNode(node);
+        return iterator(this, next, 0);
+    }
+    // Keeps the nodes from thinning out, only if moving can't throw halfway
+    if constexpr(std::is_nothrow_move_constructible_v<T>) {
+        if(node->count_ < kNodeCapacity / 2) {
+            if(node->next_ && node->count_ + node->next_->count_ <= kNodeCapacity) {
+                mergeWithNext(node);
+            } else if(node->prev_ && node->prev_->count_ + node->count_ <= kNodeCapacity) {
+                index += node->prev_->count_;
+                node = node->prev_;
+                mergeWithNext(node);
+            }
+        }
+    }
+    if(index == node->count_) {
+        return iterator(this, node->next_, 0);
+    }
+    return iterator(this, node, index);
+}
+
+// Turns 'index' into the offset inside the returned node, walks from the
+// closer end
+template<class T, class Allocator, std::size_t CacheLines>
+UnrolledList<T, Allocator, CacheLines>::Node* UnrolledList<T, Allocator, CacheLines>::nodeOf(size_type& index) const noexcept {
+    if(index < size_ / 2) {
+        Node* node {head_};
+        while(index >= node->count_) {
+            index -= node->count_;
+            node = node->next_;
+        }
+        return node;
+    }
+    Node* node {tail_};
+    size_type first {size_ - node->count_};
+    while(index < first) {
+        node = node->prev_;
+        first -= node->count_;
+    }
+    index -= first;
+    return node;
+}
+
+}
+
+#endif // UNROLLEDLIST_HPP
@@ -2,12 +2,17 @@
 #define VECTORCLASS_HPP
 
 #include <iostream>
+#include <algorithm>
 #include <cstddef>
+#include <cstdlib>
+#include <cstring>
 #include <iterator>
 #include <initializer_list>
 #include <exception>
 #include <utility>
+#include <memory>
 #include <memory_resource>
+#include <new>
 #include <stdexcept>
 #include <limits>
 #include <type_traits>
@@ -20,10 +25,62 @@ namespace ds {
 template<typename T, typename... Ts>
 constexpr inline bool are_same_v = std::conjunction_v<std::is_same<T, Ts>...>;
 
+// Objects of a trivially relocatable type can be moved to another address
+// with memcpy, leaving nothing behind that needs to be destroyed.
+// Specialize it for types which are not trivially copyable but still
+// relocatable, like most types owning a heap pointer.
+template<class T>
+struct is_trivially_relocatable: std::is_trivially_copyable<T> {};
+
+template<class T>
+inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+// Grows the capacity by 'Num' / 'Den'. The first allocation fills at least
+// a cache line.
+template<std::size_t Num, std::size_t Den>
+struct FactorGrowth {
+    static_assert(Num > Den, "The capacity has to grow");
+
+    static std::size_t grow(std::size_t capacity, std::size_t required, std::size_t element_size) noexcept {
+        if(capacity == 0) {
+            return std::max(required, std::max<std::size_t>(64 / element_size, 1));
+        }
+        if(capacity > std::numeric_limits<std::size_t>::max() / Num) {
+            return required;
+        }
+        return std::max(required, capacity * Num / Den);
+    }
+};
+
+using DoublingGrowth = FactorGrowth<2, 1>;
+using HalfGrowth = FactorGrowth<3, 2>;
+
+// Grows like 'Base', but once the buffer spans more than a page its size
+// gets rounded up to whole pages, so no allocation ends on a partial page
+template<GrowthPolicy Base = HalfGrowth, std::size_t PageSize = 4096>
+struct PageGrowth {
+    static std::size_t grow(std::size_t capacity, std::size_t required, std::size_t element_size) noexcept {
+        std::size_t grown {Base::grow(capacity, required, element_size)};
+        if(grown * element_size < PageSize || grown > std::numeric_limits<std::size_t>::max() / element_size - PageSize) {
+            return grown;
+        }
+        std::size_t bytes {(grown * element_size + PageSize - 1) / PageSize * PageSize};
+        return bytes / element_size;
+    }
+};
+
+// Tag for resizing without value initializing the new elements. Trivial
+// types are left uninitialized, class types get default constructed.
+struct default_init_t {
+    explicit default_init_t() = default;
+};
+inline constexpr default_init_t default_init {};
+
 template<class T,class ... Args>
 decltype(auto) makeVector(T&& t, Args&&... args);
 
-template<class T, class Allocator = std::allocator<T>>
+// 'Growth' picks the new capacity whenever an insert does not fit
+template<class T, class Allocator = std::allocator<T>, GrowthPolicy Growth = DoublingGrowth>
 class VectorClass {
 // Type aliases
 public:
@@ -39,7 +96,14 @@ public:
     using size_type = traits_t::size_type;
     using reverse_iterator = std::reverse_iterator<iterator>;
     using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    using growth_policy = Growth;
 private:
+    // With std::allocator the buffer of a trivially relocatable type comes
+    // from malloc, so growing it can use realloc. For huge buffers glibc
+    // serves that with mremap and no element gets copied at all.
+    static constexpr bool kUseRealloc {std::is_same_v<Allocator, std::allocator<T>> && is_trivially_relocatable_v<T>
+                                       && alignof(T) <= alignof(std::max_align_t)};
+
     size_type size_ {};
     size_type capacity_ {};
     allocator alloc_ {};
@@ -62,7 +126,7 @@ public:
     // Type deductino constructor
     template<class InputIt, class Alloc = std::allocator<typename std::iterator_traits<InputIt>::value_type>>
     requires is_it<InputIt>
-    VectorClass(InputIt first, InputIt last, Alloc alloc = Alloc()): size_{static_cast<size_type>(std::distance(first, last))}, capacity_ {size_}, alloc_ {alloc}, array_ {traits_t::allocate(alloc_, capacity_)} {
+    VectorClass(InputIt first, InputIt last, Alloc alloc = Alloc()): size_{static_cast<size_type>(std::distance(first, last))}, capacity_ {size_}, alloc_ {alloc}, array_ {allocate(capacity_)} {
         int i {0};
         for(InputIt it{first}; it != last; ++it) {
             traits_t::construct(alloc_, array_ + i, *it);
@@ -75,9 +139,9 @@ public:
     ~VectorClass(); 
 
     // Overloading assignment operator
-    VectorClass<T, Allocator>& operator=(const VectorClass& other);
-    VectorClass<T, Allocator>& operator=(VectorClass&& other) noexcept;
-    VectorClass<T, Allocator>& operator=(std::initializer_list<T> l);
+    VectorClass<T, Allocator, Growth>& operator=(const VectorClass& other);
+    VectorClass<T, Allocator, Growth>& operator=(VectorClass&& other) noexcept;
+    VectorClass<T, Allocator, Growth>& operator=(std::initializer_list<T> l);
 
     // Assign
     void assign(size_type count, const T& value);
@@ -93,6 +157,10 @@ public:
     void reserve(size_type new_cap);
     void shrink_to_fit();
     void resize(size_type count, const value_type& value=T{});
+    // New elements get default initialized, which skips clearing the
+    // memory for trivial types, e.g. before reading a file into data()
+    void resize(size_type count, default_init_t);
+    void resize_uninitialized(size_type count) requires std::is_trivial_v<T>;
 
     // Modifiers
     void push_back(const T& value);
@@ -107,15 +175,22 @@ public:
     void emplace(const_iterator pos, Args&&... args) {
         insert(pos, value_type(std::forward<Args>(args)...));
     }
-    void clear();
-    void insert(const_iterator pos, const T& value);
-    void insert(const_iterator pos, T&& value);
-    void insert(const_iterator pos, size_type count, const T& value);
+    // Keeps the buffer
+    void clear() noexcept;
+    // Inserts shift the elements behind 'pos' inside of the buffer if it
+    // has room, else the buffer grows once for all new elements
+    iterator insert(const_iterator pos, const T& value);
+    iterator insert(const_iterator pos, T&& value);
+    iterator insert(const_iterator pos, size_type count, const T& value);
     template<class InputIt>
     requires is_it<InputIt> 
-    void insert(const_iterator pos, InputIt first, InputIt last);
-    void insert(const_iterator pos, std::initializer_list<T> ilist );
+    iterator insert(const_iterator pos, InputIt first, InputIt last);
+    iterator insert(const_iterator pos, std::initializer_list<T> ilist );
     iterator erase(const_iterator pos);
+    iterator erase(const_iterator first, const_iterator last);
+    // Moves the last element into 'pos' instead of shifting everything
+    // behind it. Does not keep the order of the elements.
+    iterator unordered_erase(const_iterator pos);
     void pop_back();
     void swap(VectorClass& other) noexcept;
 
@@ -152,6 +227,21 @@ public:
 
 private:
     void destroyAndDealloc();
+    pointer allocate(size_type count);
+    void deallocate(pointer ptr, size_type count) noexcept;
+    // Moves the elements into a buffer of 'new_cap' elements
+    void reallocate(size_type new_cap);
+    size_type grownCapacity(size_type required) const noexcept;
+    void destroyTail(size_type count) noexcept;
+    // Moves 'count' elements from 'src' to 'dst', nothing is left to
+    // destroy at 'src'. The ranges may overlap.
+    void relocate(pointer dst, pointer src, size_type count);
+    // Opens 'count' uninitialized slots at 'index' and returns the first one
+    pointer openGap(size_type index, size_type count);
+    // Fills the slots of a gap with 'construct(slot, n)'. If that throws,
+    // the gap gets closed again.
+    template<class F>
+    iterator insertGap(const_iterator pos, size_type count, F&& construct);
     template<class Type>
     void append(Type&& val);
     
@@ -165,51 +255,125 @@ decltype(auto) makeVector(T&& t, Args&&... args) {
 template<class InputIt, class Alloc = std::allocator<typename std::iterator_traits<InputIt>::value_type>>
 VectorClass(InputIt first, InputIt last, Alloc alloc = Alloc()) -> VectorClass<typename std::iterator_traits<InputIt>::value_type, Alloc>;
 
-template<class T, class Allocator>
-void VectorClass<T, Allocator>::destroyAndDealloc() {
-    iterator it{ &(array_[capacity_]) };
+template<class T, class Allocator, GrowthPolicy Growth>
+void VectorClass<T, Allocator, Growth>::destroyAndDealloc() {
+    iterator it{ array_ + size_ };
     while (it != array_) {
         traits_t::destroy(alloc_, --it);
     }
-    traits_t::deallocate(alloc_,array_ , capacity_);
+    deallocate(array_, capacity_);
     array_ = nullptr;
 }
 
-template<class T, class Allocator>
-VectorClass<T, Allocator>::VectorClass(const Allocator& alloc) noexcept: size_{0}, capacity_{0}, alloc_ {alloc} {}
+template<class T, class Allocator, GrowthPolicy Growth>
+VectorClass<T, Allocator, Growth>::pointer VectorClass<T, Allocator, Growth>::allocate(size_type count) {
+    if constexpr(kUseRealloc) {
+        if(count == 0) {
+            return nullptr;
+        }
+        void* ptr {std::malloc(count * sizeof(T))};
+        if(!ptr) {
+            throw std::bad_alloc();
+        }
+        return static_cast<pointer>(ptr);
+    } else {
+        return traits_t::allocate(alloc_, count);
+    }
+}
+
+template<class T, class Allocator, GrowthPolicy Growth>
+void VectorClass<T, Allocator, Growth>::deallocate(pointer ptr, size_type count) noexcept {
+    if constexpr(kUseRealloc) {
+        std::free(ptr);
+    } else if(ptr) {
+        traits_t::deallocate(alloc_, ptr, count);
+    }
+}
+
+// Trivially relocatable elements get moved with realloc or memcpy and the
+// old ones are not destroyed, everything else gets moved one by one
+template<class T, class Allocator, GrowthPolicy Growth>
+void VectorClass<T, Allocator, Growth>::reallocate(size_type new_cap) {
+    if constexpr(kUseRealloc) {
+        if(new_cap == 0) {
+            std::free(array_);
+            array_ = nullptr;
+        } else {
+            void* ptr {std::realloc(static_cast<void*>(array_), new_cap * sizeof(T))};
+            if(!ptr) {
+                throw std::bad_alloc();
+            }
+            array_ = static_cast<pointer>(ptr);
+        }
+    } else {
+        pointer new_arr {allocate(new_cap)};
+        if constexpr(is_trivially_relocatable_v<T>) {
+            if(size_ > 0) {
+                std::memcpy(static_cast<void*>(std::to_address(new_arr)), std::to_address(array_), size_ * sizeof(T));
+            }
+        } else {
+            size_type i {0};
+            try {
+                for(; i < size_; ++i) {
+                    traits_t::construct(alloc_, new_arr + i, std::move_if_noexcept(array_[i]));
+                }
+            } catch(...) {
+                while(i > 0) {
+                    traits_t::destroy(alloc_, new_arr + (--i));
+                }
+                deallocate(new_arr, new_cap);
+                throw;
+            }
+            for(i = size_; i > 0; --i) {
+                traits_t::destroy(alloc_, array_ + (i - 1));
+            }
+        }
+        deallocate(array_, capacity_);
+        array_ = new_arr;
+    }
+    capacity_ = new_cap;
+}
+
+template<class T, class Allocator, GrowthPolicy Growth>
+VectorClass<T, Allocator, Growth>::size_type VectorClass<T, Allocator, Growth>::grownCapacity(size_type required) const noexcept {
+    return std::max(required, static_cast<size_type>(Growth::grow(capacity_, required, sizeof(T))));
+}
+
+template<class T, class Allocator, GrowthPolicy Growth>
+VectorClass<T, Allocator, Growth>::VectorClass(const Allocator& alloc) noexcept: size_{0}, capacity_{0}, alloc_ {alloc} {}
 
-template<class T, class Allocator>
-VectorClass<T, Allocator>::VectorClass(size_type size, const T& value, const Allocator& alloc): capacity_ {size}, size_ {size}, alloc_ {alloc}, array_ { traits_t::allocate(alloc_, capacity_) } {
+template<class T, class Allocator, GrowthPolicy Growth>
+VectorClass<T, Allocator, Growth>::VectorClass(size_type size, const T& value, const Allocator& alloc): capacity_ {size}, size_ {size}, alloc_ {alloc}, array_ { allocate(capacity_) } {
     for(size_type i {0}; i < size_; ++i) {
         traits_t::construct(alloc_, array_ + i, value);
     }
 }
 
-template<class T, class Allocator>
-VectorClass<T, Allocator>::VectorClass(const VectorClass& other): size_ {other.size_}, capacity_{other.capacity_}, alloc_{traits_t::select_on_container_copy_construction(other.get_allocator())}, array_ {traits_t::allocate(alloc_, capacity_)} {
+template<class T, class Allocator, GrowthPolicy Growth>
+VectorClass<T, Allocator, Growth>::VectorClass(const VectorClass& other): size_ {other.size_}, capacity_{other.capacity_}, alloc_{traits_t::select_on_container_copy_construction(other.get_allocator())}, array_ {allocate(capacity_)} {
     for(size_type i {0}; i < size_; ++i) {
         traits_t::construct(alloc_, array_ + i, other[i]);
     }
 }
 
-template<class T, class Allocator>
-VectorClass<T, Allocator>::VectorClass(const VectorClass& other, const Allocator& alloc): size_ {other.size_}, capacity_{other.capacity_}, alloc_{alloc}, array_ {traits_t::allocate(alloc_, capacity_)} {
+template<class T, class Allocator, GrowthPolicy Growth>
+VectorClass<T, Allocator, Growth>::VectorClass(const VectorClass& other, const Allocator& alloc): size_ {other.size_}, capacity_{other.capacity_}, alloc_{alloc}, array_ {allocate(capacity_)} {
     for(size_type i {0}; i < size_; ++i) {
         traits_t::construct(alloc_, array_ + i, other[i]);
     }
 }
 
-template<class T, class Allocator>
-VectorClass<T, Allocator>::VectorClass(VectorClass&& other): size_ { other.size_ }, capacity_ {other.capacity_}, alloc_ {std::move(other.alloc_)}, array_ {other.array_} {
+template<class T, class Allocator, GrowthPolicy Growth>
+VectorClass<T, Allocator, Growth>::VectorClass(VectorClass&& other): size_ { other.size_ }, capacity_ {other.capacity_}, alloc_ {std::move(other.alloc_)}, array_ {other.array_} {
     other.array_ = nullptr;
     other.size_ = 0;
     other.capacity_ = 0;
 }
 
-//template<class T, class Allocator>
+//template<class T, class Allocator, GrowthPolicy Growth>
 //template<class InputIt>
 //requires is_it<InputIt>
-//VectorClass<T, Allocator>::VectorClass(InputIt first, InputIt last, const Allocator& alloc): size_{static_cast<size_type>(std::distance(first, last))}, capacity_ {size_}, alloc_ {alloc}, array_ {traits_t::allocate(alloc_, capacity_)} {
+//VectorClass<T, Allocator, Growth>::VectorClass(InputIt first, InputIt last, const Allocator& alloc): size_{static_cast<size_type>(std::distance(first, last))}, capacity_ {size_}, alloc_ {alloc}, array_ {allocate(capacity_)} {
 //    int i {0};
 //    for(InputIt it{first}; it != last; ++it) {
 //        traits_t::construct(alloc_, array_ + i, *it);
@@ -217,13 +381,13 @@ VectorClass<T, Allocator>::VectorClass(VectorClass&& other): size_ { other.size_
 //    }
 //}
 
-template<class T, class Allocator>
-VectorClass<T, Allocator>::~VectorClass() {
+template<class T, class Allocator, GrowthPolicy Growth>
+VectorClass<T, Allocator, Growth>::~VectorClass() {
     destroyAndDealloc();
 }
 
-template<class T, class Allocator>
-VectorClass<T, Allocator>::VectorClass(std::initializer_list<T> l, const Allocator& alloc): capacity_ {l.size()}, size_ { l.size()}, alloc_ {alloc}, array_ { traits_t::allocate(alloc_, capacity_)} {
+template<class T, class Allocator, GrowthPolicy Growth>
+VectorClass<T, Allocator, Growth>::VectorClass(std::initializer_list<T> l, const Allocator& alloc): capacity_ {l.size()}, size_ { l.size()}, alloc_ {alloc}, array_ { allocate(capacity_)} {
     size_type counter {0};
     for(auto& element: l) {
         traits_t::construct(alloc_, array_ + counter, element);
@@ -231,15 +395,15 @@ VectorClass<T, Allocator>::VectorClass(std::initializer_list<T> l, const Allocat
     }
 }
 
-template<class T, class Allocator>
-VectorClass<T, Allocator>& VectorClass<T, Allocator>::operator=(const VectorClass& other) {
+template<class T, class Allocator, GrowthPolicy Growth>
+VectorClass<T, Allocator, Growth>& VectorClass<T, Allocator, Growth>::operator=(const VectorClass& other) {
     if (&other == this)
         return *this;
 
     destroyAndDealloc();
     size_ = other.size_;
     capacity_ = other.capacity_;
-    array_ = traits_t::allocate(alloc_, capacity_);
+    array_ = allocate(capacity_);
 
     for(size_type i {0}; i <size_; ++i) {
         traits_t::construct(alloc_, array_ + i, other[i]);
@@ -247,8 +411,8 @@ VectorClass<T, Allocator>& VectorClass<T, Allocator>::operator=(const VectorClas
     return *this;
 }
 
-template<class T, class Allocator>
-VectorClass<T, Allocator>& VectorClass<T, Allocator>::operator=(VectorClass&& other) noexcept {
+template<class T, class Allocator, GrowthPolicy Growth>
+VectorClass<T, Allocator, Growth>& VectorClass<T, Allocator, Growth>::operator=(VectorClass&& other) noexcept {
     if (&other == this)
         return *this;
 
@@ -263,12 +427,12 @@ VectorClass<T, Allocator>& VectorClass<T, Allocator>::operator=(VectorClass&& ot
     return *this;
 }
 
-template<class T, class Allocator>
-VectorClass<T, Allocator>& VectorClass<T, Allocator>::operator=(std::initializer_list<T> l) {
+template<class T, class Allocator, GrowthPolicy Growth>
+VectorClass<T, Allocator, Growth>& VectorClass<T, Allocator, Growth>::operator=(std::initializer_list<T> l) {
     destroyAndDealloc();
     size_ = l.size();
     capacity_ = size_;
-    array_ = traits_t::allocate(alloc_, capacity_);
+    array_ = allocate(capacity_);
 
     size_type counter {0};
     for(auto& element: l) {
@@ -279,25 +443,25 @@ VectorClass<T, Allocator>& VectorClass<T, Allocator>::operator=(std::initializer
 }
 
 
-template<class T, class Allocator>
-void VectorClass<T, Allocator>::assign(size_type count, const T& value) {
+template<class T, class Allocator, GrowthPolicy Growth>
+void VectorClass<T, Allocator, Growth>::assign(size_type count, const T& value) {
     destroyAndDealloc();
     size_ = count;
     capacity_ = size_;
-    array_ = traits_t::allocate(alloc_, capacity_);
+    array_ = allocate(capacity_);
     for(size_type i {0}; i < size_; ++i) {
         traits_t::construct(alloc_, array_ + i, value);
     }
 }
 
-template<class T, class Allocator>
+template<class T, class Allocator, GrowthPolicy Growth>
 template<class InputIt>
 requires is_it<InputIt>
-void VectorClass<T, Allocator>::assign(InputIt first, InputIt last) {
+void VectorClass<T, Allocator, Growth>::assign(InputIt first, InputIt last) {
     destroyAndDealloc();
     size_ = std::distance(first, last);
     capacity_ = size_;
-    array_ = traits_t::allocate(alloc_, capacity_);
+    array_ = allocate(capacity_);
     size_type counter {0};
     for(auto i {first}; i != last; ++i) {
         traits_t::construct(alloc_, array_ + counter, *i);
@@ -305,12 +469,12 @@ void VectorClass<T, Allocator>::assign(InputIt first, InputIt last) {
     }
 }
 
-template<class T, class Allocator>
-void VectorClass<T, Allocator>::assign(std::initializer_list<T> l) {
+template<class T, class Allocator, GrowthPolicy Growth>
+void VectorClass<T, Allocator, Growth>::assign(std::initializer_list<T> l) {
     destroyAndDealloc();
     size_ = l.size();
     capacity_ = size_;
-    array_ = traits_t::allocate(alloc_, capacity_);
+    array_ = allocate(capacity_);
     size_type counter {0};
     for(auto& element: l) {
         traits_t::construct(alloc_, array_ + counter, element);
@@ -318,239 +482,174 @@ void VectorClass<T, Allocator>::assign(std::initializer_list<T> l) {
     }
 }
 
-template<class T, class Allocator>
-constexpr bool VectorClass<T, Allocator>::empty() const noexcept {
+template<class T, class Allocator, GrowthPolicy Growth>
+constexpr bool VectorClass<T, Allocator, Growth>::empty() const noexcept {
     return (size_ == 0);
 }
 
-template<class T, class Allocator>
-constexpr VectorClass<T, Allocator>::size_type VectorClass<T, Allocator>::size() const noexcept {
+template<class T, class Allocator, GrowthPolicy Growth>
+constexpr VectorClass<T, Allocator, Growth>::size_type VectorClass<T, Allocator, Growth>::size() const noexcept {
     return size_;
 }
 
-template<class T, class Allocator>
-void VectorClass<T, Allocator>::reserve(size_type new_cap) {
+template<class T, class Allocator, GrowthPolicy Growth>
+void VectorClass<T, Allocator, Growth>::reserve(size_type new_cap) {
     if(new_cap <= capacity_) {
         return;
     }
-    pointer new_arr  {traits_t::allocate(alloc_, new_cap)};
-    for (size_type i {0}; i < size_; ++i) {
-        traits_t::construct(alloc_, new_arr + i, std::move(array_[i]));
-    }
-    destroyAndDealloc();
-    capacity_ = new_cap;
-    array_ = new_arr;
-    new_arr = nullptr;
+    reallocate(new_cap);
 }
 
-template<class T, class Allocator>
-void VectorClass<T, Allocator>::shrink_to_fit() {
+template<class T, class Allocator, GrowthPolicy Growth>
+void VectorClass<T, Allocator, Growth>::shrink_to_fit() {
     if(size_ == capacity_) return;
-    pointer new_arr {traits_t::allocate(alloc_, size_)};
-    for(size_type i{0}; i < size_; ++i) 
-        traits_t::construct(alloc_, new_arr + i, std::move(array_[i]));
-    
-    destroyAndDealloc();
-    capacity_ = size_;
-    array_ = new_arr;
-    new_arr = nullptr;
+    reallocate(size_);
+}
 
+template<class T, class Allocator, GrowthPolicy Growth>
+void VectorClass<T, Allocator, Growth>::resize(size_type count, const value_type& value) {
+    if(count <= size_) {
+        destroyTail(count);
+        return;
+    }
+    if(count > capacity_) {
+        // 'value' could be one of the elements which are about to move
+        value_type copy(value);
+        reserve(grownCapacity(count));
+        for(; size_ < count; ++size_) {
+            traits_t::construct(alloc_, array_ + size_, copy);
+        }
+        return;
+    }
+    for(; size_ < count; ++size_) {
+        traits_t::construct(alloc_, array_ + size_, value);
+    }
 }
 
-template<class T, class Allocator>
-void VectorClass<T, Allocator>::resize(size_type count, const value_type& value) {
-    size_type old_size {size_};
-    if(count <= capacity_) {
-        size_ = count; 
-    } else {
-        reserve(count < capacity_ * 2 ? capacity_ * 2: count);
-        size_ = count;
+template<class T, class Allocator, GrowthPolicy Growth>
+void VectorClass<T, Allocator, Growth>::resize(size_type count, default_init_t) {
+    if(count <= size_) {
+        destroyTail(count);
+        return;
     }
-    for(size_type i {old_size}; i < size_; ++i) {
-        traits_t::construct(alloc_, array_ + i, value);
+    if(count > capacity_) {
+        reserve(grownCapacity(count));
     }
+    for(; size_ < count; ++size_) {
+        ::new(static_cast<void*>(std::to_address(array_ + size_))) T;
+    }
+}
 
+template<class T, class Allocator, GrowthPolicy Growth>
+void VectorClass<T, Allocator, Growth>::resize_uninitialized(size_type count) requires std::is_trivial_v<T> {
+    resize(count, default_init);
 }
 
-template<class T, class Allocator>
-constexpr VectorClass<T, Allocator>::size_type VectorClass<T, Allocator>::capacity() const noexcept {
+template<class T, class Allocator, GrowthPolicy Growth>
+constexpr VectorClass<T, Allocator, Growth>::size_type VectorClass<T, Allocator, Growth>::capacity() const noexcept {
     return capacity_;
 }
 
-template<class T, class Allocator>
-void VectorClass<T, Allocator>::push_back(const T& value) {
+template<class T, class Allocator, GrowthPolicy Growth>
+void VectorClass<T, Allocator, Growth>::push_back(const T& value) {
     append(value);
 }
 
-template<class T, class Allocator>
-void VectorClass<T, Allocator>::push_back(T&& value) {
+template<class T, class Allocator, GrowthPolicy Growth>
+void VectorClass<T, Allocator, Growth>::push_back(T&& value) {
     append(std::move(value));
 }
 
-template<class T, class Allocator>
-void VectorClass<T, Allocator>::clear() {
-    destroyAndDealloc();
-    array_ = traits_t::allocate(alloc_, capacity_);
-    size_ = 0;
+template<class T, class Allocator, GrowthPolicy Growth>
+void VectorClass<T, Allocator, Growth>::clear() noexcept {
+    destroyTail(0);
 }
 
-template<class T, class Allocator>
-void VectorClass<T, Allocator>::insert(const_iterator pos,const T& value) {
-    if(!((pos >= begin()) and (pos <= end()))) {
-        throw std::out_of_range("Iterator is out of bounds!");
-    }
-    size_type new_capacity {(size_ == capacity_)? capacity_* 2: capacity_};
-    pointer new_arr {traits_t::allocate(alloc_, new_capacity)};
-    ++size_;
-    size_type start = std::distance(cbegin(), pos);
-    size_type j {0};
-    for(size_type i {0}; i < size_; ++i) {
-        if(i == start) {
-            traits_t::construct(alloc_, new_arr + i, value);
-        } else {
-            traits_t::construct(alloc_, new_arr + i, std::move(array_[j]));
-            ++j;
-        }
-    }
-    destroyAndDealloc();
-    capacity_ = new_capacity;
-    array_ = new_arr;
-    new_arr = nullptr;
+// 'value' could be an element of this vector which gets shifted, so it
+// gets copied before any element moves
+template<class T, class Allocator, GrowthPolicy Growth>
+VectorClass<T, Allocator, Growth>::iterator VectorClass<T, Allocator, Growth>::insert(const_iterator pos, const T& value) {
+    value_type copy(value);
+    return insert(pos, std::move(copy));
 }
 
-template<class T, class Allocator>
-void VectorClass<T, Allocator>::insert(const_iterator pos,T&& value) {
-    if(!((pos >= begin()) and (pos <= end()))) {
-        throw std::out_of_range("Iterator is out of bounds!");
-    }
-    size_type new_capacity {(size_ == capacity_)?capacity_ * 2: capacity_};
-    pointer new_arr {traits_t::allocate(alloc_, new_capacity)};
-    ++size_;
-    size_type start = std::distance(cbegin(), pos);
-    size_type j {0};
-    for(size_type i {0}; i < size_; ++i) {
-        if(i == start) {
-            traits_t::construct(alloc_, new_arr + i, std::move(value));
-        } else {
-            traits_t::construct(alloc_, new_arr + i, std::move(array_[j]));
-            ++j;
-        }
-    }
-    destroyAndDealloc();
-    capacity_ = new_capacity;
-    array_ = new_arr;
-    new_arr = nullptr;
-
+template<class T, class Allocator, GrowthPolicy Growth>
+VectorClass<T, Allocator, Growth>::iterator VectorClass<T, Allocator, Growth>::insert(const_iterator pos, T&& value) {
+    return insertGap(pos, 1, [&](pointer slot, size_type) {
+        traits_t::construct(alloc_, slot, std::move(value));
+    });
 }
 
-template<class T, class Allocator>
-void VectorClass<T, Allocator>::insert(const_iterator pos, size_type count, const T& value) {
-    if(!((pos >= begin()) and (pos <= end()))) {
-        throw std::out_of_range("Iterator is out of bounds!");
-    }
-    size_type new_capacity {(size_ + count > capacity_)?(capacity_ +count) * 2: capacity_};
-    pointer new_arr {traits_t::allocate(alloc_, new_capacity)};
-    size_ += count;
-    size_type start = std::distance(cbegin(), pos);
-    size_type j {0};
-    for(size_type i {0}; i < size_; ++i) {
-        if(i >= start && i < start + count) {
-            traits_t::construct(alloc_, new_arr + i, value);
-        } else {
-            traits_t::construct(alloc_, new_arr + i, std::move(array_[j]));
-            ++j;
-        }
-    }
-    destroyAndDealloc();
-    capacity_ = new_capacity;
-    array_ = new_arr;
-    new_arr = nullptr;
+template<class T, class Allocator, GrowthPolicy Growth>
+VectorClass<T, Allocator, Growth>::iterator VectorClass<T, Allocator, Growth>::insert(const_iterator pos, size_type count, const T& value) {
+    value_type copy(value);
+    return insertGap(pos, count, [&](pointer slot, size_type) {
+        traits_t::construct(alloc_, slot, copy);
+    });
 }
 
-
-template<class T, class Allocator>
+template<class T, class Allocator, GrowthPolicy Growth>
 template<class InputIt>
 requires is_it<InputIt>
-void VectorClass<T, Allocator>::insert(const_iterator pos, InputIt first, InputIt last) {
+VectorClass<T, Allocator, Growth>::iterator VectorClass<T, Allocator, Growth>::insert(const_iterator pos, InputIt first, InputIt last) {
     const size_type count = std::distance(first, last);
-    if(!((pos >= begin()) and (pos <= end()))) {
+    return insertGap(pos, count, [&](pointer slot, size_type) {
+        traits_t::construct(alloc_, slot, *first);
+        ++first;
+    });
+}
+
+template<class T, class Allocator, GrowthPolicy Growth>
+VectorClass<T, Allocator, Growth>::iterator VectorClass<T, Allocator, Growth>::insert(const_iterator pos, std::initializer_list<T> iList) {
+    return insert(pos, iList.begin(), iList.end());
+}
+
+template<class T, class Allocator, GrowthPolicy Growth>
+VectorClass<T, Allocator, Growth>::iterator VectorClass<T, Allocator, Growth>::erase(const_iterator pos) {
+    if(!((pos >= begin()) and (pos < end()))) {
         throw std::out_of_range("Iterator is out of bounds!");
     }
-    size_type new_capacity {(size_ + count > capacity_)?(capacity_ +count) * 2: capacity_};
-    pointer new_arr {traits_t::allocate(alloc_, new_capacity)};
-    size_ += count;
-    size_type start = std::distance(cbegin(), pos);
-    size_type j {0};
-    InputIt iter {first};
-    for(size_type i {0}; i < size_; ++i) {
-        if(i >= start && i < start + count) {
-            traits_t::construct(alloc_, new_arr + i, (*iter));
-            ++iter;
-        } else {
-            traits_t::construct(alloc_, new_arr + i, std::move(array_[j]));
-            ++j;
-        }
-    }
-    destroyAndDealloc();
-    capacity_ = new_capacity;
-    array_ = new_arr;
-    new_arr = nullptr;
-
+    return erase(pos, pos + 1);
 }
 
-template<class T, class Allocator>
-void VectorClass<T, Allocator>::insert(const_iterator pos, std::initializer_list<T> iList) {
-    const size_type count {iList.size()};
-    if(!((pos >= begin()) and (pos <= end()))) {
+template<class T, class Allocator, GrowthPolicy Growth>
+VectorClass<T, Allocator, Growth>::iterator VectorClass<T, Allocator, Growth>::erase(const_iterator first, const_iterator last) {
+    if(!((first >= begin()) and (first <= last) and (last <= end()))) {
         throw std::out_of_range("Iterator is out of bounds!");
     }
-    size_type new_capacity {(size_ + count > capacity_)?(capacity_ +count) * 2: capacity_};
-    pointer new_arr {traits_t::allocate(alloc_, new_capacity)};
-    size_ += count;
-    size_type start = std::distance(cbegin(), pos);
-    size_type j {0};
-    for(size_type i {0}; i < size_; ++i) {
-        if(i == start) {
-            for(auto& element: iList) {
-                traits_t::construct(alloc_, new_arr + i, element);
-                if (i != +count - 1) {
-                    ++i;
-                }
-            }
-        } else {
-            traits_t::construct(alloc_, new_arr + i, std::move(array_[j]));
-            ++j;
-        }
+    iterator it = begin() + std::distance(cbegin(), first);
+    size_type count = std::distance(first, last);
+    for(size_type i {0}; i < count; ++i) {
+        traits_t::destroy(alloc_, it + i);
     }
-    destroyAndDealloc();
-    capacity_ = new_capacity;
-    array_ = new_arr;
-    new_arr = nullptr;
+    relocate(it, it + count, std::distance(it + count, end()));
+    size_ -= count;
+    return it;
 }
 
-
-template<class T, class Allocator>
-VectorClass<T, Allocator>::iterator VectorClass<T, Allocator>::erase(const_iterator pos) {
-    if(!((pos >= begin()) and (pos <= end()))) {
+template<class T, class Allocator, GrowthPolicy Growth>
+VectorClass<T, Allocator, Growth>::iterator VectorClass<T, Allocator, Growth>::unordered_erase(const_iterator pos) {
+    if(!((pos >= begin()) and (pos < end()))) {
         throw std::out_of_range("Iterator is out of bounds!");
     }
     iterator it = begin() + std::distance(cbegin(), pos);
-    traits_t::destroy(alloc_, it);
-    std::copy(it + 1, end(), it);
-    --size_;
-    return it; 
+    if(it != end() - 1) {
+        *it = std::move(back());
+    }
+    pop_back();
+    return it;
 }
 
-template<class T, class Allocator>
-void VectorClass<T, Allocator>::pop_back() {
+template<class T, class Allocator, GrowthPolicy Growth>
+void VectorClass<T, Allocator, Growth>::pop_back() {
     if (size_ == 0) {
         return;
     }
     traits_t::destroy(alloc_, array_ + (--size_));
 }
 
-template<class T, class Allocator>
-void VectorClass<T, Allocator>::swap(VectorClass& other) noexcept {
+template<class T, class Allocator, GrowthPolicy Growth>
+void VectorClass<T, Allocator, Growth>::swap(VectorClass& other) noexcept {
     using std::swap;
     swap(size_, other.size_);
     swap(capacity_, other.capacity_);
@@ -558,132 +657,208 @@ void VectorClass<T, Allocator>::swap(VectorClass& other) noexcept {
     swap(alloc_, other.alloc_);
 }
 
-template<class T, class Allocator>
-constexpr VectorClass<T, Allocator>::iterator VectorClass<T, Allocator>::begin() noexcept {
+template<class T, class Allocator, GrowthPolicy Growth>
+constexpr VectorClass<T, Allocator, Growth>::iterator VectorClass<T, Allocator, Growth>::begin() noexcept {
     return array_;
 }
 
-template<class T, class Allocator>
-constexpr VectorClass<T, Allocator>::const_iterator VectorClass<T, Allocator>::begin() const noexcept {
+template<class T, class Allocator, GrowthPolicy Growth>
+constexpr VectorClass<T, Allocator, Growth>::const_iterator VectorClass<T, Allocator, Growth>::begin() const noexcept {
     return array_;
 }
 
-template<class T, class Allocator>
-constexpr VectorClass<T, Allocator>::const_iterator VectorClass<T, Allocator>::cbegin() const noexcept {
+template<class T, class Allocator, GrowthPolicy Growth>
+constexpr VectorClass<T, Allocator, Growth>::const_iterator VectorClass<T, Allocator, Growth>::cbegin() const noexcept {
     return array_;
 }
 
-template<class T, class Allocator>
-constexpr VectorClass<T, Allocator>::iterator VectorClass<T, Allocator>::end() noexcept {
+template<class T, class Allocator, GrowthPolicy Growth>
+constexpr VectorClass<T, Allocator, Growth>::iterator VectorClass<T, Allocator, Growth>::end() noexcept {
     return array_ + size_;
 }
 
-template<class T, class Allocator>
-constexpr VectorClass<T, Allocator>::const_iterator VectorClass<T, Allocator>::end() const noexcept {
+template<class T, class Allocator, GrowthPolicy Growth>
+constexpr VectorClass<T, Allocator, Growth>::const_iterator VectorClass<T, Allocator, Growth>::end() const noexcept {
     return array_ + size_;
 }
 
-template<class T, class Allocator>
-constexpr VectorClass<T, Allocator>::const_iterator VectorClass<T, Allocator>::cend() const noexcept {
+template<class T, class Allocator, GrowthPolicy Growth>
+constexpr VectorClass<T, Allocator, Growth>::const_iterator VectorClass<T, Allocator, Growth>::cend() const noexcept {
     return array_ + size_;
 }
 
-template<class T, class Allocator>
-constexpr VectorClass<T, Allocator>::reverse_iterator VectorClass<T, Allocator>::rbegin() noexcept {
+template<class T, class Allocator, GrowthPolicy Growth>
+constexpr VectorClass<T, Allocator, Growth>::reverse_iterator VectorClass<T, Allocator, Growth>::rbegin() noexcept {
     return reverse_iterator(array_ + size_);
 }
 
-template<class T, class Allocator>
-constexpr VectorClass<T, Allocator>::const_reverse_iterator VectorClass<T, Allocator>::rbegin() const noexcept {
+template<class T, class Allocator, GrowthPolicy Growth>
+constexpr VectorClass<T, Allocator, Growth>::const_reverse_iterator VectorClass<T, Allocator, Growth>::rbegin() const noexcept {
     return reverse_iterator(array_ + size_);
 }
 
-template<class T, class Allocator>
-constexpr VectorClass<T, Allocator>::const_reverse_iterator VectorClass<T, Allocator>::crbegin() const noexcept {
+template<class T, class Allocator, GrowthPolicy Growth>
+constexpr VectorClass<T, Allocator, Growth>::const_reverse_iterator VectorClass<T, Allocator, Growth>::crbegin() const noexcept {
     return reverse_iterator(array_ + size_);
 }
 
-template<class T, class Allocator>
-constexpr VectorClass<T, Allocator>::reverse_iterator VectorClass<T, Allocator>::rend() noexcept {
+template<class T, class Allocator, GrowthPolicy Growth>
+constexpr VectorClass<T, Allocator, Growth>::reverse_iterator VectorClass<T, Allocator, Growth>::rend() noexcept {
     return reverse_iterator(array_);
 }
 
-template<class T, class Allocator>
-constexpr VectorClass<T, Allocator>::const_reverse_iterator VectorClass<T, Allocator>::rend() const noexcept {
+template<class T, class Allocator, GrowthPolicy Growth>
+constexpr VectorClass<T, Allocator, Growth>::const_reverse_iterator VectorClass<T, Allocator, Growth>::rend() const noexcept {
     return reverse_iterator(array_);
 }
 
-template<class T, class Allocator>
-constexpr VectorClass<T, Allocator>::const_reverse_iterator VectorClass<T, Allocator>::crend() const noexcept {
+template<class T, class Allocator, GrowthPolicy Growth>
+constexpr VectorClass<T, Allocator, Growth>::const_reverse_iterator VectorClass<T, Allocator, Growth>::crend() const noexcept {
     return reverse_iterator(array_);
 }
 
-template<class T, class Allocator>
-constexpr VectorClass<T, Allocator>::reference VectorClass<T, Allocator>::front() {
+template<class T, class Allocator, GrowthPolicy Growth>
+constexpr VectorClass<T, Allocator, Growth>::reference VectorClass<T, Allocator, Growth>::front() {
     return array_[0];
 }
 
-template<class T, class Allocator>
-constexpr VectorClass<T, Allocator>::const_reference VectorClass<T, Allocator>::front() const {
+template<class T, class Allocator, GrowthPolicy Growth>
+constexpr VectorClass<T, Allocator, Growth>::const_reference VectorClass<T, Allocator, Growth>::front() const {
     return array_[0];
 }
 
-template<class T, class Allocator>
-constexpr VectorClass<T, Allocator>::reference VectorClass<T, Allocator>::back() {
+template<class T, class Allocator, GrowthPolicy Growth>
+constexpr VectorClass<T, Allocator, Growth>::reference VectorClass<T, Allocator, Growth>::back() {
     return array_[size_ - 1];
 }
 
-template<class T, class Allocator>
-constexpr VectorClass<T, Allocator>::const_reference VectorClass<T, Allocator>::back() const {
+template<class T, class Allocator, GrowthPolicy Growth>
+constexpr VectorClass<T, Allocator, Growth>::const_reference VectorClass<T, Allocator, Growth>::back() const {
     return array_[size_ - 1];
 }
 
-template<class T, class Allocator>
-VectorClass<T, Allocator>::pointer VectorClass<T, Allocator>::data() noexcept {
+template<class T, class Allocator, GrowthPolicy Growth>
+VectorClass<T, Allocator, Growth>::pointer VectorClass<T, Allocator, Growth>::data() noexcept {
     return array_;
 }
 
-template<class T, class Allocator>
-VectorClass<T, Allocator>::const_pointer VectorClass<T, Allocator>::data() const noexcept {
+template<class T, class Allocator, GrowthPolicy Growth>
+VectorClass<T, Allocator, Growth>::const_pointer VectorClass<T, Allocator, Growth>::data() const noexcept {
     return array_;
 }
 
-template<class T, class Allocator>
-VectorClass<T, Allocator>::reference VectorClass<T, Allocator>::operator[] (const size_type index) {
+template<class T, class Allocator, GrowthPolicy Growth>
+VectorClass<T, Allocator, Growth>::reference VectorClass<T, Allocator, Growth>::operator[] (const size_type index) {
     return array_[index];
 }
 
-template<class T, class Allocator>
-VectorClass<T, Allocator>::const_reference VectorClass<T, Allocator>::operator[] (const size_type index) const {
+template<class T, class Allocator, GrowthPolicy Growth>
+VectorClass<T, Allocator, Growth>::const_reference VectorClass<T, Allocator, Growth>::operator[] (const size_type index) const {
     return array_[index];
 }
 
-template<class T, class Allocator>
-VectorClass<T, Allocator>::reference VectorClass<T, Allocator>::at(const size_type index) {
+template<class T, class Allocator, GrowthPolicy Growth>
+VectorClass<T, Allocator, Growth>::reference VectorClass<T, Allocator, Growth>::at(const size_type index) {
     if(!(index < size_))
         throw std::out_of_range("Index out of range");
     return array_[index];
 }
 
 
-template<class T, class Allocator>
-constexpr VectorClass<T, Allocator>::allocator VectorClass<T, Allocator>::get_allocator() const noexcept {
+template<class T, class Allocator, GrowthPolicy Growth>
+constexpr VectorClass<T, Allocator, Growth>::allocator VectorClass<T, Allocator, Growth>::get_allocator() const noexcept {
     return alloc_;
 }
 
-template<class T, class Allocator>
-VectorClass<T, Allocator>::const_reference VectorClass<T, Allocator>::at(const size_type index) const {
+template<class T, class Allocator, GrowthPolicy Growth>
+VectorClass<T, Allocator, Growth>::const_reference VectorClass<T, Allocator, Growth>::at(const size_type index) const {
     if(!(index < size_))
         throw std::out_of_range("Index out of range");
     return array_[index];
 }
 
-template<class T, class Allocator>
+// Destroys the elements from 'count' on
+template<class T, class Allocator, GrowthPolicy Growth>
+void VectorClass<T, Allocator, Growth>::destroyTail(size_type count) noexcept {
+    while(size_ > count) {
+        traits_t::destroy(alloc_, array_ + (--size_));
+    }
+}
+
+template<class T, class Allocator, GrowthPolicy Growth>
+void VectorClass<T, Allocator, Growth>::relocate(pointer dst, pointer src, size_type count) {
+    if constexpr(is_trivially_relocatable_v<T>) {
+        if(count > 0) {
+            std::memmove(static_cast<void*>(std::to_address(dst)), std::to_address(src), count * sizeof(T));
+        }
+    } else if(dst < src) {
+        for(size_type i {0}; i < count; ++i) {
+            traits_t::construct(alloc_, dst + i, std::move(src[i]));
+            traits_t::destroy(alloc_, src + i);
+        }
+    } else {
+        for(size_type i {count}; i > 0; --i) {
+            traits_t::construct(alloc_, dst + (i - 1), std::move(src[i - 1]));
+            traits_t::destroy(alloc_, src + (i - 1));
+        }
+    }
+}
+
+// Without room the elements before and behind the gap get relocated into
+// the new buffer separately, so every element moves only once
+template<class T, class Allocator, GrowthPolicy Growth>
+VectorClass<T, Allocator, Growth>::pointer VectorClass<T, Allocator, Growth>::openGap(size_type index, size_type count) {
+    if(size_ + count <= capacity_) {
+        relocate(array_ + index + count, array_ + index, size_ - index);
+    } else {
+        size_type new_cap {grownCapacity(size_ + count)};
+        pointer new_arr {allocate(new_cap)};
+        relocate(new_arr, array_, index);
+        relocate(new_arr + index + count, array_ + index, size_ - index);
+        deallocate(array_, capacity_);
+        array_ = new_arr;
+        capacity_ = new_cap;
+    }
+    return array_ + index;
+}
+
+template<class T, class Allocator, GrowthPolicy Growth>
+template<class F>
+VectorClass<T, Allocator, Growth>::iterator VectorClass<T, Allocator, Growth>::insertGap(const_iterator pos, size_type count, F&& construct) {
+    if(!((pos >= begin()) and (pos <= end()))) {
+        throw std::out_of_range("Iterator is out of bounds!");
+    }
+    size_type index = std::distance(cbegin(), pos);
+    if(count == 0) {
+        return begin() + index;
+    }
+    pointer gap {openGap(index, count)};
+    size_type done {0};
+    try {
+        for(; done < count; ++done) {
+            construct(gap + done, done);
+        }
+    } catch(...) {
+        while(done > 0) {
+            traits_t::destroy(alloc_, gap + (--done));
+        }
+        relocate(gap, gap + count, size_ - index);
+        throw;
+    }
+    size_ += count;
+    return gap;
+}
+
+template<class T, class Allocator, GrowthPolicy Growth>
 template<class Type>
-void VectorClass<T, Allocator>::append(Type&& val) {
+void VectorClass<T, Allocator, Growth>::append(Type&& val) {
     if(size_ == capacity_) {
-        size_type new_cap {capacity_ == 0 ? 1 : capacity_ * 2};
-        reserve(capacity_ == 0 ? 1 : capacity_ * 2);
+        // 'val' may be an element of the old buffer, v.push_back(v[0]),
+        // take it out before the buffer goes away
+        value_type value(std::forward<Type>(val));
+        reallocate(grownCapacity(size_ + 1));
+        traits_t::construct(alloc_, array_ + (size_++), std::move(value));
+        return;
     }
     // Increment after inserting because next free element is
     // size_ not ++size_
@@ -0,0 +1,120 @@
+#include "Ds/concurrenthashtable.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <exception>
+
+TEST_CASE("Test concurrent ht constructors and size functions", "[concurrentht]") {
+
+    //explicit ConcurrentHT(size_type capacity, size_type shard_count);
+    SECTION("Shard count gets rounded up to a power of two") {
+        ds::ConcurrentHT<int, int> ht(1000, 6);
+        REQUIRE(ht.shard_count() == 8);
+        REQUIRE(ht.size() == 0);
+        REQUIRE(ht.empty());
+    }
+}
+
+TEST_CASE("Test concurrent ht modifier and access functions", "[concurrentht]") {
+    ds::ConcurrentHT<int, std::string> ht(1000, 4);
+
+    //bool insert(const key_type& key, const mapped_type& value);
+    SECTION("Insert only adds missing keys") {
+        CHECK(ht.insert(1, "a"));
+        CHECK(!ht.insert(1, "b"));
+        CHECK(ht.at(1) == "a");
+        CHECK(ht.size() == 1);
+    }
+
+    //template<class Type>
+    //bool insert_or_assign(const key_type& key, Type&& obj);
+    SECTION("insert_or_assign returns true if inserted, false if assigned") {
+        int key {2};
+        CHECK(ht.insert_or_assign(key, "a"));
+        CHECK(!ht.insert_or_assign(key, "b"));
+        CHECK(ht.at(key) == "b");
+    }
+
+    //template<class... Args>
+    //bool emplace(Args&&... args);
+    SECTION("Emplace constructs the pair from 'args'") {
+        CHECK(ht.emplace(3, "c"));
+        CHECK(!ht.emplace(3, "d"));
+        CHECK(ht.exists(3));
+    }
+
+    //mapped_type at(const key_type& key) const;
+    SECTION("At throws std::out_of_range for missing keys") {
+        CHECK_THROWS_AS(ht.at(4), std::out_of_range);
+    }
+
+    //template<class F>
+    //bool visit(const key_type& key, F&& f);
+    SECTION("Visit modifies the value in place") {
+        ht.insert(5, "x");
+        CHECK(ht.visit(5, [](std::string& value) { value += "y"; }));
+        CHECK(!ht.visit(6, [](std::string&) {}));
+        CHECK(ht.at(5) == "xy");
+    }
+}
+
+TEST_CASE("Test concurrent ht from multiple threads", "[concurrentht]") {
+    constexpr int threads {8};
+    constexpr int per_thread {2000};
+    ds::ConcurrentHT<int, int> ht(threads * per_thread, 16);
+
+    //bool insert(const key_type& key, const mapped_type& value);
+    SECTION("Every insert of every thread ends up in the table") {
+        std::vector<std::jthread> workers;
+        for(int t {0}; t < threads; ++t) {
+            workers.emplace_back([&ht, t]() {
+                for(int i {0}; i < per_thread; ++i) {
+                    ht.insert(t * per_thread + i, t);
+                }
+            });
+        }
+        workers.clear();
+
+        CHECK(ht.size() == threads * per_thread);
+        CHECK(ht.at(per_thread * 3 + 5) == 3);
+    }
+
+    //template<class F>
+    //bool visit(const key_type& key, F&& f);
+    SECTION("Concurrent visits of the same key do not lose updates") {
+        ht.insert(0, 0);
+        std::vector<std::jthread> workers;
+        for(int t {0}; t < threads; ++t) {
+            workers.emplace_back([&ht]() {
+                for(int i {0}; i < per_thread; ++i) {
+                    ht.visit(0, [](int& value) { ++value; });
+                }
+            });
+        }
+        workers.clear();
+
+        CHECK(ht.at(0) == threads * per_thread);
+    }
+
+    //template<class F>
+    //void for_each_shard(F&& f, size_type threads) const;
+    SECTION("for_each_shard visits every shard once") {
+        for(int i {0}; i < 1000; ++i) {
+            ht.insert(i, i);
+        }
+        std::atomic<std::size_t> shards {0};
+        std::atomic<std::size_t> elements {0};
+        ht.for_each_shard([&](const auto& shard) {
+            ++shards;
+            elements += shard.size();
+        }, 4);
+
+        CHECK(shards == ht.shard_count());
+        CHECK(elements == 1000);
+    }
+}
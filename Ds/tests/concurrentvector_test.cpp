@@ -0,0 +1,124 @@
+#include "Ds/concurrentvector.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <exception>
+
+using size_type = ds::ConcurrentVector<int>::size_type;
+
+TEST_CASE("Test concurrent vector modifier and access functions", "[ConcurrentVector]") {
+    ds::ConcurrentVector<std::string, std::allocator<std::string>, 4> v;
+
+    //ConcurrentVector();
+    SECTION("An empty vector does not allocate") {
+        CHECK(v.empty());
+        CHECK(v.size() == 0);
+        CHECK(v.capacity() == 0);
+    }
+
+    //size_type push_back(const T& value);
+    SECTION("push_back returns the index of the new element") {
+        std::string value {"a"};
+        CHECK(v.push_back(value) == 0);
+        CHECK(v.push_back("b") == 1);
+        CHECK(v.emplace_back(3, 'c') == 2);
+        CHECK(v.size() == 3);
+        CHECK(v[2] == "ccc");
+        CHECK(v.at(0) == "a");
+        CHECK_THROWS_AS(v.at(3), std::out_of_range);
+    }
+
+    //void reserve(size_type new_cap);
+    SECTION("Growing never moves an element") {
+        v.reserve(10);
+        CHECK(v.capacity() >= 10);
+        v.push_back("first");
+        const std::string* first {&v[0]};
+        for(int i {0}; i < 1000; ++i) {
+            v.push_back(std::to_string(i));
+        }
+        CHECK(&v[0] == first);
+        CHECK(v[1000] == "999");
+        CHECK(v.end() - v.begin() == 1001);
+    }
+
+    //void clear() noexcept;
+    SECTION("Clear keeps the blocks") {
+        for(int i {0}; i < 100; ++i) {
+            v.push_back(std::to_string(i));
+        }
+        size_type capacity {v.capacity()};
+        v.clear();
+        CHECK(v.empty());
+        CHECK(v.capacity() == capacity);
+        CHECK(v.push_back("again") == 0);
+    }
+}
+
+TEST_CASE("Test concurrent vector from multiple threads", "[ConcurrentVector]") {
+    constexpr int threads {8};
+    constexpr int per_thread {5000};
+    ds::ConcurrentVector<int, std::allocator<int>, 16> v;
+
+    //size_type push_back(T&& value);
+    SECTION("Every append of every thread gets its own index") {
+        std::vector<std::vector<size_type>> indices(threads);
+        std::vector<std::jthread> workers;
+        for(int t {0}; t < threads; ++t) {
+            workers.emplace_back([&v, &indices, t]() {
+                for(int i {0}; i < per_thread; ++i) {
+                    indices[t].push_back(v.push_back(t * per_thread + i));
+                }
+            });
+        }
+        workers.clear();
+
+        REQUIRE(v.size() == threads * per_thread);
+        std::vector<int> values(v.begin(), v.end());
+        std::sort(values.begin(), values.end());
+        for(int i {0}; i < threads * per_thread; ++i) {
+            REQUIRE(values[i] == i);
+        }
+        for(int t {0}; t < threads; ++t) {
+            // Indices of one thread increase and point to its own values
+            CHECK(std::is_sorted(indices[t].begin(), indices[t].end()));
+            CHECK(v[indices[t].back()] == t * per_thread + per_thread - 1);
+        }
+    }
+
+    //size_type size() const noexcept;
+    SECTION("Readers only see fully constructed elements") {
+        std::atomic<bool> failed {false};
+        std::vector<std::jthread> workers;
+        for(int t {0}; t < threads; ++t) {
+            workers.emplace_back([&v]() {
+                for(int i {0}; i < per_thread; ++i) {
+                    v.emplace_back(i + 1);
+                }
+            });
+        }
+        std::jthread reader([&v, &failed]() {
+            size_type seen {0};
+            while(seen < threads * per_thread) {
+                size_type size {v.size()};
+                for(; seen < size; ++seen) {
+                    if(v[seen] == 0) {
+                        failed = true;
+                    }
+                }
+                std::this_thread::yield();
+            }
+        });
+        workers.clear();
+        reader.join();
+
+        CHECK_FALSE(failed);
+        CHECK(v.size() == threads * per_thread);
+    }
+}
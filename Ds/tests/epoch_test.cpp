@@ -0,0 +1,111 @@
+#include "Ds/epoch.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Counts its own destruction
+struct Tracked {
+    explicit Tracked(std::atomic<int>& deleted): deleted_ {deleted} {}
+    ~Tracked() { ++deleted_; }
+
+    std::atomic<int>& deleted_;
+};
+
+}
+
+TEST_CASE("Test own implemented EpochDomain", "[epoch]") {
+    std::atomic<int> deleted {0};
+
+    //template<class U>
+    //void retire(U* ptr);
+    SECTION("Without pinned readers retired objects get deleted after two epochs") {
+        ds::EpochDomain domain;
+        domain.retire(new Tracked(deleted));
+        CHECK(deleted == 0);
+        domain.collect();
+        CHECK(deleted == 1);
+        CHECK(domain.pending() == 0);
+        CHECK(domain.epoch() == 2);
+    }
+
+    //Guard pin() const;
+    SECTION("A pinned reader keeps retired objects alive") {
+        ds::EpochDomain domain;
+        {
+            auto guard = domain.pin();
+            auto nested = domain.pin();
+            domain.retire(new Tracked(deleted));
+            for(int i {0}; i < 10; ++i) {
+                domain.collect();
+            }
+            CHECK(deleted == 0);
+            CHECK(domain.pending() == 1);
+        }
+        domain.collect();
+        domain.collect();
+        CHECK(deleted == 1);
+    }
+
+    //Guard pin() const;
+    SECTION("Readers on other threads hold back the epoch only while pinned") {
+        ds::EpochDomain domain;
+        std::atomic<bool> pinned {false};
+        std::atomic<bool> release {false};
+        std::jthread reader([&]() {
+            auto guard = domain.pin();
+            pinned = true;
+            while(!release) {
+                std::this_thread::yield();
+            }
+        });
+        while(!pinned) {
+            std::this_thread::yield();
+        }
+
+        domain.retire(new Tracked(deleted));
+        domain.collect();
+        domain.collect();
+        CHECK(deleted == 0);
+
+        release = true;
+        reader.join();
+        domain.collect();
+        domain.collect();
+        CHECK(deleted == 1);
+    }
+
+    //~EpochDomain();
+    SECTION("Destroying the domain deletes everything still pending") {
+        {
+            ds::EpochDomain domain;
+            auto guard = domain.pin();
+            domain.retire(new Tracked(deleted));
+            domain.retire(new Tracked(deleted));
+        }
+        CHECK(deleted == 2);
+    }
+}
+
+TEST_CASE("Test own implemented EpochDomain with many threads", "[epoch]") {
+    //Guard pin() const;
+    SECTION("Threads beyond the first slot block get their own slots") {
+        ds::EpochDomain domain;
+        std::atomic<int> deleted {0};
+        std::vector<std::jthread> readers;
+        for(int t {0}; t < 100; ++t) {
+            readers.emplace_back([&domain]() {
+                for(int i {0}; i < 100; ++i) {
+                    auto guard = domain.pin();
+                }
+            });
+        }
+        readers.clear();
+        domain.retire(new Tracked(deleted));
+        domain.collect();
+        CHECK(deleted == 1);
+    }
+}
@@ -9,19 +9,28 @@
 #include <initializer_list>
 #include <utility>
 #include <exception>
+#include <stdexcept>
+#include <string>
+#include <bit>
+#include <memory>
+#include <span>
+#include <vector>
+#include <algorithm>
+#include <string_view>
+#include <list>
 
 
 TEST_CASE("Test own implemented Hashtable constructors", "[hashtable]") {
 
     //HashTable(size_type size);
-    SECTION("Construct HashTable with size passed to constructor") {
+    SECTION("Construct HashTable with size rounded up to the next power of two") {
         ds::HashTable<int, int> ht(20000);
         REQUIRE(ht.size()==0);
-        REQUIRE(ht.capacity()==20000);
+        REQUIRE(ht.capacity()==32768);
 
-        ds::HashTable<int, int> ht1(10000);
+        ds::HashTable<int, int> ht1(16384);
         REQUIRE(ht1.size()==0);
-        REQUIRE(ht1.capacity()==10000);
+        REQUIRE(ht1.capacity()==16384);
     }
 
     //HashTable(std::initializer_list<value_type> iList);
@@ -75,7 +84,7 @@ TEST_CASE("Test own implemented Hashtable size functions", "[hashtable]") {
     //sconstexpr size_type capacity() const;
     SECTION("Return capacity of HashTable") {
         ds::HashTable<int, int> ht(20000);
-        REQUIRE(ht.capacity()==20000);
+        REQUIRE(ht.capacity()==32768);
     }
 
     //constexpr bool empty() const;
@@ -135,3 +144,444 @@ TEST_CASE("Test own implemented HashTables modifier functions", "[hashtable]") {
     }
 
 }
+
+TEST_CASE("Test own implemented HashTables group probing", "[hashtable]") {
+
+    SECTION("Find keys in a table smaller than one group") {
+        ds::HashTable<int, int> ht(5);
+        for(int i {0}; i < 5; ++i) {
+            CHECK(ht.insert(i, i * 10));
+        }
+        CHECK(ht.size() == 5);
+        for(int i {0}; i < 5; ++i) {
+            CHECK(ht[i] == i * 10);
+        }
+        CHECK(!ht.exists(5));
+    }
+
+    SECTION("Keys behind an erased slot can still be found") {
+        ds::HashTable<int, int> ht(100);
+        for(int i {0}; i < 100; ++i) {
+            ht.insert(i, i);
+        }
+        for(int i {0}; i < 100; i += 2) {
+            ht.erase(i);
+        }
+        CHECK(ht.size() == 50);
+        for(int i {1}; i < 100; i += 2) {
+            CHECK(ht.exists(i));
+            CHECK(ht[i] == i);
+        }
+        CHECK(!ht.exists(0));
+
+        // Tombstones get reused by new keys
+        for(int i {0}; i < 100; i += 2) {
+            CHECK(ht.insert(i, -i));
+        }
+        CHECK(ht.size() == 100);
+        CHECK(ht[98] == -98);
+    }
+
+    SECTION("String keys get stored and compared") {
+        ds::HashTable<std::string, int> ht(64);
+        ht["one"] = 1;
+        ht["two"] = 2;
+        CHECK(!ht.insert("one", 3));
+        CHECK(ht["one"] == 1);
+        CHECK(ht["two"] == 2);
+        CHECK(ht.size() == 2);
+    }
+}
+
+TEST_CASE("Test own implemented HashTables hash policy", "[hashtable]") {
+
+    //bool insert(const key_type& key, const mapped_type& value);
+    SECTION("Default constructed HashTable grows on insert") {
+        ds::HashTable<int, int> ht;
+        REQUIRE(ht.capacity() == 0);
+        for(int i {0}; i < 10000; ++i) {
+            ht.insert(i, i);
+        }
+        CHECK(ht.size() == 10000);
+        CHECK(std::has_single_bit(ht.capacity()));
+        CHECK(ht.load_factor() <= ht.max_load_factor());
+        for(int i {0}; i < 10000; ++i) {
+            CHECK(ht[i] == i);
+        }
+    }
+
+    //T& operator[](const key_type& key);
+    SECTION("operator[] grows the table as well") {
+        ds::HashTable<int, int> ht(4);
+        for(int i {0}; i < 100; ++i) {
+            ht[i] = i * 2;
+        }
+        CHECK(ht.size() == 100);
+        CHECK(ht[99] == 198);
+    }
+
+    //void max_load_factor(float ml);
+    SECTION("Lowering the max load factor grows the table") {
+        ds::HashTable<int, int> ht;
+        for(int i {0}; i < 100; ++i) {
+            ht.insert(i, i);
+        }
+        ht.max_load_factor(0.25f);
+        CHECK(ht.max_load_factor() == 0.25f);
+        CHECK(ht.load_factor() <= 0.25f);
+        CHECK(ht.size() == 100);
+        CHECK(ht.exists(42));
+        CHECK_THROWS_AS(ht.max_load_factor(1.5f), std::invalid_argument);
+    }
+
+    //void rehash(size_type count);
+    SECTION("Rehash keeps all elements and never shrinks below size") {
+        ds::HashTable<int, int> ht;
+        for(int i {0}; i < 1000; ++i) {
+            ht.insert(i, i);
+        }
+        ht.rehash(8192);
+        CHECK(ht.capacity() == 8192);
+        ht.rehash(0);
+        CHECK(ht.capacity() < 8192);
+        CHECK(ht.load_factor() <= ht.max_load_factor());
+        CHECK(ht.size() == 1000);
+        CHECK(ht[999] == 999);
+    }
+
+    //void reserve(size_type count);
+    SECTION("Reserve makes room for 'count' elements without growing") {
+        ds::HashTable<int, int> ht;
+        ht.reserve(1000);
+        auto capacity = ht.capacity();
+        for(int i {0}; i < 1000; ++i) {
+            ht.insert(i, i);
+        }
+        CHECK(ht.capacity() == capacity);
+    }
+}
+
+// Treats keys as equal if they only differ in their sign
+struct AbsHash {
+    std::size_t operator()(int key) const { return ds::FastHash<int>{}(key < 0 ? -key : key); }
+};
+
+struct AbsEqual {
+    bool operator()(int a, int b) const { return (a < 0 ? -a : a) == (b < 0 ? -b : b); }
+};
+
+TEST_CASE("Test own implemented HashTables hash and equality policies", "[hashtable]") {
+
+    //template<class Key, class T, HashFunction<Key> Hash, class KeyEqual>
+    SECTION("Custom hash and key equal get used for every lookup") {
+        ds::HashTable<int, int, AbsHash, AbsEqual> ht;
+        CHECK(ht.insert(5, 1));
+        CHECK(!ht.insert(-5, 2));
+        CHECK(ht.exists(-5));
+        CHECK(ht[-5] == 1);
+        ht.erase(-5);
+        CHECK(ht.empty());
+    }
+
+    //HashTable(size_type size, const Hash& hash, const KeyEqual& equal);
+    SECTION("Default FastHash spreads consecutive keys over all bits") {
+        ds::FastHash<int> hash;
+        std::array<int, 64> control_bytes {};
+        for(int i {0}; i < 6400; ++i) {
+            ++control_bytes[hash(i) & 63];
+        }
+        for(int count: control_bytes) {
+            CHECK(count > 50);
+            CHECK(count < 150);
+        }
+        CHECK(ds::FastHash<std::string>{}("abc") == ds::FastHash<std::string_view>{}("abc"));
+    }
+}
+
+TEST_CASE("Test own implemented HashTables lookup and tombstones", "[hashtable]") {
+
+    //mapped_type* find(const key_type& key);
+    SECTION("Find returns a pointer to the value or nullptr") {
+        ds::HashTable<int, int> ht {{1, 2}, {3, 4}};
+        REQUIRE(ht.find(1));
+        CHECK(*ht.find(1) == 2);
+        *ht.find(3) = 5;
+        CHECK(ht[3] == 5);
+        CHECK(ht.find(2) == nullptr);
+
+        const ds::HashTable<int, int> const_ht {{1, 2}};
+        CHECK(*const_ht.find(1) == 2);
+        CHECK(const_ht.find(2) == nullptr);
+    }
+
+    //template<class... Args>
+    //std::pair<mapped_type*, bool> try_emplace(const key_type& key, Args&&... args);
+    SECTION("try_emplace only constructs the value if key is missing") {
+        ds::HashTable<int, std::string> ht;
+        auto [value, inserted] = ht.try_emplace(1, 3, 'a');
+        CHECK(inserted);
+        CHECK(*value == "aaa");
+
+        auto [same_value, inserted_again] = ht.try_emplace(1, "b");
+        CHECK(!inserted_again);
+        CHECK(same_value == value);
+        CHECK(*same_value == "aaa");
+        CHECK(ht.size() == 1);
+    }
+
+    //std::pair<mapped_type*, bool> try_emplace(const key_type& key, Args&&... args);
+    SECTION("try_emplace copies an element of the table while it grows") {
+        ds::HashTable<int, std::string> ht;
+        ht.try_emplace(0, 100, 'x');
+        for(int i {1}; i < 200; ++i) {
+            CHECK(ht.try_emplace(i, ht[0]).second);
+            ht.insert(-i, ht[i]);
+        }
+        CHECK(ht.size() == 399);
+        CHECK(ht[199] == std::string(100, 'x'));
+        CHECK(ht[-199] == ht[0]);
+    }
+
+    //std::pair<mapped_type*, bool> try_emplace(const key_type& key, Args&&... args);
+    SECTION("A throwing constructor does not use up growth") {
+        ds::HashTable<int, std::string> ht(16);
+        for(int i {0}; i < 8; ++i) {
+            ht.try_emplace(i, "v");
+        }
+        const std::size_t capacity {ht.capacity()};
+        for(int i {0}; i < 100; ++i) {
+            CHECK_THROWS_AS(ht.try_emplace(100 + i, std::string::npos, 'x'), std::length_error);
+        }
+        CHECK(ht.size() == 8);
+        CHECK(ht.capacity() == capacity);
+        while(ht.load_factor() < ht.max_load_factor() - 1.0f / static_cast<float>(capacity)) {
+            ht.try_emplace(static_cast<int>(ht.size()), "v");
+        }
+        CHECK(ht.capacity() == capacity);
+    }
+
+    //void erase(const key_type& key);
+    SECTION("Inserting and erasing keys does not grow the table forever") {
+        ds::HashTable<int, int> ht;
+        ht.reserve(100);
+        auto capacity = ht.capacity();
+        for(int round {0}; round < 100; ++round) {
+            for(int i {0}; i < 100; ++i) {
+                ht.insert(round * 100 + i, i);
+            }
+            for(int i {0}; i < 100; ++i) {
+                ht.erase(round * 100 + i);
+            }
+        }
+        CHECK(ht.empty());
+        // Tombstones get dropped instead of doubling over and over again
+        CHECK(ht.capacity() <= 2 * capacity);
+
+        ht[7] = 7;
+        CHECK(ht.size() == 1);
+        CHECK(ht[7] == 7);
+    }
+}
+
+TEST_CASE("Test own implemented HashTables batched lookup", "[hashtable]") {
+    ds::HashTable<int, int> ht;
+    for(int i {0}; i < 1000; ++i) {
+        ht[i] = i * 3;
+    }
+    std::vector<int> keys;
+    for(int i {-20}; i < 1020; i += 7) {
+        keys.push_back(i);
+    }
+
+    //void find_batch(std::span<const key_type> keys, std::span<mapped_type*> results);
+    SECTION("find_batch returns the same pointers as find") {
+        std::vector<int*> results(keys.size());
+        ht.find_batch(keys, results);
+        for(std::size_t i {0}; i < keys.size(); ++i) {
+            CHECK(results[i] == ht.find(keys[i]));
+        }
+
+        const auto& const_ht = ht;
+        std::vector<const int*> const_results(keys.size());
+        const_ht.find_batch(keys, const_results);
+        CHECK(const_results[10] == ht.find(keys[10]));
+
+        std::vector<int*> too_small(keys.size() - 1);
+        CHECK_THROWS_AS(ht.find_batch(keys, too_small), std::invalid_argument);
+    }
+
+    //size_type contains_batch(std::span<const key_type> keys, std::span<bool> results) const;
+    SECTION("contains_batch marks existing keys and counts them") {
+        auto results = std::make_unique<bool[]>(keys.size());
+        auto found = ht.contains_batch(keys, std::span<bool>(results.get(), keys.size()));
+        std::size_t expected {0};
+        for(std::size_t i {0}; i < keys.size(); ++i) {
+            CHECK(results[i] == ht.exists(keys[i]));
+            expected += ht.exists(keys[i]);
+        }
+        CHECK(found == expected);
+
+        ds::HashTable<int, int> empty_ht;
+        CHECK(empty_ht.contains_batch(keys, std::span<bool>(results.get(), keys.size())) == 0);
+    }
+}
+
+TEST_CASE("Test own implemented HashTables heterogeneous lookup", "[hashtable]") {
+    ds::HashTable<std::string, int, ds::FastHash<std::string>, std::equal_to<>> ht;
+    ht.insert("alpha", 1);
+    ht.insert("beta", 2);
+
+    //template<class K> requires TransparentLookup<Hash, KeyEqual, K>
+    //constexpr bool exists(const K& key) const;
+    SECTION("String views and character pointers find std::string keys") {
+        std::string_view buffer {"alphabeta"};
+        CHECK(ht.exists(buffer.substr(0, 5)));
+        CHECK(ht.exists(buffer.substr(5)));
+        CHECK(!ht.exists(buffer.substr(0, 4)));
+        CHECK(ht.exists("beta"));
+    }
+
+    //template<class K> requires TransparentLookup<Hash, KeyEqual, K>
+    //mapped_type* find(const K& key);
+    SECTION("Find returns the value of the matching key") {
+        std::string_view key {"beta"};
+        REQUIRE(ht.find(key) != nullptr);
+        CHECK(*ht.find(key) == 2);
+        const auto& const_ht = ht;
+        CHECK(*const_ht.find(std::string_view {"alpha"}) == 1);
+        CHECK(const_ht.find(std::string_view {"gamma"}) == nullptr);
+    }
+}
+
+TEST_CASE("Test own implemented HashTables iteration", "[hashtable]") {
+
+    //iterator begin() noexcept;
+    //iterator end() noexcept;
+    SECTION("Iterators visit every element exactly once") {
+        ds::HashTable<int, int> ht;
+        CHECK(ht.begin() == ht.end());
+        for(int i {0}; i < 1000; ++i) {
+            ht.insert(i, i);
+        }
+        ht.erase(500);
+
+        std::vector<int> seen(1000, 0);
+        for(auto& [key, value]: ht) {
+            ++seen[key];
+            value *= 2;
+        }
+        CHECK(seen[500] == 0);
+        CHECK(std::count(seen.begin(), seen.end(), 1) == 999);
+        CHECK(*ht.find(7) == 14);
+        CHECK(static_cast<std::size_t>(std::distance(ht.begin(), ht.end())) == ht.size());
+    }
+
+    //const_iterator begin() const noexcept;
+    SECTION("Tables smaller than a group do not yield mirrored control bytes") {
+        ds::HashTable<int, int> ht(4);
+        REQUIRE(ht.capacity() == 4);
+        ht.insert(1, 1);
+        ht.insert(2, 2);
+        const auto& const_ht = ht;
+        ds::HashTable<int, int>::const_iterator it {ht.begin()};
+        CHECK(it == const_ht.begin());
+        CHECK(std::distance(const_ht.begin(), const_ht.end()) == 2);
+
+        int sum {0};
+        const_ht.for_each([&sum](const auto& pair) { sum += pair.second; });
+        CHECK(sum == 3);
+    }
+
+    //template<class F>
+    //void for_each(F&& f);
+    SECTION("for_each visits the same elements as the iterators") {
+        ds::HashTable<int, int> ht;
+        for(int i {0}; i < 5000; i += 3) {
+            ht.insert(i, 1);
+        }
+        std::size_t count {0};
+        ht.for_each([&count](auto& pair) { ++count; pair.second = 5; });
+        CHECK(count == ht.size());
+        CHECK(*ht.find(3) == 5);
+    }
+
+    //size_type bucket_count() const noexcept;
+    //size_type bucket_size(size_type n) const;
+    SECTION("Every slot is a bucket with zero or one element") {
+        ds::HashTable<int, int> ht(64);
+        for(int i {0}; i < 20; ++i) {
+            ht.insert(i, i);
+        }
+        CHECK(ht.bucket_count() == ht.capacity());
+        std::size_t total {0};
+        for(std::size_t i {0}; i < ht.bucket_count(); ++i) {
+            CHECK(ht.bucket_size(i) <= 1);
+            total += ht.bucket_size(i);
+        }
+        CHECK(total == 20);
+        CHECK_THROWS_AS(ht.bucket_size(ht.bucket_count()), std::out_of_range);
+    }
+}
+
+TEST_CASE("Test own implemented HashTables bulk load", "[hashtable]") {
+    std::vector<std::pair<int, std::string>> elements;
+    for(int i {0}; i < 200000; ++i) {
+        elements.emplace_back(i * 7, std::to_string(i));
+    }
+
+    //template<std::ranges::forward_range Range>
+    //static HashTable from_range(Range&& range);
+    SECTION("Duplicate keys keep the first value") {
+        std::vector<std::pair<int, int>> pairs {{1, 1}, {2, 2}, {1, 3}, {3, 3}, {2, 5}};
+        auto ht = ds::HashTable<int, int>::from_range(pairs);
+        CHECK(ht.size() == 3);
+        CHECK(*ht.find(1) == 1);
+        CHECK(*ht.find(2) == 2);
+        CHECK(*ht.find(3) == 3);
+    }
+
+    SECTION("The table gets sized once for the whole range") {
+        auto ht = ds::HashTable<int, std::string>::from_range(elements);
+        ds::HashTable<int, std::string> reserved;
+        reserved.reserve(elements.size());
+        CHECK(ht.size() == elements.size());
+        CHECK(ht.capacity() == reserved.capacity());
+        for(const auto& [key, value]: elements) {
+            REQUIRE(ht.find(key) != nullptr);
+            CHECK(*ht.find(key) == value);
+        }
+        CHECK(ht.find(1) == nullptr);
+    }
+
+    //template<std::ranges::forward_range Range>
+    //static HashTable from_range(assume_unique_t, Range&& range, size_type threads = 1);
+    SECTION("Unique keys get placed without duplicate checks") {
+        std::list<std::pair<int, int>> pairs {{1, 1}, {2, 2}, {3, 3}};
+        auto ht = ds::HashTable<int, int>::from_range(ds::assume_unique, pairs);
+        CHECK(ht.size() == 3);
+        CHECK(*ht.find(2) == 2);
+        CHECK(ht.insert(4, 4));
+        CHECK_FALSE(ht.insert(1, 1));
+    }
+
+    SECTION("Parallel placement finds every element") {
+        for(std::size_t threads: {1, 2, 4, 16}) {
+            auto ht = ds::HashTable<int, std::string>::from_range(ds::assume_unique, elements, threads);
+            CHECK(ht.size() == elements.size());
+            bool all_found {true};
+            for(const auto& [key, value]: elements) {
+                const std::string* found {ht.find(key)};
+                all_found = all_found && found && *found == value;
+            }
+            CHECK(all_found);
+            CHECK(ht.find(1) == nullptr);
+            CHECK(std::distance(ht.begin(), ht.end()) == static_cast<std::ptrdiff_t>(elements.size()));
+
+            // The table keeps working as usual afterwards
+            CHECK(ht.insert(1, "1"));
+            ht.erase(0);
+            CHECK_FALSE(ht.exists(0));
+            CHECK(ht.size() == elements.size());
+        }
+    }
+}
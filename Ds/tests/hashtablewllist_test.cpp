@@ -9,6 +9,10 @@
 #include <initializer_list>
 #include <utility>
 #include <exception>
+#include <string>
+#include <string_view>
+#include <algorithm>
+#include <vector>
 
 using size_type = ds::HT<int, int>::size_type;
 
@@ -189,3 +193,179 @@ TEST_CASE("Test custom ht access elements", "[ht]") {
         CHECK(ht.size() == 1);
     }
 }
+
+struct LengthHash {
+    std::size_t operator()(const std::string& key) const { return key.size(); }
+};
+
+struct LengthEqual {
+    bool operator()(const std::string& a, const std::string& b) const { return a.size() == b.size(); }
+};
+
+TEST_CASE("Test custom ht hash and equality policies", "[ht]") {
+
+    //template<class Key, MappedConcept T, HashFunction<Key> Hash, class KeyEqual>
+    SECTION("Custom hash and key equal get used for every lookup") {
+        ds::HT<std::string, int, LengthHash, LengthEqual> ht(16);
+        CHECK(ht.insert("abc", 1));
+        CHECK(!ht.insert("xyz", 2));
+        CHECK(ht.at("cba") == 1);
+        CHECK(ht.size() == 1);
+    }
+}
+
+TEST_CASE("Test custom ht pooled chains", "[ht]") {
+
+    //HT(const HT& other);
+    SECTION("Chains with owning values survive copies, moves and assignment") {
+        ds::HT<std::string, std::string> ht(1024);
+        for(int i {0}; i < 1000; ++i) {
+            ht[std::to_string(i)] = std::string(32, static_cast<char>('a' + i % 26));
+        }
+
+        ds::HT<std::string, std::string> copy {ht};
+        ds::HT<std::string, std::string> moved {std::move(ht)};
+        ds::HT<std::string, std::string> assigned(1);
+        assigned = copy;
+
+        CHECK(copy.size() == 1000);
+        CHECK(moved.size() == 1000);
+        CHECK(assigned.size() == 1000);
+        for(int i {0}; i < 1000; ++i) {
+            std::string expected(32, static_cast<char>('a' + i % 26));
+            CHECK(copy.at(std::to_string(i)) == expected);
+            CHECK(moved.at(std::to_string(i)) == expected);
+            CHECK(assigned.at(std::to_string(i)) == expected);
+        }
+    }
+}
+
+TEST_CASE("Test custom ht incremental rehashing", "[ht]") {
+
+    //bool insert(const key_type& key, const mapped_type& value);
+    SECTION("Inserting into a full ht grows it instead of throwing") {
+        ds::HT<int, int> ht;
+        for(int i {0}; i < 100000; ++i) {
+            CHECK(ht.insert(i, i * 3));
+        }
+        CHECK(!ht.insert(42, 0));
+        CHECK(ht.size() == 100000);
+        CHECK(ht.capacity() >= ht.size());
+        for(int i {0}; i < 100000; ++i) {
+            CHECK(ht.at(i) == i * 3);
+        }
+    }
+
+    //bool rehashing() const noexcept;
+    SECTION("Elements stay reachable while the old buckets get migrated") {
+        ds::HT<std::string, int> ht(1024);
+        for(int i {0}; i < 1024; ++i) {
+            ht[std::to_string(i)] = i;
+        }
+        CHECK(!ht.rehashing());
+
+        ht.insert("1024", 1024);
+        CHECK(ht.rehashing());
+        CHECK(ht.capacity() == 2048);
+
+        int* first {ht.exists("0").first};
+        int inserts {0};
+        for(int i {1025}; ht.rehashing(); ++i) {
+            ht.emplace(std::to_string(i), i);
+            ++inserts;
+            if(i % 16 == 0) {
+                for(int j {0}; j <= i; ++j) {
+                    REQUIRE(ht.exists(std::to_string(j)).second);
+                }
+            }
+        }
+        // Every insert migrates a few buckets, so the rehash finishes long
+        // before the new array is full. Nodes never move in memory.
+        CHECK(inserts < 1024);
+        CHECK(ht.exists("0").first == first);
+
+        ds::HT<std::string, int> copy {ht};
+        CHECK(copy.size() == ht.size());
+        CHECK(copy.at("1024") == 1024);
+    }
+}
+
+TEST_CASE("Test custom ht heterogeneous lookup", "[ht]") {
+    ds::HT<std::string, int, ds::FastHash<std::string>, std::equal_to<>> ht;
+    ht.insert("alpha", 1);
+    ht.insert("beta", 2);
+
+    //template<class K> requires TransparentLookup<Hash, KeyEqual, K>
+    //constexpr std::pair<T*, bool> exists(const K& key) const;
+    SECTION("String views and character pointers find std::string keys") {
+        std::string_view buffer {"alphabeta"};
+        CHECK(ht.exists(buffer.substr(0, 5)).second);
+        CHECK(*ht.exists(buffer.substr(5)).first == 2);
+        CHECK(!ht.exists(buffer.substr(0, 4)).second);
+        CHECK(ht.exists("beta").second);
+    }
+
+    //template<class K> requires TransparentLookup<Hash, KeyEqual, K>
+    //mapped_type& at(const K& key);
+    SECTION("At throws std::out_of_range for missing views") {
+        CHECK(ht.at(std::string_view {"alpha"}) == 1);
+        const auto& const_ht = ht;
+        CHECK(const_ht.at(std::string_view {"beta"}) == 2);
+        CHECK_THROWS_AS(ht.at(std::string_view {"gamma"}), std::out_of_range);
+    }
+}
+
+TEST_CASE("Test custom ht iteration", "[ht]") {
+
+    //iterator begin() noexcept;
+    //iterator end() noexcept;
+    SECTION("Iterators visit every element once, also while rehashing") {
+        ds::HT<int, int> ht;
+        CHECK(ht.begin() == ht.end());
+        for(int i {0}; i < 1025; ++i) {
+            ht.insert(i, i);
+        }
+        REQUIRE(ht.rehashing());
+
+        std::vector<int> seen(1025, 0);
+        for(auto& [key, value]: ht) {
+            ++seen[key];
+            value = -1;
+        }
+        CHECK(std::count(seen.begin(), seen.end(), 1) == 1025);
+        CHECK(ht.at(1000) == -1);
+
+        const auto& const_ht = ht;
+        ds::HT<int, int>::const_iterator it {ht.begin()};
+        CHECK(it == const_ht.begin());
+        CHECK(static_cast<std::size_t>(std::distance(const_ht.begin(), const_ht.end())) == ht.size());
+    }
+
+    //template<class F>
+    //void for_each(F&& f) const;
+    SECTION("for_each visits the same elements as the iterators") {
+        ds::HT<std::string, int> ht;
+        for(int i {0}; i < 300; ++i) {
+            ht[std::to_string(i)] = i;
+        }
+        long sum {0};
+        std::as_const(ht).for_each([&sum](const auto& pair) { sum += pair.second; });
+        CHECK(sum == 299 * 300 / 2);
+    }
+
+    //size_type bucket_count() const noexcept;
+    //size_type bucket_size(size_type n) const;
+    SECTION("Bucket sizes add up to the number of elements") {
+        ds::HT<int, int> ht(128);
+        for(int i {0}; i < 100; ++i) {
+            ht.insert(i, i);
+        }
+        CHECK(ht.bucket_count() == 128);
+        std::size_t total {0};
+        for(std::size_t i {0}; i < ht.bucket_count(); ++i) {
+            total += ht.bucket_size(i);
+        }
+        CHECK(total == 100);
+        CHECK_THROWS_AS(ht.bucket_size(128), std::out_of_range);
+    }
+}
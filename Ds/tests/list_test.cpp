@@ -5,6 +5,12 @@
 #include <cstddef>
 #include <array>
 #include <functional>
+#include <algorithm>
+#include <initializer_list>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
 
 
 TEST_CASE("Test own implemented List Class constructors", "[list]") {
@@ -374,32 +380,53 @@ TEST_CASE("Test own implemented List Class operation functions", "[list]") {
 
     //template<class Compare>
     //void merge(const List& other, Compare comp);
-    SECTION("Merge lists(deep copy) and then sort them accodring to 'comp'") {
-        l.assign({ 5,9,1,3,3 });
+    SECTION("Merge sorted lists(deep copy) according to 'comp'") {
+        l.assign({ 9,5,3,3,1 });
         ds::List<int> copy_l {l}; 
-        ds::List<int> f = { 8, 7, 2, 3, 4, 4 };
+        ds::List<int> f = { 8, 7, 4, 4, 3, 2 };
         ds::List<int> copy_f {f}; 
 
-        l.merge(f, std::less<int>());
+        l.merge(f, std::greater<int>());
+        CHECK_THAT(f, EqualsContainer(copy_f));
         CHECK(l.size() == (copy_f.size() + copy_l.size()));
-        CHECK(l[0] <= l[1]);
-        CHECK(l[1] <= l[2]);
-
+        CHECK_THAT(l, EqualsContainer(std::initializer_list<int> {9, 8, 7, 5, 4, 4, 3, 3, 3, 2, 1}));
+        CHECK(l.back() == 1);
     }
 
     //template<class Compare>
     //void merge(List&& other, Compare comp);
-    SECTION("Merge lists(move) and then sort them accodring to 'comp'") {
-        l.assign({ 5,9,1,3,3 });
+    SECTION("Merge sorted lists(move) according to 'comp'") {
+        l.assign({ 1,3,3,5,9 });
         ds::List<int> copy_l {l}; 
-        ds::List<int> f = { 8, 7, 2, 3, 4, 4 };
+        ds::List<int> f = { 2, 3, 4, 4, 7, 8 };
         ds::List<int> copy_f {f}; 
 
         l.merge(std::move(f), std::less<int>());
         CHECK_THAT(f, !EqualsContainer(copy_f));
+        CHECK(f.size() == 0);
         CHECK(l.size() == (copy_f.size() + copy_l.size()));
-        CHECK(l[0] <= l[1]);
-        CHECK(l[1] <= l[2]);
+        CHECK_THAT(l, EqualsContainer(std::initializer_list<int> {1, 2, 3, 3, 3, 4, 4, 5, 7, 8, 9}));
+        CHECK(l[9] == 8);
+    }
+
+    //template<class Compare>
+    //void merge(List&& other, Compare comp);
+    SECTION("Merge keeps equal elements of '*this' in front and works on empty lists") {
+        ds::List<std::pair<int, char>> mine {{1, 'a'}, {2, 'a'}};
+        ds::List<std::pair<int, char>> theirs {{1, 'b'}, {2, 'b'}, {3, 'b'}};
+        auto by_key = [](const auto& a, const auto& b) { return a.first < b.first; };
+        mine.merge(std::move(theirs), by_key);
+        std::vector<char> order;
+        for(const auto& value: mine) {
+            order.push_back(value.second);
+        }
+        CHECK(order == std::vector<char> {'a', 'b', 'a', 'b', 'b'});
+
+        ds::List<int> empty;
+        empty.merge(ds::List<int> {1, 2});
+        CHECK_THAT(empty, EqualsContainer(std::initializer_list<int> {1, 2}));
+        empty.merge(ds::List<int> {});
+        CHECK(empty.size() == 2);
     }
 
     //template<class Compare=std::less<T>>
@@ -409,6 +436,52 @@ TEST_CASE("Test own implemented List Class operation functions", "[list]") {
         l.sort();
         CHECK(l[0] <= l[1]);
         CHECK(l[1] <= l[2]);
+        CHECK_THAT(l, EqualsContainer(std::initializer_list<int> {1, 3, 3, 5, 9}));
+        CHECK(l.back() == 9);
+    }
+
+    //template<class Compare=std::less<T>>
+    //void sort(Compare comp=Compare{});
+    SECTION("Sorting relinks the nodes and is stable") {
+        ds::List<std::pair<int, int>> pairs;
+        for(int i {0}; i < 1000; ++i) {
+            pairs.push_back({(i * 7919) % 13, i});
+        }
+        const int* first_node {&pairs.front().second};
+        pairs.sort([](const auto& a, const auto& b) { return a.first < b.first; });
+        CHECK(pairs.size() == 1000);
+        bool stable {true};
+        bool found_first {false};
+        auto prev = pairs.begin();
+        for(auto it = pairs.begin(); it != pairs.end(); prev = it, ++it) {
+            found_first = found_first || &(*it).second == first_node;
+            if(it != pairs.begin() && ((*prev).first > (*it).first || ((*prev).first == (*it).first && (*prev).second > (*it).second))) {
+                stable = false;
+            }
+        }
+        CHECK(stable);
+        CHECK(found_first);
+        CHECK(pairs.back().first == 12);
+        CHECK(pairs[998].first == 12);
+    }
+
+    //template<class Compare=std::less<T>>
+    //void sort(Compare comp=Compare{});
+    SECTION("A throwing comparison keeps every element") {
+        l.assign({ 9,8,7,6,5,4,3,2,1 });
+        int comparisons {0};
+        CHECK_THROWS_AS(l.sort([&comparisons](int a, int b) {
+            if(++comparisons == 10) {
+                throw std::runtime_error("comparison failed");
+            }
+            return a < b;
+        }), std::runtime_error);
+        CHECK(l.size() == 9);
+        std::vector<int> values(l.begin(), l.end());
+        std::sort(values.begin(), values.end());
+        CHECK(values == std::vector<int> {1, 2, 3, 4, 5, 6, 7, 8, 9});
+        l.sort();
+        CHECK_THAT(l, EqualsContainer(std::initializer_list<int> {1, 2, 3, 4, 5, 6, 7, 8, 9}));
     }
 
     //void reverse() noexcept;
@@ -470,3 +543,194 @@ TEST_CASE("Test own implemented List Class assignment operator", "[list]") {
 }
 
 
+
+TEST_CASE("Test own implemented List Class with pooled nodes", "[list]") {
+    ds::PooledList<std::string> l {"a", "b", "c"};
+
+    //void push_back(const T& value);
+    SECTION("Nodes added one after another sit next to each other") {
+        ds::PooledList<long> numbers;
+        for(long i {0}; i < 8; ++i) {
+            numbers.push_back(i);
+        }
+        auto it = numbers.begin();
+        const char* first {reinterpret_cast<const char*>(&*it)};
+        const char* second {reinterpret_cast<const char*>(&*(++it))};
+        const char* third {reinterpret_cast<const char*>(&*(++it))};
+        CHECK(second - first == third - second);
+        CHECK(second - first > 0);
+    }
+
+    //iterator erase(iterator pos);
+    SECTION("Erased nodes get reused") {
+        const std::string* second {&l[1]};
+        l.erase(++l.begin());
+        l.push_back(std::string(40, 'x'));
+        CHECK(&l.back() == second);
+        CHECK_THAT(l, EqualsContainer(std::initializer_list<std::string> {"a", "c", std::string(40, 'x')}));
+    }
+
+    //void merge(List&& other, Compare comp);
+    SECTION("Merging takes over the nodes of 'other'") {
+        {
+            ds::PooledList<std::string> other {"aa", "bb", std::string(40, 'z')};
+            l.merge(std::move(other));
+        }
+        CHECK_THAT(l, EqualsContainer(std::initializer_list<std::string> {"a", "aa", "b", "bb", "c", std::string(40, 'z')}));
+        ds::PooledList<std::string> copy {"d"};
+        l.merge(copy);
+        CHECK(l.size() == 7);
+        CHECK(l.back() == std::string(40, 'z'));
+        CHECK(copy.size() == 1);
+    }
+
+    //void swap(List& other);
+    //List(List&& other);
+    SECTION("Swapping and moving keep the nodes valid") {
+        ds::PooledList<std::string> other {"x"};
+        l.swap(other);
+        CHECK(other.size() == 3);
+        CHECK(l.front() == "x");
+        ds::PooledList<std::string> moved {std::move(other)};
+        CHECK(moved.back() == "c");
+        l = std::move(moved);
+        CHECK_THAT(l, EqualsContainer(std::initializer_list<std::string> {"a", "b", "c"}));
+    }
+
+    //void clear() noexcept;
+    SECTION("Clear frees all nodes and the list stays usable") {
+        l.clear();
+        CHECK(l.empty());
+        l.push_back("again");
+        l.sort();
+        CHECK(l.front() == "again");
+    }
+}
+
+TEST_CASE("Test own implemented List Class with a positional index", "[list]") {
+    ds::IndexedList<int> l;
+    std::vector<int> expected;
+    for(int i {0}; i < 1000; ++i) {
+        l.push_back(i);
+        expected.push_back(i);
+    }
+    auto matches = [&l, &expected]() {
+        if(l.size() != expected.size()) {
+            return false;
+        }
+        for(std::size_t i {0}; i < expected.size(); ++i) {
+            if(l[i] != expected[i] || l.index_of(l.nth(i)) != i) {
+                return false;
+            }
+        }
+        return std::equal(expected.begin(), expected.end(), l.begin());
+    };
+
+    //reference operator[](const size_type index);
+    //iterator nth(const size_type index) const noexcept;
+    //size_type index_of(iterator pos) const noexcept;
+    SECTION("Positions map to nodes both ways") {
+        CHECK(l[0] == 0);
+        CHECK(l[999] == 999);
+        CHECK(*l.nth(500) == 500);
+        CHECK(l.nth(1000) == l.end());
+        CHECK(l.index_of(l.end()) == 1000);
+        CHECK(l.index_of(l.begin()) == 0);
+        CHECK(matches());
+    }
+
+    //iterator insert(iterator pos, const T& value);
+    //iterator erase(iterator pos);
+    SECTION("Inserts and erases anywhere keep the index") {
+        std::size_t state {3};
+        for(int i {0}; i < 2000; ++i) {
+            state = state * 6364136223846793005u + 1442695040888963407u;
+            std::size_t index {(state >> 33) % (expected.size() + 1)};
+            switch(i % 5) {
+            case 0:
+                l.push_front(-i);
+                expected.insert(expected.begin(), -i);
+                break;
+            case 1:
+                l.erase(l.nth(index % expected.size()));
+                expected.erase(expected.begin() + index % expected.size());
+                break;
+            case 2:
+                l.pop_back();
+                expected.pop_back();
+                break;
+            default:
+                l.insert(l.nth(index), -i);
+                expected.insert(expected.begin() + index, -i);
+            }
+        }
+        CHECK(matches());
+        l.erase(l.nth(10), l.nth(500));
+        expected.erase(expected.begin() + 10, expected.begin() + 500);
+        l.pop_front();
+        expected.erase(expected.begin());
+        l.resize(300);
+        expected.resize(300);
+        CHECK(l.remove_if([](int value) { return value < 0; }) ==
+            static_cast<std::size_t>(std::count_if(expected.begin(), expected.end(), [](int value) { return value < 0; })));
+        expected.erase(std::remove_if(expected.begin(), expected.end(), [](int value) { return value < 0; }), expected.end());
+        CHECK(matches());
+    }
+
+    //void sort(Compare comp=Compare{});
+    //void merge(List&& other);
+    //void reverse() noexcept;
+    SECTION("Relinking every node rebuilds the index") {
+        l.reverse();
+        std::reverse(expected.begin(), expected.end());
+        CHECK(matches());
+        l.sort();
+        std::sort(expected.begin(), expected.end());
+        CHECK(matches());
+        ds::IndexedList<int> odd;
+        for(int i {1}; i < 2000; i += 2) {
+            odd.push_back(i);
+            expected.push_back(i);
+        }
+        l.merge(std::move(odd));
+        std::sort(expected.begin(), expected.end());
+        CHECK(odd.empty());
+        CHECK(matches());
+        odd.push_back(7);
+        CHECK(odd[0] == 7);
+    }
+
+    //void swap(List& other);
+    //List& operator=(List&& other) noexcept;
+    SECTION("Swapping, moving and clearing take the index along") {
+        ds::IndexedList<int> other {5, 6, 7};
+        l.swap(other);
+        CHECK(l[2] == 7);
+        CHECK(other[999] == 999);
+        l = std::move(other);
+        CHECK(matches());
+        ds::IndexedList<int> moved {std::move(l)};
+        CHECK(moved[123] == 123);
+        CHECK(moved.index_of(moved.nth(321)) == 321);
+        moved.clear();
+        moved.push_back(1);
+        CHECK(moved[0] == 1);
+    }
+
+    //List& operator=(const List& other);
+    SECTION("Copy assigning rebuilds the index") {
+        ds::IndexedList<int> empty;
+        empty = l;
+        CHECK(empty.size() == 1000);
+        CHECK(empty[999] == 999);
+        CHECK(empty.index_of(empty.nth(500)) == 500);
+        ds::IndexedList<int> small {1, 2, 3};
+        small = l;
+        CHECK(small.size() == 1000);
+        CHECK(small[0] == 0);
+        const ds::IndexedList<int>& same {small};
+        small = same;
+        CHECK(small.size() == 1000);
+        CHECK(small[999] == 999);
+    }
+}
@@ -0,0 +1,192 @@
+#include "Ds/mappedhashtable.hpp"
+#include "Ds/hashtable.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <exception>
+
+namespace {
+
+std::string snapshotPath(const std::string& name) {
+    return (std::filesystem::temp_directory_path() / ("ds_" + name + ".snap")).string();
+}
+
+struct Point {
+    std::int32_t x;
+    std::int32_t y;
+    double weight;
+};
+
+// Places keys differently than FastHash
+struct ShiftedHash {
+    std::size_t operator()(int key) const { return static_cast<std::size_t>(key) * 0x9E3779B97F4A7C15ull + 1; }
+};
+
+}
+
+TEST_CASE("Test own implemented hashtable snapshots", "[mappedhashtable]") {
+    ds::HashTable<int, Point> ht;
+    for(int i {0}; i < 10000; ++i) {
+        ht.insert(i, Point {i, -i, i * 0.5});
+    }
+    for(int i {0}; i < 10000; i += 3) {
+        ht.erase(i);
+    }
+    std::string path {snapshotPath("points")};
+    ht.save(path);
+
+    //explicit MappedHashTable(const std::string& path);
+    SECTION("The mapped table answers the same lookups as the saved one") {
+        ds::MappedHashTable<int, Point> mapped(path);
+        CHECK(mapped.size() == ht.size());
+        CHECK(mapped.capacity() == ht.capacity());
+        CHECK_FALSE(mapped.empty());
+        for(int i {0}; i < 10000; ++i) {
+            CHECK(mapped.exists(i) == ht.exists(i));
+            if(i % 3 != 0) {
+                const Point* point {mapped.find(i)};
+                REQUIRE(point != nullptr);
+                CHECK(point->x == i);
+                CHECK(point->y == -i);
+                CHECK(point->weight == i * 0.5);
+            }
+        }
+        CHECK(mapped.find(10000) == nullptr);
+        CHECK_THROWS_AS(mapped.at(3), std::out_of_range);
+        CHECK(mapped.at(4).x == 4);
+    }
+
+    //void for_each(F&& f) const;
+    SECTION("for_each visits every stored element once") {
+        ds::MappedHashTable<int, Point> mapped(path);
+        std::size_t count {0};
+        long long sum {0};
+        mapped.for_each([&](const auto& element) {
+            ++count;
+            sum += element.second.x;
+            CHECK(element.first == element.second.x);
+        });
+        long long expected {0};
+        ht.for_each([&](const auto& element) { expected += element.second.x; });
+        CHECK(count == ht.size());
+        CHECK(sum == expected);
+    }
+
+    //MappedHashTable(MappedHashTable&& other) noexcept;
+    SECTION("A moved view keeps the mapping") {
+        ds::MappedHashTable<int, Point> mapped(path);
+        ds::MappedHashTable<int, Point> moved(std::move(mapped));
+        CHECK(moved.size() == ht.size());
+        CHECK(moved.exists(1));
+        CHECK(mapped.size() == 0);
+        CHECK_FALSE(mapped.exists(1));
+    }
+
+    //void save(const std::string& path) const;
+    SECTION("Empty tables round trip") {
+        std::string empty_path {snapshotPath("empty")};
+        ds::HashTable<int, int>().save(empty_path);
+        ds::MappedHashTable<int, int> mapped(empty_path);
+        CHECK(mapped.empty());
+        CHECK_FALSE(mapped.exists(0));
+        std::remove(empty_path.c_str());
+    }
+
+    //void save(const std::string& path) const;
+    SECTION("Equal tables give equal files with zeroed padding") {
+        using Slot = ds::detail::SnapshotSlot<int, Point>;
+        static_assert(offsetof(Slot, second) > sizeof(int));
+
+        std::string other_path {snapshotPath("points_other")};
+        ht.save(other_path);
+
+        auto read = [](const std::string& file) {
+            std::ifstream in(file, std::ios::binary);
+            return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        };
+        const std::string bytes {read(path)};
+        CHECK(bytes == read(other_path));
+        ds::detail::SnapshotHeader header;
+        std::memcpy(&header, bytes.data(), sizeof(header));
+        for(std::size_t i {0}; i < header.capacity; ++i) {
+            std::size_t slot {header.slots_offset + i * sizeof(Slot)};
+            for(std::size_t byte {sizeof(int)}; byte < offsetof(Slot, second); ++byte) {
+                REQUIRE(bytes[slot + byte] == 0);
+            }
+        }
+        std::remove(other_path.c_str());
+    }
+
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Test own implemented hashtable snapshot validation", "[mappedhashtable]") {
+    ds::HashTable<int, int> ht;
+    for(int i {0}; i < 1000; ++i) {
+        ht.insert(i, i);
+    }
+    std::string path {snapshotPath("ints")};
+    ht.save(path);
+
+    SECTION("Missing files and foreign files get rejected") {
+        CHECK_THROWS_AS((ds::MappedHashTable<int, int>(snapshotPath("does_not_exist"))), std::runtime_error);
+        std::string foreign {snapshotPath("foreign")};
+        std::ofstream(foreign) << "no snapshot, but long enough to hold a whole header of one";
+        CHECK_THROWS_AS((ds::MappedHashTable<int, int>(foreign)), std::runtime_error);
+        std::remove(foreign.c_str());
+    }
+
+    SECTION("Other versions, types and hash functions get rejected") {
+        CHECK_THROWS_AS((ds::MappedHashTable<int, long long>(path)), std::runtime_error);
+        CHECK_THROWS_AS((ds::MappedHashTable<int, int, ShiftedHash>(path)), std::runtime_error);
+
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        std::uint32_t version {ds::detail::kSnapshotVersion + 1};
+        file.seekp(offsetof(ds::detail::SnapshotHeader, version));
+        file.write(reinterpret_cast<const char*>(&version), sizeof(version));
+        file.close();
+        CHECK_THROWS_AS((ds::MappedHashTable<int, int>(path)), std::runtime_error);
+    }
+
+    SECTION("Truncated snapshots get rejected") {
+        std::filesystem::resize_file(path, std::filesystem::file_size(path) - 8);
+        CHECK_THROWS_AS((ds::MappedHashTable<int, int>(path)), std::runtime_error);
+    }
+
+    SECTION("Corrupt control bytes get rejected") {
+        const std::size_t capacity {ht.capacity()};
+        auto writeCtrl = [&path](std::size_t index, ds::detail::ctrl_t ctrl) {
+            std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+            file.seekp(static_cast<std::streamoff>(sizeof(ds::detail::SnapshotHeader) + index));
+            file.write(reinterpret_cast<const char*>(&ctrl), 1);
+        };
+
+        // Neither empty, deleted nor a hash
+        writeCtrl(20, static_cast<ds::detail::ctrl_t>(0x81));
+        CHECK_THROWS_AS((ds::MappedHashTable<int, int>(path)), std::runtime_error);
+        ht.save(path);
+
+        // A mirror byte that differs from the start of the table
+        writeCtrl(capacity + 1, ds::detail::kDeleted);
+        CHECK_THROWS_AS((ds::MappedHashTable<int, int>(path)), std::runtime_error);
+        ht.save(path);
+
+        // No empty slot, a probe for a missing key would never stop
+        for(std::size_t i {0}; i < capacity + ds::detail::Group::width; ++i) {
+            writeCtrl(i, ds::detail::kDeleted);
+        }
+        CHECK_THROWS_AS((ds::MappedHashTable<int, int>(path)), std::runtime_error);
+        ht.save(path);
+        CHECK_NOTHROW(ds::MappedHashTable<int, int>(path));
+    }
+
+    std::remove(path.c_str());
+}
@@ -0,0 +1,97 @@
+#include "Ds/nodepool.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+TEST_CASE("Test own implemented NodePool", "[nodepool]") {
+
+    //T* allocate();
+    SECTION("Allocate hands out distinct nodes from a few slabs") {
+        ds::NodePool<std::string> pool;
+        std::set<std::string*> nodes;
+        for(int i {0}; i < 1000; ++i) {
+            std::string* node {pool.allocate()};
+            std::construct_at(node, std::to_string(i));
+            nodes.insert(node);
+        }
+        CHECK(nodes.size() == 1000);
+        CHECK(pool.capacity() >= 1000);
+        CHECK(pool.slab_count() < 10);
+        for(std::string* node: nodes) {
+            std::destroy_at(node);
+        }
+    }
+
+    //void deallocate(T* node) noexcept;
+    SECTION("Deallocated nodes get reused before a new slab is added") {
+        ds::NodePool<long> pool;
+        long* first {pool.allocate()};
+        pool.allocate();
+        pool.deallocate(first);
+        std::size_t capacity {pool.capacity()};
+        CHECK(pool.allocate() == first);
+        CHECK(pool.capacity() == capacity);
+    }
+
+    //void reserve(size_type count);
+    SECTION("Reserve makes room for 'count' nodes with a single slab") {
+        ds::NodePool<long> pool;
+        pool.reserve(5000);
+        CHECK(pool.slab_count() == 1);
+        for(int i {0}; i < 5000; ++i) {
+            pool.allocate();
+        }
+        CHECK(pool.slab_count() == 1);
+    }
+
+    //void release() noexcept;
+    SECTION("Release frees every slab at once") {
+        ds::NodePool<long> pool;
+        for(int i {0}; i < 100; ++i) {
+            pool.allocate();
+        }
+        pool.release();
+        CHECK(pool.slab_count() == 0);
+        CHECK(pool.capacity() == 0);
+        CHECK(pool.allocate() != nullptr);
+    }
+
+    //NodePool(NodePool&& other) noexcept;
+    SECTION("Moving a pool keeps its nodes valid") {
+        ds::NodePool<long> pool;
+        long* node {pool.allocate()};
+        *node = 42;
+        ds::NodePool<long> moved {std::move(pool)};
+        CHECK(*node == 42);
+        CHECK(pool.slab_count() == 0);
+        CHECK(moved.slab_count() == 1);
+    }
+
+    //void adopt(NodePool& other);
+    SECTION("Adopting takes over the slabs and nodes of another pool") {
+        ds::NodePool<long> pool;
+        ds::NodePool<long> other;
+        long* node {other.allocate()};
+        *node = 7;
+        std::size_t capacity {pool.capacity() + other.capacity()};
+        pool.adopt(other);
+        CHECK(*node == 7);
+        CHECK(other.slab_count() == 0);
+        CHECK(pool.slab_count() == 1);
+        CHECK(pool.capacity() == capacity);
+        pool.deallocate(node);
+        CHECK(pool.allocate() == node);
+    }
+
+    //T* allocate();
+    SECTION("Slabs start on a cache line") {
+        ds::NodePool<char> pool;
+        CHECK(reinterpret_cast<std::uintptr_t>(pool.allocate()) % 64 == 0);
+    }
+}
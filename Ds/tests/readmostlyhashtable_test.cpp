@@ -0,0 +1,137 @@
+#include "Ds/readmostlyhashtable.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <exception>
+
+TEST_CASE("Test read mostly ht constructors and size functions", "[readmostlyht]") {
+
+    //explicit ReadMostlyHT(size_type capacity);
+    SECTION("Construct an empty table with 'capacity' buckets") {
+        ds::ReadMostlyHT<int, int> ht(100);
+        CHECK(ht.size() == 0);
+        CHECK(ht.empty());
+        CHECK(ht.capacity() == 100);
+    }
+
+    //bool insert(const key_type& key, const mapped_type& value);
+    SECTION("The bucket array doubles once it is full") {
+        ds::ReadMostlyHT<int, int> ht(4);
+        for(int i {0}; i < 1000; ++i) {
+            CHECK(ht.insert(i, i));
+        }
+        CHECK(ht.size() == 1000);
+        CHECK(ht.capacity() >= 1000);
+        for(int i {0}; i < 1000; ++i) {
+            CHECK(ht.at(i) == i);
+        }
+    }
+}
+
+TEST_CASE("Test read mostly ht modifiers and lookups", "[readmostlyht]") {
+    ds::ReadMostlyHT<int, std::string> ht;
+
+    //bool insert(const key_type& key, const mapped_type& value);
+    SECTION("Insert does not overwrite existing keys") {
+        CHECK(ht.insert(1, "a"));
+        CHECK(!ht.insert(1, "b"));
+        CHECK(ht.at(1) == "a");
+        CHECK(ht.size() == 1);
+    }
+
+    //template<class Type>
+    //bool insert_or_assign(const key_type& key, Type&& obj);
+    SECTION("insert_or_assign replaces the node of an existing key") {
+        CHECK(ht.insert_or_assign(2, "a"));
+        CHECK(!ht.insert_or_assign(2, "b"));
+        CHECK(ht.at(2) == "b");
+        CHECK(ht.size() == 1);
+    }
+
+    //bool erase(const key_type& key);
+    SECTION("Erase unlinks the key") {
+        for(int i {0}; i < 10; ++i) {
+            ht.insert(i, std::to_string(i));
+        }
+        CHECK(ht.erase(5));
+        CHECK(!ht.erase(5));
+        CHECK(!ht.exists(5));
+        CHECK(ht.exists(6));
+        CHECK(ht.size() == 9);
+    }
+
+    //std::optional<mapped_type> find(const key_type& key) const;
+    //mapped_type at(const key_type& key) const;
+    SECTION("Find returns a copy or nothing, at throws std::out_of_range") {
+        ht.insert(3, "c");
+        CHECK(ht.find(3) == std::optional<std::string>("c"));
+        CHECK(!ht.find(4));
+        CHECK_THROWS_AS(ht.at(4), std::out_of_range);
+    }
+
+    //template<class F>
+    //bool visit(const key_type& key, F&& f) const;
+    SECTION("Visit calls 'f' with the value of 'key'") {
+        ht.insert(7, "seven");
+        std::size_t length {0};
+        CHECK(ht.visit(7, [&length](const std::string& value) { length = value.size(); }));
+        CHECK(!ht.visit(8, [](const std::string&) {}));
+        CHECK(length == 5);
+    }
+}
+
+TEST_CASE("Test read mostly ht with concurrent readers", "[readmostlyht]") {
+
+    //bool visit(const key_type& key, F&& f) const;
+    SECTION("Readers always see a complete value while a writer churns") {
+        constexpr int keys {512};
+        ds::ReadMostlyHT<int, std::pair<int, std::string>> ht(8);
+        for(int i {0}; i < keys; i += 2) {
+            ht.insert(i, {i, std::to_string(i)});
+        }
+
+        std::atomic<bool> done {false};
+        std::atomic<int> torn {0};
+        std::vector<std::jthread> readers;
+        for(int t {0}; t < 4; ++t) {
+            readers.emplace_back([&]() {
+                while(!done) {
+                    for(int i {0}; i < keys; ++i) {
+                        ht.visit(i, [&](const std::pair<int, std::string>& value) {
+                            // Every value written for key i is {i * n, to_string(i * n)}
+                            if(std::to_string(value.first) != value.second || (i != 0 && value.first % i != 0)) {
+                                ++torn;
+                            }
+                        });
+                    }
+                }
+            });
+        }
+
+        // Even keys get reassigned, odd keys inserted and erased again,
+        // which also grows the table under the readers
+        for(int round {1}; round <= 20; ++round) {
+            for(int i {0}; i < keys; ++i) {
+                if(i % 2 == 0) {
+                    ht.insert_or_assign(i, std::make_pair(i * round, std::to_string(i * round)));
+                } else if(round % 2 == 1) {
+                    ht.insert(i, {i, std::to_string(i)});
+                } else {
+                    ht.erase(i);
+                }
+            }
+        }
+        done = true;
+        readers.clear();
+
+        CHECK(torn == 0);
+        CHECK(ht.size() == keys / 2);
+        CHECK(ht.at(4).first == 80);
+    }
+}
@@ -0,0 +1,191 @@
+#include "Ds/robinhoodhashtable.hpp"
+#include "Ds/hashtable.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <exception>
+
+// Puts every key into the same home slot
+struct ConstantHash {
+    std::size_t operator()(int) const { return 0; }
+};
+
+// Key 'k' has its home in slot 'k % capacity'
+struct IdentityHash {
+    std::size_t operator()(int key) const { return static_cast<std::size_t>(key); }
+};
+
+// Counts its live objects, the n-th move construction throws
+struct Counted {
+    static inline int live {0};
+    static inline int moves_until_throw {0};
+    int value;
+
+    Counted(int v): value {v} { ++live; }
+    Counted(const Counted& other): value {other.value} { ++live; }
+    Counted(Counted&& other): value {other.value} {
+        if(moves_until_throw > 0 && --moves_until_throw == 0) {
+            throw std::runtime_error("move");
+        }
+        ++live;
+    }
+    Counted& operator=(const Counted& other) = default;
+    Counted& operator=(Counted&& other) = default;
+    ~Counted() { --live; }
+};
+
+TEST_CASE("Test own implemented RobinHoodHashTable constructors", "[robinhoodhashtable]") {
+
+    //RobinHoodHashTable(size_type size);
+    SECTION("Construct RobinHoodHashTable with size rounded up to the next power of two") {
+        ds::RobinHoodHashTable<int, int> ht(100);
+        REQUIRE(ht.size() == 0);
+        REQUIRE(ht.capacity() == 128);
+    }
+
+    //RobinHoodHashTable(std::initializer_list<value_type> iList);
+    SECTION("Insert values from 'iList' to RobinHoodHashTable") {
+        ds::RobinHoodHashTable<int, int> ht {{1, 2}, {2, 3}, {3, 4}, {3, 5}};
+        REQUIRE(ht.size() == 3);
+        REQUIRE(ht[3] == 4);
+    }
+
+    //RobinHoodHashTable(const RobinHoodHashTable& other);
+    SECTION("Copy and move construct RobinHoodHashTable") {
+        ds::RobinHoodHashTable<int, int> ht {{1, 2}, {2, 3}, {3, 4}};
+        ds::RobinHoodHashTable<int, int> copy {ht};
+        REQUIRE(copy.size() == 3);
+        REQUIRE(copy[2] == 3);
+
+        ds::RobinHoodHashTable<int, int> moved {std::move(ht)};
+        REQUIRE(moved.size() == 3);
+        REQUIRE(ht.size() == 0);
+    }
+}
+
+TEST_CASE("Test own implemented RobinHoodHashTable modifier functions", "[robinhoodhashtable]") {
+
+    //bool insert(const key_type& key, const mapped_type& value);
+    SECTION("Insert grows the table and keeps every element reachable") {
+        ds::RobinHoodHashTable<int, int> ht;
+        for(int i {0}; i < 10000; ++i) {
+            CHECK(ht.insert(i, i * 2));
+        }
+        CHECK(!ht.insert(5, 0));
+        CHECK(ht.size() == 10000);
+        CHECK(ht.load_factor() <= ht.max_load_factor());
+        for(int i {0}; i < 10000; ++i) {
+            CHECK(*ht.find(i) == i * 2);
+        }
+        CHECK(ht.find(10000) == nullptr);
+    }
+
+    //void erase(const key_type& key);
+    SECTION("Erase shifts the following elements back") {
+        ds::RobinHoodHashTable<int, int, ConstantHash> ht(64);
+        for(int i {0}; i < 20; ++i) {
+            ht[i] = i;
+        }
+        CHECK(ht.max_probe_length() == 19);
+        ht.erase(0);
+        ht.erase(10);
+        CHECK(ht.size() == 18);
+        CHECK(ht.max_probe_length() == 17);
+        CHECK(!ht.exists(10));
+        for(int i {1}; i < 20; ++i) {
+            if(i != 10) {
+                CHECK(ht[i] == i);
+            }
+        }
+    }
+
+    //template<class... Args>
+    //std::pair<mapped_type*, bool> try_emplace(const key_type& key, Args&&... args);
+    SECTION("try_emplace only constructs the value if key is missing") {
+        ds::RobinHoodHashTable<std::string, std::string> ht;
+        CHECK(ht.try_emplace("a", 2, 'x').second);
+        CHECK(!ht.try_emplace("a", "y").second);
+        CHECK(ht["a"] == "xx");
+
+        const auto& const_ht = ht;
+        CHECK(const_ht["a"] == "xx");
+        CHECK_THROWS_AS(const_ht["b"], std::invalid_argument);
+    }
+
+    //std::pair<mapped_type*, bool> try_emplace(const key_type& key, Args&&... args);
+    SECTION("try_emplace copies an element of the table while it grows") {
+        ds::RobinHoodHashTable<int, std::string> ht;
+        ht.try_emplace(0, 100, 'x');
+        for(int i {1}; i < 200; ++i) {
+            CHECK(ht.try_emplace(i, ht[0]).second);
+        }
+        CHECK(ht.size() == 200);
+        CHECK(ht[199] == std::string(100, 'x'));
+        CHECK(ht[0] == ht[199]);
+    }
+
+    //std::pair<mapped_type*, bool> try_emplace(const key_type& key, Args&&... args);
+    SECTION("A throwing construction while displacing an element leaves the table intact") {
+        {
+            ds::RobinHoodHashTable<int, Counted, IdentityHash> ht(16);
+            ht.try_emplace(0, 0);
+            ht.try_emplace(1, 1);
+            // 16 belongs into slot 0 as well and takes slot 1, the first move
+            // shifts key 1 up, the second one would move 16 into slot 1
+            Counted::moves_until_throw = 2;
+            CHECK_THROWS_AS(ht.try_emplace(16, 16), std::runtime_error);
+            Counted::moves_until_throw = 0;
+            CHECK(ht.size() == 2);
+            CHECK(ht.exists(0));
+            CHECK(ht.exists(1));
+            CHECK_FALSE(ht.exists(16));
+            CHECK(ht.find(1)->value == 1);
+            CHECK(ht.try_emplace(16, 16).second);
+            CHECK(ht.find(16)->value == 16);
+        }
+        CHECK(Counted::live == 0);
+    }
+}
+
+TEST_CASE("Test own implemented hashtable probe length introspection", "[robinhoodhashtable]") {
+
+    //std::vector<size_type> probe_length_histogram() const;
+    SECTION("Histogram of RobinHoodHashTable counts every element once") {
+        ds::RobinHoodHashTable<int, int> ht;
+        for(int i {0}; i < 5000; ++i) {
+            ht[i] = i;
+        }
+        auto histogram = ht.probe_length_histogram();
+        CHECK(std::accumulate(histogram.begin(), histogram.end(), std::size_t {0}) == ht.size());
+        CHECK(histogram.size() == ht.max_probe_length() + 1);
+    }
+
+    //std::vector<size_type> probe_length_histogram() const;
+    SECTION("Histogram of HashTable counts every element once") {
+        ds::HashTable<int, int> ht;
+        for(int i {0}; i < 5000; ++i) {
+            ht[i] = i;
+        }
+        auto histogram = ht.probe_length_histogram();
+        CHECK(std::accumulate(histogram.begin(), histogram.end(), std::size_t {0}) == ht.size());
+        CHECK(histogram.size() == ht.max_probe_length() + 1);
+        // Most elements are found in their first group
+        CHECK(histogram[0] > ht.size() / 2);
+    }
+
+    //size_type max_probe_length() const;
+    SECTION("Colliding keys in HashTable need more groups") {
+        ds::HashTable<int, int, ConstantHash> ht(64);
+        for(int i {0}; i < 40; ++i) {
+            ht[i] = i;
+        }
+        CHECK(ht.max_probe_length() == 2);
+        CHECK(ds::HashTable<int, int>().max_probe_length() == 0);
+    }
+}
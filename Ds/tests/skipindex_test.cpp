@@ -0,0 +1,124 @@
+#include "Ds/skipindex.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <deque>
+#include <iterator>
+
+namespace {
+
+struct Node {
+    Node* next_ {nullptr};
+    ds::SkipIndex<Node>::Entry* entry_ {nullptr};
+    int value_ {0};
+};
+
+// Singly linked list over nodes in a deque, enough to drive the index
+struct Chain {
+    std::deque<Node> storage;
+    Node* first {nullptr};
+    std::size_t size {0};
+    ds::SkipIndex<Node> index;
+
+    Node* insert(std::size_t position, int value) {
+        Node* node {&storage.emplace_back()};
+        node->value_ = value;
+        Node** link {&first};
+        for(std::size_t i {0}; i < position; ++i) {
+            link = &(*link)->next_;
+        }
+        node->next_ = *link;
+        *link = node;
+        index.insert(node, position, ++size);
+        return node;
+    }
+
+    void erase(std::size_t position) {
+        Node** link {&first};
+        for(std::size_t i {0}; i < position; ++i) {
+            link = &(*link)->next_;
+        }
+        index.erase(*link, position);
+        *link = (*link)->next_;
+        --size;
+    }
+
+    bool consistent() const {
+        std::size_t position {0};
+        for(Node* node {first}; node; node = node->next_, ++position) {
+            if(index.nodeAt(position, first) != node || index.indexOf(node, size) != position) {
+                return false;
+            }
+        }
+        return position == size;
+    }
+};
+
+}
+
+TEST_CASE("Test own implemented SkipIndex", "[skipindex]") {
+    Chain chain;
+    for(int i {0}; i < 2000; ++i) {
+        chain.insert(chain.size, i);
+    }
+
+    //Node* nodeAt(size_type index, Node* first) const noexcept;
+    //size_type indexOf(const Node* node, size_type size) const noexcept;
+    SECTION("Appending builds levels and positions map to nodes both ways") {
+        CHECK(chain.index.levels() >= 3);
+        CHECK(chain.index.nodeAt(0, chain.first) == chain.first);
+        CHECK(chain.index.nodeAt(1999, chain.first)->value_ == 1999);
+        CHECK(chain.consistent());
+    }
+
+    //void insert(Node* node, size_type index, size_type size) noexcept;
+    //void erase(Node* node, size_type index) noexcept;
+    SECTION("Inserting and erasing anywhere keeps the widths right") {
+        std::size_t state {7};
+        for(int i {0}; i < 3000; ++i) {
+            state = state * 6364136223846793005u + 1442695040888963407u;
+            std::size_t position {(state >> 33) % (chain.size + 1)};
+            if(i % 3 == 2) {
+                chain.erase(position % chain.size);
+            } else {
+                chain.insert(position, -i);
+            }
+        }
+        CHECK(chain.consistent());
+        while(chain.size > 0) {
+            chain.erase(chain.size / 2);
+        }
+        CHECK(chain.index.levels() == 0);
+        CHECK(chain.first == nullptr);
+    }
+
+    //void rebuild(Node* first, size_type size) noexcept;
+    SECTION("Rebuilding after the nodes got relinked") {
+        Node* reversed {nullptr};
+        for(Node* node {chain.first}; node;) {
+            Node* next {node->next_};
+            node->next_ = reversed;
+            reversed = node;
+            node = next;
+        }
+        chain.first = reversed;
+        chain.index.rebuild(chain.first, chain.size);
+        CHECK(chain.index.levels() == 5);
+        CHECK(chain.index.nodeAt(0, chain.first)->value_ == 1999);
+        CHECK(chain.consistent());
+        chain.insert(1000, -1);
+        chain.erase(0);
+        CHECK(chain.consistent());
+    }
+
+    //void clear() noexcept;
+    SECTION("A cleared index still answers by walking the list") {
+        chain.index.clear();
+        for(Node* node {chain.first}; node; node = node->next_) {
+            node->entry_ = nullptr;
+        }
+        CHECK(chain.index.levels() == 0);
+        CHECK(chain.index.nodeAt(1500, chain.first)->value_ == 1500);
+        CHECK(chain.consistent());
+    }
+}
@@ -0,0 +1,160 @@
+#include "Ds/smallvector.hpp"
+#include "custom_matchers.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <initializer_list>
+#include <string>
+#include <algorithm>
+#include <utility>
+#include <exception>
+
+using size_type = ds::SmallVector<int, 4>::size_type;
+
+TEST_CASE("Test own implemented small vectors inline storage", "[SmallVector]") {
+
+    //SmallVector() noexcept;
+    SECTION("An empty vector has the inline capacity without allocating") {
+        ds::SmallVector<int, 8> v;
+        CHECK(v.size() == 0);
+        CHECK(v.capacity() == 8);
+        CHECK(v.is_inline());
+        CHECK(bool(v.data()));
+    }
+
+    //void push_back(const T& value);
+    SECTION("Elements stay inline up to N and spill to the heap beyond") {
+        ds::SmallVector<int, 4> v;
+        for(int i {0}; i < 4; ++i) {
+            v.push_back(i);
+        }
+        CHECK(v.is_inline());
+        v.push_back(4);
+        CHECK_FALSE(v.is_inline());
+        CHECK(v.capacity() >= 5);
+        CHECK_THAT(v, EqualsContainer(std::initializer_list<int> {0, 1, 2, 3, 4}));
+
+        //void shrink_to_fit();
+        SECTION("Shrinking moves the elements back inline once they fit") {
+            v.pop_back();
+            v.shrink_to_fit();
+            CHECK(v.is_inline());
+            CHECK(v.capacity() == 4);
+            CHECK_THAT(v, EqualsContainer(std::initializer_list<int> {0, 1, 2, 3}));
+        }
+    }
+
+    //SmallVector(SmallVector&& other);
+    SECTION("Moving takes the heap buffer or moves the inline elements") {
+        ds::SmallVector<std::string, 2> small {"a", "b"};
+        ds::SmallVector<std::string, 2> moved_small(std::move(small));
+        CHECK(moved_small.is_inline());
+        CHECK(moved_small[1] == "b");
+        CHECK(small.empty());
+
+        ds::SmallVector<std::string, 2> large {"a", "b", "c"};
+        const std::string* data {large.data()};
+        ds::SmallVector<std::string, 2> moved_large(std::move(large));
+        CHECK(moved_large.data() == data);
+        CHECK(moved_large.size() == 3);
+        CHECK(large.empty());
+        CHECK(large.is_inline());
+    }
+
+    //SmallVector(const SmallVector& other);
+    //SmallVector& operator=(const SmallVector& other);
+    SECTION("Copies are deep") {
+        ds::SmallVector<std::string, 2> v {"a", "b", "c"};
+        ds::SmallVector<std::string, 2> copy(v);
+        CHECK_THAT(copy, EqualsContainer(v));
+        ds::SmallVector<std::string, 2> assigned {"x"};
+        assigned = v;
+        CHECK_THAT(assigned, EqualsContainer(v));
+        v[0] = "z";
+        CHECK(copy[0] == "a");
+    }
+
+    //void swap(SmallVector& other);
+    SECTION("Swapping an inline and a heap vector") {
+        ds::SmallVector<int, 2> a {1};
+        ds::SmallVector<int, 2> b {1, 2, 3};
+        a.swap(b);
+        CHECK(a.size() == 3);
+        CHECK_FALSE(a.is_inline());
+        CHECK(b.size() == 1);
+        CHECK(b.is_inline());
+    }
+}
+
+TEST_CASE("Test own implemented small vectors modifier functions", "[SmallVector]") {
+    ds::SmallVector<int, 8> v {1, 2, 3, 4, 5};
+
+    //iterator insert(const_iterator pos, const T& value);
+    SECTION("Inserts shift inline elements") {
+        auto it = v.insert(v.cbegin() + 1, 10);
+        CHECK(*it == 10);
+        CHECK(v.is_inline());
+        CHECK_THAT(v, EqualsContainer(std::initializer_list<int> {1, 10, 2, 3, 4, 5}));
+        CHECK_THROWS_AS(v.insert(v.cend() + 1, 1), std::out_of_range);
+    }
+
+    //iterator insert(const_iterator pos, size_type count, const T& value);
+    SECTION("Inserting past the inline capacity spills once") {
+        v.insert(v.cbegin(), 10, 7);
+        CHECK_FALSE(v.is_inline());
+        CHECK(v.size() == 15);
+        CHECK(v[9] == 7);
+        CHECK(v[10] == 1);
+    }
+
+    //iterator erase(const_iterator first, const_iterator last);
+    //iterator unordered_erase(const_iterator pos);
+    SECTION("Erase keeps the order, unordered erase does not") {
+        v.erase(v.cbegin(), v.cbegin() + 2);
+        CHECK_THAT(v, EqualsContainer(std::initializer_list<int> {3, 4, 5}));
+        v.unordered_erase(v.cbegin());
+        CHECK_THAT(v, EqualsContainer(std::initializer_list<int> {5, 4}));
+    }
+
+    //void resize(size_type count, const value_type& value=T{});
+    //void clear() noexcept;
+    SECTION("Resize and clear") {
+        v.resize(10, 9);
+        CHECK(v.size() == 10);
+        CHECK(v.back() == 9);
+        v.resize(2);
+        CHECK_THAT(v, EqualsContainer(std::initializer_list<int> {1, 2}));
+        size_type capacity {v.capacity()};
+        v.clear();
+        CHECK(v.empty());
+        CHECK(v.capacity() == capacity);
+    }
+
+    //template<class... Args>
+    //reference emplace_back(Args&&... args);
+    SECTION("Emplacing an own element while spilling") {
+        ds::SmallVector<std::string, 2> strings {std::string(30, 'a'), std::string(30, 'b')};
+        strings.emplace_back(strings[0]);
+        CHECK(strings[2] == std::string(30, 'a'));
+        CHECK(strings.at(1) == std::string(30, 'b'));
+        CHECK_THROWS_AS(strings.at(3), std::out_of_range);
+    }
+}
+
+TEST_CASE("Test own implemented small vectors default initialized growth", "[SmallVector]") {
+
+    //void resize(size_type count, default_init_t);
+    //void resize_uninitialized(size_type count) requires std::is_trivial_v<T>;
+    SECTION("Resizing without initializing, inline and spilled") {
+        ds::SmallVector<char, 64> buffer;
+        buffer.resize_uninitialized(64);
+        CHECK(buffer.is_inline());
+        std::fill(buffer.begin(), buffer.end(), 'x');
+        buffer.resize(1000, ds::default_init);
+        CHECK_FALSE(buffer.is_inline());
+        CHECK(buffer.size() == 1000);
+        CHECK(buffer[63] == 'x');
+        buffer.resize_uninitialized(10);
+        CHECK(buffer.size() == 10);
+    }
+}
@@ -0,0 +1,162 @@
+#include "Ds/soavector.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <string>
+#include <utility>
+#include <exception>
+
+using Rows = ds::SoAVector<int, double, std::string>;
+
+TEST_CASE("Test own implemented soa vectors columns", "[SoAVector]") {
+    Rows v;
+    for(int i {0}; i < 100; ++i) {
+        v.emplace_back(i, i * 0.5, std::to_string(i));
+    }
+
+    //size_type size() const noexcept;
+    SECTION("Rows are stored column by column") {
+        CHECK(v.size() == 100);
+        CHECK(v.capacity() >= 100);
+        CHECK(v.column<0>().size() == 100);
+        CHECK(std::accumulate(v.column<0>().begin(), v.column<0>().end(), 0) == 99 * 100 / 2);
+        CHECK(v.column<1>()[10] == 5.0);
+        CHECK(v.column<2>().back() == "99");
+    }
+
+    //template<std::size_t I>
+    //column_type<I>* data() noexcept;
+    SECTION("Every column is aligned") {
+        CHECK(reinterpret_cast<std::uintptr_t>(v.data<0>()) % Rows::kColumnAlignment == 0);
+        CHECK(reinterpret_cast<std::uintptr_t>(v.data<1>()) % Rows::kColumnAlignment == 0);
+        CHECK(reinterpret_cast<std::uintptr_t>(v.data<2>()) % Rows::kColumnAlignment == 0);
+    }
+
+    //void reserve(size_type new_cap);
+    //void shrink_to_fit();
+    SECTION("Growing and shrinking keep the rows") {
+        v.reserve(1000);
+        CHECK(v.capacity() == 1000);
+        CHECK(v[42].get<2>() == "42");
+        v.shrink_to_fit();
+        CHECK(v.capacity() == 100);
+        CHECK(v[99].get<1>() == 49.5);
+    }
+}
+
+TEST_CASE("Test own implemented soa vectors proxy references", "[SoAVector]") {
+    Rows v;
+    v.push_back(ds::Tuple<int, double, std::string> {1, 1.5, std::string("one")});
+    ds::Tuple<int, double, std::string> two {2, 2.5, std::string("two")};
+    v.push_back(two);
+
+    //reference operator[] (const size_type index);
+    SECTION("References read and write the fields in place") {
+        auto row = v[1];
+        CHECK(ds::get<0>(row) == 2);
+        CHECK(row.get<2>() == "two");
+        row.get<0>() = 20;
+        ds::get<1>(row) = 20.5;
+        CHECK(v.column<0>()[1] == 20);
+        CHECK(v.column<1>()[1] == 20.5);
+    }
+
+    //Tuple<Ts...> to_tuple() const;
+    //const SoAReference& operator=(const Tuple<Ts...>& value) const;
+    SECTION("References convert to and get assigned from tuples") {
+        ds::Tuple<int, double, std::string> copy {v[0].to_tuple()};
+        CHECK(ds::get<2>(copy) == "one");
+        v[0] = two;
+        CHECK(v[0].get<2>() == "two");
+        v[1] = v[0];
+        v[0] = std::move(copy);
+        CHECK(v.front().get<0>() == 1);
+        CHECK(v.back().get<0>() == 2);
+        swap(v[0], v[1]);
+        CHECK(v.front().get<0>() == 2);
+        CHECK(v.at(1).get<2>() == "one");
+        CHECK_THROWS_AS(v.at(2), std::out_of_range);
+    }
+
+    //iterator begin() noexcept;
+    SECTION("Iterating over rows") {
+        int sum {0};
+        for(auto row: v) {
+            sum += row.get<0>();
+            row.get<2>() += "!";
+        }
+        CHECK(sum == 3);
+        CHECK(v[1].get<2>() == "two!");
+        const Rows& const_v {v};
+        CHECK(const_v.end() - const_v.begin() == 2);
+        CHECK((*(const_v.cbegin() + 1)).get<1>() == 2.5);
+    }
+}
+
+TEST_CASE("Test own implemented soa vectors modifier functions", "[SoAVector]") {
+    Rows v(5);
+
+    //explicit SoAVector(size_type size);
+    SECTION("Sized constructor value initializes every column") {
+        CHECK(v.size() == 5);
+        CHECK(v[4].get<0>() == 0);
+        CHECK(v[4].get<1>() == 0.0);
+        CHECK(v[4].get<2>().empty());
+    }
+
+    //template<class... Args>
+    //reference emplace_back(Args&&... fields);
+    SECTION("Emplacing own fields while growing") {
+        v.shrink_to_fit();
+        v[0].get<2>() = std::string(30, 'x');
+        auto row = v.emplace_back(v[0].get<0>(), 1.0, v[0].get<2>());
+        CHECK(row.get<2>() == std::string(30, 'x'));
+        CHECK(v.size() == 6);
+    }
+
+    //iterator erase(const_iterator pos);
+    //iterator unordered_erase(const_iterator pos);
+    SECTION("Erase keeps the order, unordered erase does not") {
+        for(int i {0}; i < 5; ++i) {
+            v[i].get<0>() = i;
+        }
+        v.erase(v.cbegin() + 1);
+        CHECK(v.size() == 4);
+        CHECK(v[1].get<0>() == 2);
+        v.unordered_erase(v.cbegin());
+        CHECK(v[0].get<0>() == 4);
+        CHECK(v.size() == 3);
+        CHECK_THROWS_AS(v.erase(v.cend()), std::out_of_range);
+    }
+
+    //SoAVector(const SoAVector& other);
+    //SoAVector(SoAVector&& other) noexcept;
+    SECTION("Copies are deep, moves take the buffer") {
+        v[0].get<2>() = "a";
+        Rows copy(v);
+        copy[0].get<2>() = "b";
+        CHECK(v[0].get<2>() == "a");
+        const int* column {v.data<0>()};
+        Rows moved(std::move(v));
+        CHECK(moved.data<0>() == column);
+        CHECK(v.empty());
+        copy = moved;
+        CHECK(copy[0].get<2>() == "a");
+    }
+
+    //void resize(size_type count);
+    //void clear() noexcept;
+    SECTION("Resize and clear") {
+        v.resize(2);
+        CHECK(v.size() == 2);
+        v.resize(50, ds::default_init);
+        CHECK(v.size() == 50);
+        CHECK(v[49].get<2>().empty());
+        Rows::size_type capacity {v.capacity()};
+        v.clear();
+        CHECK(v.empty());
+        CHECK(v.capacity() == capacity);
+    }
+}
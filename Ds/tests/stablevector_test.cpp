@@ -0,0 +1,186 @@
+#include "Ds/stablevector.hpp"
+#include "custom_matchers.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <initializer_list>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <utility>
+#include <exception>
+
+using size_type = ds::StableVector<int>::size_type;
+
+TEST_CASE("Test own implemented stable vectors blocks", "[StableVector]") {
+
+    //StableVector();
+    SECTION("An empty vector does not allocate") {
+        ds::StableVector<int> v;
+        CHECK(v.empty());
+        CHECK(v.capacity() == 0);
+        CHECK(v.segment_count() == 0);
+    }
+
+    //void push_back(const T& value);
+    SECTION("Appending never moves an element") {
+        ds::StableVector<int, std::allocator<int>, 4> v;
+        std::vector<const int*> addresses;
+        for(int i {0}; i < 1000; ++i) {
+            v.push_back(i);
+            addresses.push_back(&v.back());
+        }
+        for(int i {0}; i < 1000; ++i) {
+            REQUIRE(&v[i] == addresses[i]);
+            REQUIRE(v[i] == i);
+        }
+    }
+
+    //size_type capacity() const noexcept;
+    //size_type segment_count() const noexcept;
+    SECTION("Blocks double in size and the capacity stays below size plus one block") {
+        ds::StableVector<int, std::allocator<int>, 4> v;
+        for(int i {0}; i < 100; ++i) {
+            v.push_back(i);
+            size_type last_block {v.segment_count() - 1};
+            REQUIRE(v.capacity() - v.size() < (size_type {4} << last_block));
+        }
+        CHECK(v.segment_count() == 5);
+        CHECK(v.capacity() == 124);
+        size_type counted {0};
+        for(size_type block {0}; block < v.segment_count(); ++block) {
+            CHECK(v.segment(block).size() <= (size_type {4} << block));
+            counted += v.segment(block).size();
+        }
+        CHECK(counted == v.size());
+        CHECK(v.segment(4).front() == 60);
+        CHECK_THROWS_AS(v.segment(5), std::out_of_range);
+    }
+
+    //void reserve(size_type new_cap);
+    //void shrink_to_fit();
+    SECTION("Reserving allocates whole blocks, shrinking frees the unused ones") {
+        ds::StableVector<int> v;
+        v.reserve(100);
+        CHECK(v.capacity() >= 100);
+        v.push_back(1);
+        const int* first {&v[0]};
+        v.shrink_to_fit();
+        CHECK(v.segment_count() == 1);
+        CHECK(&v[0] == first);
+        v.clear();
+        v.shrink_to_fit();
+        CHECK(v.capacity() == 0);
+    }
+}
+
+TEST_CASE("Test own implemented stable vectors element access and iterators", "[StableVector]") {
+    ds::StableVector<int, std::allocator<int>, 2> v;
+    for(int i {0}; i < 50; ++i) {
+        v.push_back(i);
+    }
+
+    //reference at(const size_type index);
+    SECTION("Indexing across block borders") {
+        CHECK(v.front() == 0);
+        CHECK(v.back() == 49);
+        CHECK(v[1] == 1);
+        CHECK(v[2] == 2);
+        CHECK(v[5] == 5);
+        CHECK(v[6] == 6);
+        CHECK(v.at(49) == 49);
+        CHECK_THROWS_AS(v.at(50), std::out_of_range);
+    }
+
+    //iterator begin() noexcept;
+    SECTION("Iterators are random access") {
+        CHECK(v.end() - v.begin() == 50);
+        CHECK(*(v.begin() + 30) == 30);
+        CHECK(v.begin()[17] == 17);
+        CHECK(*(v.rbegin()) == 49);
+        ds::StableVector<int, std::allocator<int>, 2>::const_iterator it {v.begin()};
+        CHECK(it < v.cend());
+        CHECK(std::accumulate(v.cbegin(), v.cend(), 0) == 49 * 50 / 2);
+        std::reverse(v.begin(), v.end());
+        CHECK(v.front() == 49);
+        CHECK(std::is_sorted(v.rbegin(), v.rend()));
+    }
+}
+
+TEST_CASE("Test own implemented stable vectors modifier functions", "[StableVector]") {
+    ds::StableVector<std::string> v {"a", "b", "c", "d"};
+
+    //StableVector(const StableVector& other);
+    //StableVector(StableVector&& other) noexcept;
+    SECTION("Copies are deep, moves keep the blocks") {
+        ds::StableVector<std::string> copy(v);
+        CHECK_THAT(copy, EqualsContainer(v));
+        copy[0] = "z";
+        CHECK(v[0] == "a");
+        const std::string* first {&v[0]};
+        ds::StableVector<std::string> moved(std::move(v));
+        CHECK(&moved[0] == first);
+        CHECK(v.empty());
+        copy = std::move(moved);
+        CHECK(&copy[0] == first);
+    }
+
+    //iterator insert(const_iterator pos, const T& value);
+    //iterator insert(const_iterator pos, size_type count, const T& value);
+    SECTION("Inserting in the middle") {
+        auto it = v.insert(v.cbegin() + 1, "x");
+        CHECK(*it == "x");
+        CHECK_THAT(v, EqualsContainer(std::initializer_list<std::string> {"a", "x", "b", "c", "d"}));
+        v.insert(v.cend(), 2, "y");
+        v.insert(v.cbegin(), {"0", "1"});
+        CHECK_THAT(v, EqualsContainer(std::initializer_list<std::string> {"0", "1", "a", "x", "b", "c", "d", "y", "y"}));
+        CHECK_THROWS_AS(v.insert(v.cend() + 1, "z"), std::out_of_range);
+    }
+
+    //iterator erase(const_iterator first, const_iterator last);
+    //iterator unordered_erase(const_iterator pos);
+    SECTION("Erase keeps the order, unordered erase does not") {
+        v.erase(v.cbegin() + 1);
+        CHECK_THAT(v, EqualsContainer(std::initializer_list<std::string> {"a", "c", "d"}));
+        v.unordered_erase(v.cbegin());
+        CHECK_THAT(v, EqualsContainer(std::initializer_list<std::string> {"d", "c"}));
+        v.erase(v.cbegin(), v.cend());
+        CHECK(v.empty());
+        CHECK_THROWS_AS(v.erase(v.cend()), std::out_of_range);
+    }
+
+    //void resize(size_type count, const value_type& value=T{});
+    //void clear() noexcept;
+    SECTION("Resizing with an own element and clearing") {
+        v.resize(40, v[1]);
+        CHECK(v.size() == 40);
+        CHECK(v.back() == "b");
+        v.resize(2);
+        CHECK_THAT(v, EqualsContainer(std::initializer_list<std::string> {"a", "b"}));
+        size_type capacity {v.capacity()};
+        v.clear();
+        CHECK(v.empty());
+        CHECK(v.capacity() == capacity);
+    }
+
+    //template<class... Args>
+    //reference emplace_back(Args&&... args);
+    SECTION("Emplacing an own element while adding a block") {
+        v.resize(16, std::string(30, 'a'));
+        CHECK(v.capacity() == 16);
+        auto& added = v.emplace_back(v[15]);
+        CHECK(&added == &v[16]);
+        CHECK(added == std::string(30, 'a'));
+    }
+
+    //void resize(size_type count, default_init_t);
+    SECTION("Default initialized resize") {
+        ds::StableVector<int> ints;
+        ints.resize(100, ds::default_init);
+        CHECK(ints.size() == 100);
+        std::fill(ints.begin(), ints.end(), 3);
+        ints.resize(10, ds::default_init);
+        CHECK(ints.back() == 3);
+    }
+}
@@ -0,0 +1,274 @@
+#include "Ds/unrolledlist.hpp"
+#include "custom_matchers.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+using Ints = ds::UnrolledList<int, std::allocator<int>, 1>;
+
+namespace {
+
+std::vector<int> toVector(const Ints& l) {
+    return std::vector<int>(l.begin(), l.end());
+}
+
+std::vector<int> iota(int count) {
+    std::vector<int> values(count);
+    std::iota(values.begin(), values.end(), 0);
+    return values;
+}
+
+}
+
+TEST_CASE("Test own implemented unrolled list nodes", "[UnrolledList]") {
+    Ints l;
+    for(int i {0}; i < 100; ++i) {
+        l.push_back(i);
+    }
+
+    //UnrolledList();
+    SECTION("A node fills one cache line") {
+        CHECK(Ints::kNodeCapacity == 10);
+        CHECK(sizeof(int) * Ints::kNodeCapacity <= Ints::kCacheLine);
+        CHECK(ds::UnrolledList<char, std::allocator<char>, 4>::kNodeCapacity > 200);
+        CHECK(ds::UnrolledList<std::array<char, 300>>::kNodeCapacity == 1);
+        CHECK(reinterpret_cast<std::uintptr_t>(&l.front()) % Ints::kCacheLine != 0);
+        CHECK(reinterpret_cast<std::uintptr_t>(&l.front() - 6) % Ints::kCacheLine == 0);
+    }
+
+    //void push_back(const T& value);
+    SECTION("Appending fills the nodes completely") {
+        CHECK(l.size() == 100);
+        CHECK(l.node_count() == 10);
+        CHECK(toVector(l) == iota(100));
+        CHECK(&l[9] + 1 != &l[10]);
+        CHECK(&l[8] + 1 == &l[9]);
+    }
+
+    //iterator insert(const_iterator pos, const T& value);
+    SECTION("Inserting into a full node splits it") {
+        auto it = l.insert(std::next(l.begin(), 3), -1);
+        CHECK(*it == -1);
+        CHECK(l.node_count() == 11);
+        CHECK(l[3] == -1);
+        CHECK(l[4] == 3);
+        CHECK(l.size() == 101);
+        it = l.insert(std::next(l.begin(), 5), -2);
+        CHECK(l.node_count() == 11);
+        CHECK(*std::prev(it) == 3);
+    }
+
+    //iterator insert(const_iterator pos, const T& value);
+    SECTION("Inserting in front of a full node uses the previous node") {
+        l.insert(std::next(l.begin(), 10), -1);
+        CHECK(l.node_count() == 11);
+        l.insert(std::next(l.begin(), 11), -2);
+        CHECK(l.node_count() == 11);
+        CHECK(l[10] == -1);
+        CHECK(l[11] == -2);
+        CHECK(l[12] == 10);
+        l.push_front(-3);
+        CHECK(l.node_count() == 12);
+        CHECK(l.front() == -3);
+    }
+
+    //iterator erase(const_iterator pos);
+    SECTION("Erasing merges nodes which dropped below half full") {
+        auto it = l.erase(l.begin(), std::next(l.begin(), 6));
+        CHECK(*it == 6);
+        CHECK(l.node_count() == 10);
+        it = l.erase(std::next(l.begin(), 4), std::next(l.begin(), 10));
+        CHECK(*it == 16);
+        CHECK(l.node_count() == 9);
+        CHECK(l[3] == 9);
+        CHECK(l[4] == 16);
+        CHECK(l.size() == 88);
+        l.erase(std::next(l.begin(), 3), l.end());
+        CHECK(toVector(l) == std::vector<int> {6, 7, 8});
+        CHECK(l.node_count() == 1);
+    }
+
+    //iterator erase(const_iterator pos);
+    SECTION("Erasing the last element of a node frees it") {
+        Ints single {1, 2, 3};
+        auto it = single.erase(std::next(single.begin(), 2));
+        CHECK(it == single.end());
+        single.pop_back();
+        single.pop_front();
+        CHECK(single.empty());
+        CHECK(single.node_count() == 0);
+        CHECK(single.begin() == single.end());
+        single.pop_back();
+    }
+
+    //iterator begin() noexcept;
+    SECTION("Iterating in both directions") {
+        CHECK(std::distance(l.begin(), l.end()) == 100);
+        CHECK(*std::prev(l.end()) == 99);
+        CHECK(*l.rbegin() == 99);
+        int expected {99};
+        for(auto it = l.crbegin(); it != l.crend(); ++it, --expected) {
+            CHECK(*it == expected);
+        }
+        const Ints& const_l {l};
+        Ints::const_iterator it {l.begin()};
+        CHECK(it == const_l.begin());
+        CHECK(l[57] == 57);
+        CHECK(const_l[42] == 42);
+    }
+}
+
+TEST_CASE("Test own implemented unrolled list like ds::List", "[UnrolledList]") {
+    ds::UnrolledList<std::string> l {"b", "d", "a", "c"};
+
+    //UnrolledList(const UnrolledList& other);
+    //UnrolledList(UnrolledList&& other) noexcept;
+    SECTION("Copies are deep, moves take the nodes") {
+        ds::UnrolledList<std::string> copy {l};
+        copy.front() = "z";
+        CHECK(l.front() == "b");
+        const std::string* back {&l.back()};
+        ds::UnrolledList<std::string> moved {std::move(l)};
+        CHECK(&moved.back() == back);
+        CHECK(l.empty());
+        l = moved;
+        CHECK_THAT(l, EqualsContainer(moved));
+        l = {"x"};
+        CHECK(l.size() == 1);
+        l = std::move(copy);
+        CHECK(l.front() == "z");
+    }
+
+    //iterator insert(const_iterator pos, size_type count, const T& value);
+    //iterator insert(const_iterator pos, std::initializer_list<T> iList);
+    SECTION("Inserting several elements") {
+        auto it = l.insert(std::next(l.begin()), 3, l.front());
+        CHECK(*it == "b");
+        CHECK_THAT(l, EqualsContainer(std::initializer_list<std::string> {"b", "b", "b", "b", "d", "a", "c"}));
+        it = l.insert(l.end(), {"e", "f"});
+        CHECK(*it == "e");
+        it = l.emplace(l.begin(), 3, 'x');
+        CHECK(*it == "xxx");
+        CHECK(l.emplace_back(2, 'y') == "yy");
+        CHECK(l.emplace_front("w") == "w");
+        CHECK(l.size() == 12);
+    }
+
+    //template<class Compare=std::less<T>>
+    //void sort(Compare comp=Compare{});
+    SECTION("Sorting is stable") {
+        l.sort();
+        CHECK_THAT(l, EqualsContainer(std::initializer_list<std::string> {"a", "b", "c", "d"}));
+        ds::UnrolledList<std::pair<int, int>> pairs;
+        for(int i {0}; i < 500; ++i) {
+            pairs.push_back({(i * 7) % 5, i});
+        }
+        pairs.sort([](const auto& a, const auto& b) { return a.first < b.first; });
+        CHECK(std::is_sorted(pairs.begin(), pairs.end()));
+    }
+
+    //void sort(Compare comp=Compare{});
+    SECTION("A throwing comparison leaves the list as it was") {
+        const std::vector<int> values {iota(50)};
+        Ints numbers(values.begin(), values.end());
+        int calls {0};
+        CHECK_THROWS_AS(numbers.sort([&calls](int a, int b) {
+            if(++calls == 40) {
+                throw std::runtime_error("compare");
+            }
+            return a > b;
+        }), std::runtime_error);
+        CHECK(toVector(numbers) == values);
+    }
+
+    //void merge(UnrolledList&& other, Compare comp);
+    SECTION("Merging sorted lists") {
+        Ints first {1, 3, 5, 7, 9, 11, 13};
+        Ints second {0, 2, 3, 4, 100};
+        first.merge(std::move(second));
+        CHECK(toVector(first) == std::vector<int> {0, 1, 2, 3, 3, 4, 5, 7, 9, 11, 13, 100});
+        CHECK(second.empty());
+        Ints empty;
+        empty.merge(std::move(first));
+        CHECK(empty.size() == 12);
+        empty.merge(std::move(empty));
+        CHECK(empty.size() == 12);
+    }
+
+    //void unique();
+    //void reverse();
+    //size_type remove(const T& value);
+    SECTION("Unique, reverse and remove") {
+        Ints numbers {1, 1, 2, 2, 2, 3, 1, 1, 4, 4, 4, 4, 4, 4, 5, 5};
+        numbers.unique();
+        CHECK(toVector(numbers) == std::vector<int> {1, 2, 3, 1, 4, 5});
+        numbers.reverse();
+        CHECK(toVector(numbers) == std::vector<int> {5, 4, 1, 3, 2, 1});
+        CHECK(numbers.remove(1) == 2);
+        CHECK(numbers.remove_if([](int value) { return value > 4; }) == 1);
+        CHECK(toVector(numbers) == std::vector<int> {4, 3, 2});
+    }
+
+    //void resize(size_type count, const T& value = T());
+    //void swap(UnrolledList& other) noexcept;
+    SECTION("Resize, swap and clear") {
+        l.resize(30, "r");
+        CHECK(l.size() == 30);
+        CHECK(l.back() == "r");
+        l.resize(2);
+        CHECK_THAT(l, EqualsContainer(std::initializer_list<std::string> {"b", "d"}));
+        ds::UnrolledList<std::string> other(3, "o");
+        l.swap(other);
+        CHECK(l.size() == 3);
+        CHECK(other.back() == "d");
+        l.assign({"q"});
+        CHECK(l.front() == "q");
+        l.clear();
+        CHECK(l.empty());
+        CHECK(l.node_count() == 0);
+    }
+}
+
+TEST_CASE("Test own implemented unrolled list against std::vector", "[UnrolledList]") {
+    Ints l;
+    std::vector<int> expected;
+    std::uint32_t state {12345};
+    auto next = [&state]() {
+        state = state * 1664525u + 1013904223u;
+        return state >> 8;
+    };
+
+    //iterator insert(const_iterator pos, const T& value);
+    //iterator erase(const_iterator pos);
+    SECTION("Random inserts and erases keep the order") {
+        for(int i {0}; i < 5000; ++i) {
+            std::size_t index {expected.empty() ? 0 : next() % (expected.size() + 1)};
+            if(next() % 3 != 0 || expected.empty()) {
+                auto it = l.insert(std::next(l.begin(), index), i);
+                CHECK(*it == i);
+                expected.insert(expected.begin() + index, i);
+            } else {
+                index %= expected.size();
+                auto it = l.erase(std::next(l.begin(), index));
+                expected.erase(expected.begin() + index);
+                CHECK(std::distance(l.begin(), it) == static_cast<std::ptrdiff_t>(index));
+            }
+        }
+        REQUIRE(l.size() == expected.size());
+        CHECK(toVector(l) == expected);
+        // Every node is at least half full or has a neighbour it can't merge with
+        CHECK(l.node_count() * Ints::kNodeCapacity <= 2 * l.size() + Ints::kNodeCapacity);
+    }
+}
@@ -13,6 +13,10 @@
 #include <utility>
 #include <exception>
 #include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <type_traits>
 
 using size_type = ds::VectorClass<int>::size_type;
 
@@ -327,6 +331,18 @@ TEST_CASE("Test own implemented vectors modifier functions") {
         CHECK(v1.capacity() > old_capacity);
     }
 
+    //void push_back(const T& value);
+    SECTION("Appending an own element while the vector grows") {
+        ds::VectorClass<std::string> strings {std::string(40, 'a')};
+        strings.shrink_to_fit();
+        strings.push_back(strings[0]);
+        strings.shrink_to_fit();
+        strings.push_back(std::move(strings[1]));
+        CHECK(strings.size() == 3);
+        CHECK(strings[0] == std::string(40, 'a'));
+        CHECK(strings[2] == std::string(40, 'a'));
+    }
+
     //template<class Args>
     //void emplace_back(Args&&... args);
     SECTION("Emplace element at the end of the vector") {
@@ -525,3 +541,227 @@ TEST_CASE("Test own implemented vectors begin, end and rend functions") {
     }
 }
 
+
+namespace {
+
+// Counts how often it gets moved or copied
+struct Relocatable {
+    Relocatable(int v): value {v} {}
+    Relocatable(const Relocatable& other): value {other.value} { ++copies; }
+    Relocatable(Relocatable&& other) noexcept: value {other.value} { ++copies; }
+    Relocatable& operator=(const Relocatable& other) = default;
+
+    int value;
+    static inline int copies {0};
+};
+
+}
+
+template<>
+struct ds::is_trivially_relocatable<Relocatable>: std::true_type {};
+
+TEST_CASE("Test own implemented vectors growth policies and relocation", "[VectorClass]") {
+
+    //template<std::size_t Num, std::size_t Den>
+    //struct FactorGrowth;
+    SECTION("The default policy doubles, starting with a cache line") {
+        ds::VectorClass<int> v;
+        v.push_back(1);
+        CHECK(v.capacity() == 64 / sizeof(int));
+        size_type capacity {v.capacity()};
+        for(int i {0}; i < 1000; ++i) {
+            v.push_back(i);
+            if(v.capacity() != capacity) {
+                CHECK(v.capacity() == capacity * 2);
+                capacity = v.capacity();
+            }
+        }
+    }
+
+    SECTION("HalfGrowth grows by half of the capacity") {
+        ds::VectorClass<int, std::allocator<int>, ds::HalfGrowth> v;
+        v.reserve(100);
+        for(int i {0}; i < 101; ++i) {
+            v.push_back(i);
+        }
+        CHECK(v.capacity() == 150);
+        CHECK(v[100] == 100);
+    }
+
+    //template<GrowthPolicy Base = HalfGrowth, std::size_t PageSize = 4096>
+    //struct PageGrowth;
+    SECTION("PageGrowth rounds buffers larger than a page to whole pages") {
+        ds::VectorClass<std::array<char, 12>, std::allocator<std::array<char, 12>>, ds::PageGrowth<>> v;
+        for(int i {0}; i < 10000; ++i) {
+            v.push_back({});
+            if(v.capacity() * 12 >= 4096) {
+                CHECK(v.capacity() == (v.capacity() * 12 + 4095) / 4096 * 4096 / 12);
+            }
+        }
+    }
+
+    //void reserve(size_type new_cap);
+    //void shrink_to_fit();
+    SECTION("Trivially relocatable elements do not get moved one by one") {
+        ds::VectorClass<Relocatable> v;
+        for(int i {0}; i < 100; ++i) {
+            v.emplace_back(i);
+        }
+        Relocatable::copies = 0;
+        v.reserve(1000);
+        v.shrink_to_fit();
+        CHECK(Relocatable::copies == 0);
+        CHECK(v.size() == 100);
+        CHECK(v[99].value == 99);
+    }
+
+    SECTION("Other allocators relocate with memcpy as well") {
+        ds::VectorClass<int, std::pmr::polymorphic_allocator<int>> v;
+        for(int i {0}; i < 1000; ++i) {
+            v.push_back(i);
+        }
+        v.shrink_to_fit();
+        CHECK(v.capacity() == 1000);
+        CHECK(v[999] == 999);
+    }
+
+    SECTION("Elements which are not trivially relocatable get moved") {
+        ds::VectorClass<std::string> v;
+        for(int i {0}; i < 100; ++i) {
+            v.push_back(std::string(40, static_cast<char>('a' + i % 26)));
+        }
+        v.reserve(1000);
+        v.shrink_to_fit();
+        CHECK(v.size() == 100);
+        CHECK(v[27] == std::string(40, 'b'));
+    }
+}
+
+TEST_CASE("Test own implemented vectors in place insert and erase", "[VectorClass]") {
+    ds::VectorClass<int> v {1, 2, 3, 4, 5};
+
+    //iterator insert(const_iterator pos, const T& value);
+    SECTION("Inserting with spare capacity shifts the elements in place") {
+        v.reserve(20);
+        const int* data {v.data()};
+        auto it = v.insert(v.cbegin() + 2, 10);
+        CHECK(*it == 10);
+        CHECK(v.data() == data);
+        CHECK_THAT(v, EqualsContainer(std::initializer_list<int> {1, 2, 10, 3, 4, 5}));
+
+        v.insert(v.cbegin(), v[5]);
+        CHECK(v.data() == data);
+        CHECK_THAT(v, EqualsContainer(std::initializer_list<int> {5, 1, 2, 10, 3, 4, 5}));
+    }
+
+    //iterator insert(const_iterator pos, size_type count, const T& value);
+    //iterator insert(const_iterator pos, InputIt first, InputIt last);
+    SECTION("Inserting many elements grows the buffer once") {
+        v.insert(v.cbegin() + 1, 100, 7);
+        CHECK(v.size() == 105);
+        CHECK(v.capacity() == 105);
+        CHECK(v[0] == 1);
+        CHECK(v[100] == 7);
+        CHECK(v[101] == 2);
+
+        std::array<int, 3> values {8, 9, 10};
+        auto it = v.insert(v.cend(), values.begin(), values.end());
+        CHECK(it == v.end() - 3);
+        CHECK(v.back() == 10);
+        CHECK(v.size() == 108);
+    }
+
+    //iterator erase(const_iterator first, const_iterator last);
+    SECTION("Erasing a range shifts the rest down once") {
+        auto it = v.erase(v.cbegin() + 1, v.cbegin() + 3);
+        CHECK(*it == 4);
+        CHECK_THAT(v, EqualsContainer(std::initializer_list<int> {1, 4, 5}));
+        CHECK(v.erase(v.cbegin(), v.cbegin()) == v.begin());
+        CHECK(v.size() == 3);
+        CHECK_THROWS_AS(v.erase(v.cbegin() + 2, v.cbegin() + 1), std::out_of_range);
+    }
+
+    //iterator unordered_erase(const_iterator pos);
+    SECTION("Unordered erase moves the last element into the gap") {
+        auto it = v.unordered_erase(v.cbegin() + 1);
+        CHECK(*it == 5);
+        CHECK_THAT(v, EqualsContainer(std::initializer_list<int> {1, 5, 3, 4}));
+        v.unordered_erase(v.cend() - 1);
+        CHECK_THAT(v, EqualsContainer(std::initializer_list<int> {1, 5, 3}));
+        CHECK_THROWS_AS(v.unordered_erase(v.cend()), std::out_of_range);
+    }
+
+    SECTION("Elements which are not trivially relocatable get shifted as well") {
+        ds::VectorClass<std::string> strings;
+        for(int i {0}; i < 10; ++i) {
+            strings.push_back(std::string(30, static_cast<char>('a' + i)));
+        }
+        strings.reserve(40);
+        strings.insert(strings.cbegin() + 3, 5, std::string(30, 'z'));
+        CHECK(strings.size() == 15);
+        CHECK(strings[2] == std::string(30, 'c'));
+        CHECK(strings[7] == std::string(30, 'z'));
+        CHECK(strings[8] == std::string(30, 'd'));
+        strings.erase(strings.cbegin() + 3, strings.cbegin() + 8);
+        CHECK(strings[3] == std::string(30, 'd'));
+        strings.unordered_erase(strings.cbegin());
+        CHECK(strings[0] == std::string(30, 'j'));
+        CHECK(strings.size() == 9);
+    }
+}
+
+TEST_CASE("Test own implemented vectors default initialized growth", "[VectorClass]") {
+
+    //void resize(size_type count, default_init_t);
+    SECTION("Default initialized elements can be filled afterwards") {
+        ds::VectorClass<char> buffer;
+        buffer.resize(4096, ds::default_init);
+        CHECK(buffer.size() == 4096);
+        std::fill(buffer.begin(), buffer.end(), 'x');
+        buffer.resize(8192, ds::default_init);
+        CHECK(buffer.size() == 8192);
+        CHECK(buffer[4095] == 'x');
+    }
+
+    //void resize_uninitialized(size_type count) requires std::is_trivial_v<T>;
+    SECTION("Resizing within the capacity keeps the buffer") {
+        ds::VectorClass<int> v;
+        v.reserve(100);
+        const int* data {v.data()};
+        v.resize_uninitialized(100);
+        CHECK(v.size() == 100);
+        CHECK(v.data() == data);
+        v.resize_uninitialized(10);
+        CHECK(v.size() == 10);
+        CHECK(v.capacity() == 100);
+    }
+
+    SECTION("Class types get default constructed") {
+        ds::VectorClass<std::string> v {"a"};
+        v.resize(3, ds::default_init);
+        CHECK(v[0] == "a");
+        CHECK(v[2].empty());
+        v.resize(1, ds::default_init);
+        CHECK(v.size() == 1);
+    }
+
+    //void resize(size_type count, const value_type& value=T{});
+    SECTION("Shrinking destroys the elements and growing can copy an own element") {
+        ds::VectorClass<std::string> v {std::string(30, 'a'), std::string(30, 'b')};
+        v.resize(1);
+        CHECK(v.size() == 1);
+        v.resize(20, v[0]);
+        CHECK(v[19] == std::string(30, 'a'));
+    }
+
+    //void clear() noexcept;
+    SECTION("Clearing keeps the buffer") {
+        ds::VectorClass<std::string> v {"a", "b", "c"};
+        const std::string* data {v.data()};
+        v.clear();
+        CHECK(v.empty());
+        v.push_back("d");
+        CHECK(v.data() == data);
+        CHECK(v.capacity() == 3);
+    }
+}
@@ -18,6 +18,10 @@ namespace ds {
         T& get() {
             return val_;
         }
+
+        const T& get() const {
+            return val_;
+        }
     };
                 
 
@@ -85,6 +89,11 @@ namespace ds {
         return (static_cast<TupleImpl<index, ExtractTypeAt_t<index, Args...>>&>(t)).get();
     }
 
+    template<std::size_t index, class... Args>
+    const auto& get(const Tuple<Args...>& t) {
+        return (static_cast<const TupleImpl<index, ExtractTypeAt_t<index, Args...>>&>(t)).get();
+    }
+
     template<std::size_t index, class... Args>
     bool compare_tuple(Tuple<Args...>& t1, Tuple<Args...>& t2) {
         if constexpr (index == 0) {